@@ -0,0 +1,105 @@
+/*
+ * bench_cgal_kernels.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Times CGAL flattening of Gerber files with each supported kernel.
+ * Usage: bench_cgal_kernels <gbr_file_or_dir>...
+ */
+
+#include "CgalSerializer.h"
+#include "FileProcessor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace gerbex;
+
+template<typename K>
+void benchKernel(const std::string &name,
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects) {
+	std::cout << "  " << std::left << std::setw(8) << name << std::right;
+	try {
+		auto start = std::chrono::steady_clock::now();
+		CgalSerializer<K> serializer;
+		for (std::shared_ptr<GraphicalObject> obj : objects) {
+			obj->Serialize(serializer, Point());
+		}
+		typename CgalSerializer<K>::Polygon_set_2 result =
+				serializer.GetPolygonSet();
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<double, std::milli> ms = end - start;
+		std::cout << std::setw(12) << std::fixed << std::setprecision(2)
+				<< ms.count() << " ms" << std::setw(8)
+				<< result.number_of_polygons_with_holes() << " polygons"
+				<< std::endl;
+	} catch (const std::exception &ex) {
+		std::cout << "failed: " << ex.what() << std::endl;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: bench_cgal_kernels <gbr_file_or_dir>..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::filesystem::path> files;
+	for (int i = 1; i < argc; i++) {
+		std::filesystem::path path = argv[i];
+		if (std::filesystem::is_directory(path)) {
+			for (const auto &entry : std::filesystem::directory_iterator(path)) {
+				if (entry.path().extension() == ".gbr") {
+					files.push_back(entry.path());
+				}
+			}
+		} else {
+			files.push_back(path);
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	for (const std::filesystem::path &file : files) {
+		std::ifstream gerber(file, std::ifstream::in);
+		if (!gerber.good()) {
+			std::cerr << "failed to open " << file << std::endl;
+			return EXIT_FAILURE;
+		}
+		FileProcessor fileProcessor;
+		fileProcessor.Process(gerber);
+		std::vector<std::shared_ptr<GraphicalObject>> objects =
+				fileProcessor.GetProcessor().GetObjects();
+
+		std::cout << file.filename().string() << " (" << objects.size()
+				<< " objects)" << std::endl;
+		benchKernel<Epick>("epick", objects);
+		benchKernel<Epec>("epec", objects);
+		benchKernel<GridKernel>("grid", objects);
+	}
+	return EXIT_SUCCESS;
+}
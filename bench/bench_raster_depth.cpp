@@ -0,0 +1,128 @@
+/*
+ * bench_raster_depth.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Times rendering Gerber files to 8 bit anti-aliased strips against 1 bit
+ * packed strips, each image sized to the given pixels along its long edge.
+ * Usage: bench_raster_depth <pixels> <gbr_file_or_dir>...
+ */
+
+#include "FileProcessor.h"
+#include "RasterSerializer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace gerbex;
+
+void benchDepth(const std::string &name,
+		const std::function<uint64_t()> &render) {
+	std::cout << "  " << std::left << std::setw(8) << name << std::right;
+	try {
+		auto start = std::chrono::steady_clock::now();
+		uint64_t set = render();
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<double, std::milli> ms = end - start;
+		std::cout << std::setw(12) << std::fixed << std::setprecision(2)
+				<< ms.count() << " ms" << std::setw(12) << set
+				<< " dark bytes" << std::endl;
+	} catch (const std::exception &ex) {
+		std::cout << "failed: " << ex.what() << std::endl;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: bench_raster_depth <pixels>"
+				<< " <gbr_file_or_dir>..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	double pixels = std::stod(argv[1]);
+
+	std::vector<std::filesystem::path> files;
+	for (int i = 2; i < argc; i++) {
+		std::filesystem::path path = argv[i];
+		if (std::filesystem::is_directory(path)) {
+			for (const auto &entry : std::filesystem::directory_iterator(path)) {
+				if (entry.path().extension() == ".gbr") {
+					files.push_back(entry.path());
+				}
+			}
+		} else {
+			files.push_back(path);
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	for (const std::filesystem::path &file : files) {
+		std::ifstream gerber(file, std::ifstream::in);
+		if (!gerber.good()) {
+			std::cerr << "failed to open " << file << std::endl;
+			return EXIT_FAILURE;
+		}
+		FileProcessor fileProcessor;
+		fileProcessor.Process(gerber);
+		std::vector<std::shared_ptr<GraphicalObject>> objects =
+				fileProcessor.GetProcessor().GetObjects();
+
+		Box viewBox = fileProcessor.GetProcessor().GetBox().Pad(0.5);
+		RasterSerializer serializer(viewBox,
+				std::max(viewBox.GetWidth(), viewBox.GetHeight()) / pixels);
+		for (std::shared_ptr<GraphicalObject> obj : objects) {
+			obj->Serialize(serializer, Point());
+		}
+		int width = serializer.GetWidth();
+		size_t rowBytes = (width + 7) / 8;
+
+		std::cout << file.filename().string() << " (" << width << " x "
+				<< serializer.GetHeight() << " pixels)" << std::endl;
+		benchDepth("8 bit", [&]() {
+			uint64_t dark = 0;
+			serializer.RenderStrips([&](const uint8_t *pixels, int rows) {
+				dark += std::count_if(pixels, pixels + size_t(rows) * width,
+						[](uint8_t p) {
+							return p != 0;
+						});
+			});
+			return dark;
+		});
+		benchDepth("1 bit", [&]() {
+			uint64_t dark = 0;
+			serializer.RenderBitStrips([&](const uint8_t *bits, int rows) {
+				dark += std::count_if(bits, bits + size_t(rows) * rowBytes,
+						[](uint8_t b) {
+							return b != 0;
+						});
+			});
+			return dark;
+		});
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,407 @@
+/*
+ * gerbex_bench.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Times each phase of reading and converting Gerber workloads on its own:
+ * lexing into commands, processing the commands into objects, GetBox, and
+ * SVG and CGAL serialization. Reports throughput and heap allocations per
+ * phase, the best of several runs, as a table or as CSV to track over time.
+ * Files are read into memory first, so disk speed is not measured. Besides
+ * the files given, generated workloads of flashes, tracks and regions are
+ * timed, their size set by --scale.
+ * Usage: gerbex_bench [--repeat <n>] [--scale <n>] [--phases <list>] [--csv]
+ *		<gbr_file_or_dir>...
+ */
+
+#include "CgalSerializer.h"
+#include "FileParser.h"
+#include "FileProcessor.h"
+#include "SvgSerializer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gerbex;
+
+// Every allocation of the process is counted, so the bench is single threaded
+static std::atomic<uint64_t> g_allocations { 0 };
+static std::atomic<uint64_t> g_allocatedBytes { 0 };
+
+void* operator new(std::size_t size) {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+const std::vector<std::string> ALL_PHASES = { "lex", "process", "box", "svg",
+		"cgal" };
+
+struct Workload {
+	std::string name;
+	std::string gerber;
+};
+
+struct Measure {
+	double milliseconds = std::numeric_limits<double>::infinity();
+	uint64_t allocations = 0;
+	uint64_t allocatedBytes = 0;
+	// What the phase got through, for the rates
+	uint64_t commands = 0;
+	uint64_t objects = 0;
+	uint64_t bytes = 0;
+};
+
+// Runs the phase repeat times, keeping the fastest
+Measure measure(unsigned int repeat, const std::function<void(Measure&)> &run) {
+	Measure best;
+	for (unsigned int i = 0; i < repeat; i++) {
+		Measure current;
+		uint64_t allocations = g_allocations.load();
+		uint64_t allocatedBytes = g_allocatedBytes.load();
+		auto start = std::chrono::steady_clock::now();
+		run(current);
+		std::chrono::duration<double, std::milli> elapsed =
+				std::chrono::steady_clock::now() - start;
+		current.milliseconds = elapsed.count();
+		current.allocations = g_allocations.load() - allocations;
+		current.allocatedBytes = g_allocatedBytes.load() - allocatedBytes;
+		if (current.milliseconds < best.milliseconds) {
+			best = current;
+		}
+	}
+	return best;
+}
+
+// Per second, or 0 for phases too quick to time
+double rate(double amount, double milliseconds) {
+	return milliseconds > 0.0 ? amount * 1000.0 / milliseconds : 0.0;
+}
+
+void report(const std::string &workload, const std::string &phase,
+		const Measure &m, bool csv) {
+	double commandRate = rate(m.commands, m.milliseconds);
+	double objectRate = rate(m.objects, m.milliseconds);
+	double megabyteRate = rate(m.bytes / 1e6, m.milliseconds);
+	if (csv) {
+		std::cout << workload << "," << phase << "," << m.milliseconds << ","
+				<< commandRate << "," << objectRate << "," << megabyteRate
+				<< "," << m.allocations << "," << m.allocatedBytes
+				<< std::endl;
+		return;
+	}
+	std::cout << "  " << std::left << std::setw(8) << phase << std::right
+			<< std::fixed << std::setprecision(2) << std::setw(10)
+			<< m.milliseconds << " ms" << std::setprecision(0);
+	if (m.commands > 0) {
+		std::cout << std::setw(12) << commandRate << " cmd/s";
+	}
+	if (m.objects > 0) {
+		std::cout << std::setw(12) << objectRate << " obj/s";
+	}
+	if (m.bytes > 0) {
+		std::cout << std::setprecision(2) << std::setw(9) << megabyteRate
+				<< " MB/s";
+	}
+	std::cout << std::setw(10) << m.allocations << " allocs "
+			<< std::setprecision(1) << m.allocatedBytes / 1e6 << " MB"
+			<< std::endl;
+}
+
+// Processes the Gerber with warnings silenced, as runs repeat them
+std::vector<std::shared_ptr<GraphicalObject>> process(
+		const std::string &gerber) {
+	std::istringstream stream(gerber);
+	FileProcessor fileProcessor;
+	std::streambuf *errors = std::cerr.rdbuf(nullptr);
+	fileProcessor.Process(stream);
+	std::cerr.rdbuf(errors);
+	std::cerr.clear();
+	return fileProcessor.GetProcessor().GetObjects();
+}
+
+void benchWorkload(const Workload &workload,
+		const std::vector<std::string> &phases, unsigned int repeat,
+		bool csv) {
+	auto wanted = [&phases](const std::string &phase) {
+		return std::find(phases.begin(), phases.end(), phase) != phases.end();
+	};
+	std::vector<std::shared_ptr<GraphicalObject>> objects = process(
+			workload.gerber);
+	if (objects.empty()) {
+		throw std::invalid_argument("no objects");
+	}
+	Box box = objects.front()->GetBox();
+	for (const std::shared_ptr<GraphicalObject> &obj : objects) {
+		box = box.Extend(obj->GetBox());
+	}
+	if (!csv) {
+		std::cout << workload.name << " (" << workload.gerber.size()
+				<< " bytes, " << objects.size() << " objects)" << std::endl;
+	}
+
+	uint64_t commands = 0;
+	if (wanted("lex")) {
+		Measure lexed = measure(repeat, [&workload](Measure &m) {
+			std::istringstream stream(workload.gerber);
+			FileParser parser(stream);
+			while (!parser.GetNextCommand().empty()) {
+				m.commands++;
+			}
+			m.bytes = workload.gerber.size();
+		});
+		commands = lexed.commands;
+		report(workload.name, "lex", lexed, csv);
+	}
+	if (wanted("process")) {
+		// Command handlers parse their words and build objects in one step
+		report(workload.name, "process",
+				measure(repeat, [&workload, commands](Measure &m) {
+					m.objects = process(workload.gerber).size();
+					m.commands = commands;
+					m.bytes = workload.gerber.size();
+				}), csv);
+	}
+	if (wanted("box")) {
+		report(workload.name, "box", measure(repeat, [&objects](Measure &m) {
+			Box extent = objects.front()->GetBox();
+			for (const std::shared_ptr<GraphicalObject> &obj : objects) {
+				extent = extent.Extend(obj->GetBox());
+			}
+			m.objects = objects.size();
+		}), csv);
+	}
+	if (wanted("svg")) {
+		report(workload.name, "svg", measure(repeat, [&objects, &box](
+				Measure &m) {
+			SvgSerializer serializer(box.Pad(0.5));
+			for (std::shared_ptr<GraphicalObject> obj : objects) {
+				obj->Serialize(serializer, Point());
+			}
+			std::ostringstream svg;
+			serializer.Save(svg, ".svg");
+			m.objects = objects.size();
+			m.bytes = svg.tellp();
+		}), csv);
+	}
+	if (wanted("cgal")) {
+		try {
+			report(workload.name, "cgal", measure(repeat, [&objects](
+					Measure &m) {
+				CgalSerializer<Epick> serializer;
+				for (std::shared_ptr<GraphicalObject> obj : objects) {
+					obj->Serialize(serializer, Point());
+				}
+				serializer.GetPolygonSet();
+				m.objects = objects.size();
+			}), csv);
+		} catch (const std::exception &ex) {
+			std::cerr << workload.name << ": cgal failed: " << ex.what()
+					<< std::endl;
+		}
+	}
+}
+
+// Header of a generated workload, in mm with 6 decimals
+std::string generatedHeader() {
+	return "%FSLAX26Y26*%\n%MOMM*%\n%ADD10C,0.5*%\n%ADD11R,0.6X0.4*%\n"
+			"%ADD12O,0.6X1.2*%\n%ADD13P,0.8X6*%\n%LPD*%\nG01*\n";
+}
+
+// A scale x scale grid of pads, cycling through four apertures
+Workload generateFlashes(int scale) {
+	std::ostringstream gerber;
+	gerber << generatedHeader();
+	for (int row = 0; row < scale; row++) {
+		for (int col = 0; col < scale; col++) {
+			if (col % 8 == 0) {
+				gerber << "D" << 10 + (row + col / 8) % 4 << "*\n";
+			}
+			gerber << "X" << col * 1500000 << "Y" << row * 1500000 << "D03*\n";
+		}
+	}
+	gerber << "M02*\n";
+	return {"flashes x" + std::to_string(scale * scale), gerber.str()};
+}
+
+// A zigzag chain of scale x scale straight and arc segments
+Workload generateTracks(int scale) {
+	std::ostringstream gerber;
+	gerber << generatedHeader() << "D10*\nG75*\nX0Y0D02*\n";
+	for (int row = 0; row < scale; row++) {
+		long y = row * 2000000L;
+		for (int col = 1; col < scale; col++) {
+			long x = (row % 2 == 0 ? col : scale - 1 - col) * 1000000L;
+			bool offset = col % 2 == 1 && col + 1 < scale;
+			gerber << "X" << x << "Y" << y + offset * 300000 << "D01*\n";
+		}
+		// Turn to the next row on a half circle
+		gerber << "G0" << (row % 2 == 0 ? 3 : 2) << "*X"
+				<< (row % 2 == 0 ? scale - 1 : 0) * 1000000L << "Y"
+				<< y + 2000000L << "I" << 0 << "J" << 1000000L << "D01*\nG01*\n";
+	}
+	gerber << "M02*\n";
+	return {"tracks x" + std::to_string(scale * scale), gerber.str()};
+}
+
+// Rounded rectangle regions in a grid, scale x scale / 4 of them, every
+// fourth cleared by a smaller one inside it
+Workload generateRegions(int scale) {
+	std::ostringstream gerber;
+	gerber << generatedHeader() << "G75*\n";
+	int side = std::max(1, scale / 2);
+	for (int row = 0; row < side; row++) {
+		for (int col = 0; col < side; col++) {
+			long x = col * 4000000L;
+			long y = row * 4000000L;
+			for (int clear = 0; clear < ((row + col) % 4 == 0 ? 2 : 1);
+					clear++) {
+				long inset = clear * 800000L;
+				long left = x + inset;
+				long bottom = y + inset;
+				long right = x + 3000000L - inset;
+				long top = y + 3000000L - inset;
+				long r = 400000L;
+				gerber << (clear ? "%LPC*%\n" : "") << "G36*\n";
+				gerber << "X" << left + r << "Y" << bottom << "D02*\nG01*\n";
+				gerber << "X" << right - r << "Y" << bottom << "D01*\n";
+				gerber << "G03*X" << right << "Y" << bottom + r << "I0J" << r
+						<< "D01*\nG01*\n";
+				gerber << "X" << right << "Y" << top - r << "D01*\n";
+				gerber << "G03*X" << right - r << "Y" << top << "I" << -r
+						<< "J0D01*\nG01*\n";
+				gerber << "X" << left + r << "Y" << top << "D01*\n";
+				gerber << "G03*X" << left << "Y" << top - r << "I0J" << -r
+						<< "D01*\nG01*\n";
+				gerber << "X" << left << "Y" << bottom + r << "D01*\n";
+				gerber << "G03*X" << left + r << "Y" << bottom << "I" << r
+						<< "J0D01*\nG01*\n";
+				gerber << "G37*\n" << (clear ? "%LPD*%\n" : "");
+			}
+		}
+	}
+	gerber << "M02*\n";
+	return {"regions x" + std::to_string(side * side), gerber.str()};
+}
+
+int main(int argc, char *argv[]) {
+	unsigned int repeat = 3;
+	int scale = 50;
+	bool csv = false;
+	std::vector<std::string> phases = ALL_PHASES;
+	std::vector<std::filesystem::path> files;
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			if (arg == "--repeat" && i + 1 < argc) {
+				repeat = std::max(1, std::stoi(argv[++i]));
+			} else if (arg == "--scale" && i + 1 < argc) {
+				scale = std::stoi(argv[++i]);
+			} else if (arg == "--phases" && i + 1 < argc) {
+				phases.clear();
+				std::istringstream list(argv[++i]);
+				std::string phase;
+				while (std::getline(list, phase, ',')) {
+					if (std::find(ALL_PHASES.begin(), ALL_PHASES.end(), phase)
+							== ALL_PHASES.end()) {
+						throw std::invalid_argument("unrecognized phase " + phase);
+					}
+					phases.push_back(phase);
+				}
+			} else if (arg == "--csv") {
+				csv = true;
+			} else if (arg.rfind("--", 0) == 0) {
+				throw std::invalid_argument("unrecognized option " + arg);
+			} else if (std::filesystem::is_directory(arg)) {
+				for (const auto &entry : std::filesystem::directory_iterator(
+						arg)) {
+					if (entry.path().extension() == ".gbr") {
+						files.push_back(entry.path());
+					}
+				}
+			} else {
+				files.push_back(arg);
+			}
+		}
+	} catch (const std::exception &ex) {
+		std::cerr << ex.what() << std::endl;
+		std::cerr << "Usage: gerbex_bench [--repeat <n>] [--scale <n>]"
+				<< " [--phases lex,process,box,svg,cgal] [--csv]"
+				<< " <gbr_file_or_dir>..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::sort(files.begin(), files.end());
+
+	std::vector<Workload> workloads;
+	for (const std::filesystem::path &file : files) {
+		std::ifstream gerber(file, std::ifstream::in | std::ifstream::binary);
+		if (!gerber.good()) {
+			std::cerr << "failed to open " << file << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::ostringstream contents;
+		contents << gerber.rdbuf();
+		workloads.push_back( { file.filename().string(), contents.str() });
+	}
+	if (scale > 0) {
+		workloads.push_back(generateFlashes(scale));
+		workloads.push_back(generateTracks(scale));
+		workloads.push_back(generateRegions(scale));
+	}
+
+	if (csv) {
+		std::cout << "workload,phase,ms,commands_per_s,objects_per_s,"
+				<< "mb_per_s,allocations,allocated_bytes" << std::endl;
+	}
+	int failures = 0;
+	for (const Workload &workload : workloads) {
+		try {
+			benchWorkload(workload, phases, repeat, csv);
+		} catch (const std::exception &ex) {
+			std::cerr << workload.name << ": " << ex.what() << std::endl;
+			failures++;
+		}
+	}
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -22,214 +22,316 @@
 #include "CgalSerializer.h"
 #include "Contour.h"
 #include "Point.h"
+#include "PolygonWriter.h"
 #include "Segment.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <cmath>
-#include <CGAL/draw_polygon_set_2.h>
-
-#define NUM_ARC_POINTS 7
-#define NUM_CIRCLE_POINTS 12
-#define NUM_CAP_POINTS 5
+#include <future>
+#include <iterator>
+#include <type_traits>
 
 namespace gerbex {
 
-CgalSerializer::CgalSerializer() :
-		m_items { } {
+template<typename K>
+CgalSerializer<K>::CgalSerializer() :
+		m_items { }, m_tiles { 1 }, m_threads { 0 }, m_tessellator { } {
 }
 
-void CgalSerializer::AddDraw(pSerialItem target, double width,
+template<typename K>
+void CgalSerializer<K>::AddDraw(pSerialItem target, double width,
 		const Segment &segment) {
-	std::shared_ptr<Polygon_set_2> set = CgalItem::GetPolygonSet(target);
-	Point start = segment.GetStart();
-	Point end = segment.GetEnd();
-	double angle = atan2(end.GetY() - start.GetY(), end.GetX() - start.GetX());
-	double radius = 0.5 * width;
-	std::vector<Point_2> startCap = makeArc(start, radius, angle + M_PI_2,
-			angle + 3.0 * M_PI_2, NUM_CAP_POINTS);
-	std::vector<Point_2> endCap = makeArc(end, radius, angle - M_PI_2,
-			angle + M_PI_2, NUM_CAP_POINTS);
-
-	Polygon_2 poly;
-	poly.insert(poly.end(), startCap.begin(), startCap.end());
-	poly.insert(poly.end(), endCap.begin(), endCap.end());
-	set->join(poly);
-}
-
-void CgalSerializer::AddPolygon(pSerialItem target,
+	OutlineItem::Get(target)->Add(m_tessellator.MakeDraw(segment, width));
+}
+
+template<typename K>
+void CgalSerializer<K>::AddPolygon(pSerialItem target,
 		const std::vector<Point> &points) {
 	if (points.size() < 3) {
 		throw std::invalid_argument("invalid polygon");
 	}
-	std::shared_ptr<Polygon_set_2> set = CgalItem::GetPolygonSet(target);
-	Polygon_2 poly;
-	for (const Point &pt : points) {
-		poly.push_back(Point_2(pt.GetX(), pt.GetY()));
-	}
-	if (poly.orientation() == CGAL::Orientation::NEGATIVE) {
-		poly.reverse_orientation();
-	}
-	set->join(poly);
+	std::shared_ptr<OutlineItem> item = OutlineItem::Get(target);
+	item->Add(Outline(points));
 }
 
-pSerialItem CgalSerializer::NewGroup(pSerialItem parent) {
-	std::shared_ptr<CgalItem> item = std::make_shared<CgalItem>(Polarity::Dark);
+template<typename K>
+pSerialItem CgalSerializer<K>::NewGroup(pSerialItem parent) {
+	// Groups are flattened along with their parent's polarity run
+	std::shared_ptr<OutlineItem> item = std::make_shared<OutlineItem>(
+			OutlineItem::Get(parent)->GetPolarity());
 	m_items.push_back(item);
 	return item;
 }
 
-pSerialItem CgalSerializer::NewMask(const Box &box) {
-	return std::make_shared<CgalItem>(Polarity::Clear);
+template<typename K>
+pSerialItem CgalSerializer<K>::NewMask(const Box &box) {
+	return std::make_shared<OutlineItem>(Polarity::Clear);
 }
 
-pSerialItem CgalSerializer::GetTarget(Polarity polarity) {
-	std::shared_ptr<CgalItem> item = std::make_shared<CgalItem>(polarity);
+template<typename K>
+pSerialItem CgalSerializer<K>::GetTarget(Polarity polarity) {
+	std::shared_ptr<OutlineItem> item = std::make_shared<OutlineItem>(polarity);
 	m_items.push_back(item);
 	return item;
 }
 
-void CgalSerializer::AddArc(pSerialItem target, double width,
+template<typename K>
+void CgalSerializer<K>::AddArc(pSerialItem target, double width,
 		const ArcSegment &segment) {
-	std::shared_ptr<Polygon_set_2> set = CgalItem::GetPolygonSet(target);
-	if (segment.IsCircle()) {
-		Point c = segment.GetCenter();
-		double r = segment.GetRadius();
-		double dr = 0.5 * width;
-		Polygon_2 outer = makeRegularPolygon(c, r + dr, NUM_CIRCLE_POINTS);
-		Polygon_2 inner = makeRegularPolygon(c, r - dr, NUM_CIRCLE_POINTS);
-		inner.reverse_orientation();
-		Polygon_with_holes_2 circle(outer);
-		circle.add_hole(inner);
-		set->join(circle);
-	} else {
-		Point start = segment.GetStart();
-		Point end = segment.GetEnd();
-		Point center = segment.GetCenter();
-		if (segment.GetDirection() == ArcDirection::Clockwise) {
-			start = segment.GetEnd();
-			end = segment.GetStart();
-		}
-		double startAngle = atan2(start.GetY() - center.GetY(),
-				start.GetX() - center.GetX());
-		double endAngle = atan2(end.GetY() - center.GetY(),
-				end.GetX() - center.GetX());
-		double capRadius = 0.5 * width;
-		double outerRadius = segment.GetRadius() + capRadius;
-		double innerRadius = segment.GetRadius() - capRadius;
-		int arcN = NUM_ARC_POINTS;
-		int capN = NUM_CAP_POINTS;
-		std::vector<Point_2> startCap = makeArc(start, capRadius,
-				startAngle - M_PI, startAngle, capN);
-		startCap.pop_back();
-		std::vector<Point_2> outerArc = makeArc(center, outerRadius, startAngle,
-				endAngle, arcN);
-		outerArc.pop_back();
-		std::vector<Point_2> endCap = makeArc(end, capRadius, endAngle,
-				endAngle + M_PI, capN);
-		endCap.pop_back();
-		std::vector<Point_2> innerArc = makeArc(center, innerRadius, endAngle,
-				startAngle, arcN);
-		innerArc.pop_back();
-
-		Polygon_2 poly;
-		poly.insert(poly.end(), startCap.begin(), startCap.end());
-		poly.insert(poly.end(), outerArc.begin(), outerArc.end());
-		poly.insert(poly.end(), endCap.begin(), endCap.end());
-		poly.insert(poly.end(), innerArc.begin(), innerArc.end());
-		set->join(poly);
-	}
-}
-
-void CgalSerializer::SetMask(pSerialItem target, pSerialItem mask) {
-	std::shared_ptr<Polygon_set_2> targetSet = CgalItem::GetPolygonSet(target);
-	std::shared_ptr<Polygon_set_2> maskSet = CgalItem::GetPolygonSet(mask);
-	targetSet->difference(*maskSet);
-}
-
-void CgalSerializer::AddCircle(pSerialItem target, double radius,
+	OutlineItem::Get(target)->Add(m_tessellator.MakeArcDraw(segment, width));
+}
+
+template<typename K>
+void CgalSerializer<K>::SetMask(pSerialItem target, pSerialItem mask) {
+	OutlineItem::Get(target)->SetMask(OutlineItem::Get(mask));
+}
+
+template<typename K>
+void CgalSerializer<K>::AddCircle(pSerialItem target, double radius,
 		const Point &center) {
-	std::shared_ptr<Polygon_set_2> set = CgalItem::GetPolygonSet(target);
-	Polygon_2 circle = makeRegularPolygon(center, radius, NUM_CIRCLE_POINTS);
-	set->join(circle);
-}
-
-void CgalSerializer::AddContour(pSerialItem target, const Contour &contour) {
-	if (!contour.IsCircle()) {
-		std::shared_ptr<Polygon_set_2> set = CgalItem::GetPolygonSet(target);
-		Polygon_2 poly;
-		for (std::shared_ptr<Segment> seg : contour.GetSegments()) {
-			std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<
-					ArcSegment>(seg);
-			if (arc) {
-				Point start = arc->GetStart();
-				Point end = arc->GetEnd();
-				Point center = arc->GetCenter();
-				double startAngle = atan2(start.GetY() - center.GetY(),
-						start.GetX() - center.GetX());
-				double endAngle = atan2(end.GetY() - center.GetY(),
-						end.GetX() - center.GetX());
-				if (arc->GetDirection() == ArcDirection::Clockwise
-						&& endAngle > startAngle) {
-					endAngle -= 2.0 * M_PI;
-				} else if (arc->GetDirection() == ArcDirection::CounterClockwise
-						&& endAngle < startAngle) {
-					endAngle += 2.0 * M_PI;
-				}
-				std::vector<Point_2> arc_points = makeArc(center,
-						arc->GetRadius(), startAngle, endAngle, NUM_ARC_POINTS);
-				arc_points.pop_back();
-				poly.insert(poly.end(), arc_points.begin(), arc_points.end());
-			} else {
-				Point_2 pt(seg->GetStart().GetX(), seg->GetStart().GetY());
-				poly.push_back(pt);
-			}
+	std::shared_ptr<OutlineItem> item = OutlineItem::Get(target);
+	item->Add(Outline(m_tessellator.MakeCircle(center, radius)));
+}
+
+template<typename K>
+void CgalSerializer<K>::AddContour(pSerialItem target, const Contour &contour) {
+	OutlineItem::Get(target)->Add(Outline(m_tessellator.MakeContour(contour)));
+}
+
+template<typename K>
+void CgalSerializer<K>::Save(std::ostream &stream,
+		const std::string &extension) {
+	PolygonFormat format = PolygonWriter::FormatFromExtension(extension);
+	std::vector<Polygon_with_holes_2> polygons;
+	GetPolygonSet().polygons_with_holes(std::back_inserter(polygons));
+	size_t numRings = 0;
+	size_t numPoints = 0;
+	for (const Polygon_with_holes_2 &polygon : polygons) {
+		numRings += 1 + polygon.number_of_holes();
+		numPoints += polygon.outer_boundary().size();
+		for (auto hole = polygon.holes_begin(); hole != polygon.holes_end();
+				++hole) {
+			numPoints += hole->size();
 		}
-		if (poly.orientation() == CGAL::Orientation::NEGATIVE) {
-			poly.reverse_orientation();
+	}
+
+	PolygonWriter writer(stream, format);
+	writer.Begin(numRings, numPoints);
+	for (const Polygon_with_holes_2 &polygon : polygons) {
+		writer.Write(makeOutline(polygon));
+	}
+	writer.End();
+}
+
+template<typename K>
+void CgalSerializer<K>::SetTolerance(double tolerance) {
+	m_tessellator.SetTolerance(tolerance);
+}
+
+template<typename K>
+void CgalSerializer<K>::SetShapeCache(std::shared_ptr<ShapeCache> shapes) {
+	m_tessellator.SetShapeCache(shapes);
+}
+
+template<typename K>
+void CgalSerializer<K>::SetTiling(unsigned int tiles, unsigned int threads) {
+	if (tiles == 0) {
+		throw std::invalid_argument("tiling needs at least one tile");
+	}
+	m_tiles = tiles;
+	m_threads = threads;
+}
+
+template<typename K>
+typename CgalSerializer<K>::Polygon_set_2 CgalSerializer<
+		K>::GetPolygonSet() const {
+	if (m_tiles == 1) {
+		return flatten(nullptr);
+	}
+
+	bool empty = true;
+	Box bounds;
+	for (std::shared_ptr<OutlineItem> item : m_items) {
+		for (const Outline &outline : item->GetOutlines()) {
+			bounds = empty ? outline.box : bounds.Extend(outline.box);
+			empty = false;
 		}
-		set->join(poly);
-	} else {
-		const std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<
-				ArcSegment>(contour.GetSegments().back());
-		AddCircle(target, arc->GetRadius(), arc->GetCenter());
 	}
+	if (empty) {
+		return Polygon_set_2();
+	}
+
+	// Power of two tiles on aligned edges keep the corners exact, so
+	// neighbouring tiles share their boundary coordinates when stitched
+	double span = std::max(bounds.GetWidth(), bounds.GetHeight());
+	if (span <= 0.0) {
+		return flatten(nullptr);
+	}
+	double size = std::exp2(std::ceil(std::log2(span / m_tiles)));
+	double left = std::floor(bounds.GetLeft() / size) * size;
+	double bottom = std::floor(bounds.GetBottom() / size) * size;
+	int cols = std::ceil((bounds.GetRight() - left) / size);
+	int rows = std::ceil((bounds.GetTop() - bottom) / size);
+
+	// Each tile builds its own kernel objects from the buffered outlines,
+	// and they are only handed over once the tile is done
+	ThreadPool pool(m_threads);
+	std::vector<std::future<std::vector<Polygon_with_holes_2>>> results;
+	for (int row = 0; row < rows; row++) {
+		for (int col = 0; col < cols; col++) {
+			Box tile(size, size, left + col * size, bottom + row * size);
+			results.push_back(pool.Submit([this, tile]() {
+				std::vector<Polygon_with_holes_2> polygons;
+				flatten(&tile).polygons_with_holes(
+						std::back_inserter(polygons));
+				return polygons;
+			}));
+		}
+	}
+
+	std::vector<Polygon_with_holes_2> polygons;
+	for (std::future<std::vector<Polygon_with_holes_2>> &result : results) {
+		std::vector<Polygon_with_holes_2> tilePolygons = result.get();
+		polygons.insert(polygons.end(), tilePolygons.begin(),
+				tilePolygons.end());
+	}
+	Polygon_set_2 stitched;
+	stitched.join(polygons.begin(), polygons.end());
+	return stitched;
 }
 
-void CgalSerializer::SaveFile(const std::string &path) {
+template<typename K>
+typename CgalSerializer<K>::Polygon_set_2 CgalSerializer<K>::flatten(
+		const Box *tile) const {
 	Polygon_set_2 result;
-	for (std::shared_ptr<CgalItem> item : m_items) {
-		if (item->GetPolarity() == Polarity::Dark) {
-			result.join(*item->GetPolygonSet());
+	std::vector<Polygon_with_holes_2> run;
+	for (size_t i = 0; i < m_items.size(); i++) {
+		appendPolygons(*m_items[i], tile, run);
+		Polarity polarity = m_items[i]->GetPolarity();
+		if (i + 1 < m_items.size()
+				&& m_items[i + 1]->GetPolarity() == polarity) {
+			continue;
+		}
+		if (run.empty()) {
+			continue;
+		}
+		if (polarity == Polarity::Dark) {
+			result.join(run.begin(), run.end());
 		} else {
-			result.difference(*item->GetPolygonSet());
+			Polygon_set_2 clear;
+			clear.join(run.begin(), run.end());
+			result.difference(clear);
+		}
+		run.clear();
+	}
+	if (tile) {
+		std::vector<Point> corners = { Point(tile->GetLeft(),
+				tile->GetBottom()), Point(tile->GetRight(), tile->GetBottom()),
+				Point(tile->GetRight(), tile->GetTop()), Point(tile->GetLeft(),
+						tile->GetTop()) };
+		result.intersection(
+				makeRing(corners, CGAL::COUNTERCLOCKWISE));
+	}
+	return result;
+}
+
+template<typename K>
+typename CgalSerializer<K>::Polygon_set_2 CgalSerializer<K>::flattenItem(
+		const OutlineItem &item, const Box *tile) const {
+	std::vector<Polygon_with_holes_2> polygons;
+	for (const Outline &outline : item.GetOutlines()) {
+		if (!tile || outline.box.Overlaps(*tile)) {
+			polygons.push_back(makePolygon(outline));
+		}
+	}
+	Polygon_set_2 set;
+	set.join(polygons.begin(), polygons.end());
+	if (item.GetMask()) {
+		set.difference(flattenItem(*item.GetMask(), tile));
+	}
+	return set;
+}
+
+template<typename K>
+void CgalSerializer<K>::appendPolygons(const OutlineItem &item, const Box *tile,
+		std::vector<Polygon_with_holes_2> &polygons) const {
+	// A masked item is flattened first, so its mask only cuts this item
+	if (item.GetMask()) {
+		flattenItem(item, tile).polygons_with_holes(
+				std::back_inserter(polygons));
+		return;
+	}
+	for (const Outline &outline : item.GetOutlines()) {
+		if (!tile || outline.box.Overlaps(*tile)) {
+			polygons.push_back(makePolygon(outline));
 		}
 	}
-	CGAL::draw(result);
 }
 
-std::vector<Point_2> CgalSerializer::makeArc(const Point &center, double radius,
-		double start, double end, int N) {
-	double step = (end - start) / (N - 1);
-	std::vector<Point_2> vertices;
-	for (int i = 0; i < N; i++) {
-		double angle = start + i * step;
-		Point_2 pt(center.GetX() + radius * cos(angle),
-				center.GetY() + radius * sin(angle));
-		vertices.push_back(pt);
+template<typename K>
+typename CgalSerializer<K>::Polygon_with_holes_2 CgalSerializer<K>::makePolygon(
+		const Outline &outline) const {
+	Polygon_with_holes_2 polygon(
+			makeRing(outline.boundary, CGAL::COUNTERCLOCKWISE));
+	for (const std::vector<Point> &hole : outline.holes) {
+		polygon.add_hole(makeRing(hole, CGAL::CLOCKWISE));
+	}
+	return polygon;
+}
+
+template<typename K>
+Outline CgalSerializer<K>::makeOutline(
+		const Polygon_with_holes_2 &polygon) const {
+	Outline outline(makePoints(polygon.outer_boundary()));
+	for (auto hole = polygon.holes_begin(); hole != polygon.holes_end();
+			++hole) {
+		outline.holes.push_back(makePoints(*hole));
+	}
+	return outline;
+}
+
+template<typename K>
+std::vector<Point> CgalSerializer<K>::makePoints(const Polygon_2 &ring) const {
+	std::vector<Point> points;
+	points.reserve(ring.size());
+	for (auto vertex = ring.vertices_begin(); vertex != ring.vertices_end();
+			++vertex) {
+		points.push_back(
+				Point(CGAL::to_double(vertex->x()),
+						CGAL::to_double(vertex->y())));
+	}
+	return points;
+}
+
+template<typename K>
+typename CgalSerializer<K>::Polygon_2 CgalSerializer<K>::makeRing(
+		const std::vector<Point> &points, CGAL::Orientation orientation) const {
+	Polygon_2 ring;
+	for (const Point &pt : points) {
+		ring.push_back(makePoint(pt.GetX(), pt.GetY()));
+	}
+	if (ring.orientation() != orientation) {
+		ring.reverse_orientation();
 	}
-	return vertices;
+	return ring;
 }
 
-Polygon_2 CgalSerializer::makeRegularPolygon(const Point &center, double radius,
-		int N) {
-	double angleStep = 2 * M_PI / N;
-	Polygon_2 poly;
-	for (int i = 0; i < N; i++) {
-		double angle = i * angleStep;
-		double x = radius * cos(angle);
-		double y = radius * sin(angle);
-		Point_2 pt(x + center.GetX(), y + center.GetY());
-		poly.push_back(pt);
+template<typename K>
+typename CgalSerializer<K>::Point_2 CgalSerializer<K>::makePoint(double x,
+		double y) const {
+	if constexpr (std::is_same_v<K, GridKernel>) {
+		// Integral doubles convert exactly
+		typedef typename K::FT FT;
+		FT steps(GRID_STEPS_PER_UNIT);
+		return Point_2(FT(std::round(x * GRID_STEPS_PER_UNIT)) / steps,
+				FT(std::round(y * GRID_STEPS_PER_UNIT)) / steps);
+	} else {
+		return Point_2(x, y);
 	}
-	return poly;
 }
 
+template class CgalSerializer<Epick>;
+template class CgalSerializer<Epec>;
+template class CgalSerializer<GridKernel>;
+
 } /* namespace gerbex */
@@ -20,50 +20,57 @@
 #ifndef CGALSERIALIZER_H_
 #define CGALSERIALIZER_H_
 
+#include "Box.h"
+#include "Outline.h"
+#include "OutlineItem.h"
+#include "Point.h"
 #include "Serializer.h"
+#include "Tessellator.h"
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Exact_rational.h>
 #include <CGAL/Polygon_2.h>
 #include <CGAL/Polygon_with_holes_2.h>
 #include <CGAL/Polygon_set_2.h>
-
-typedef CGAL::Exact_predicates_exact_constructions_kernel K;
-typedef CGAL::Polygon_2<K> Polygon_2;
-typedef CGAL::Polygon_with_holes_2<K> Polygon_with_holes_2;
-typedef CGAL::Polygon_set_2<K> Polygon_set_2;
-typedef CGAL::Point_2<K> Point_2;
+#include <CGAL/Simple_cartesian.h>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
 
 namespace gerbex {
 
-class CgalItem: public SerialItem {
-public:
-	CgalItem(Polarity polarity) :
-			m_polarity { polarity }, m_polygonSet { std::make_shared<
-					Polygon_set_2>() } {
-	}
-	virtual ~CgalItem() = default;
-	const std::shared_ptr<Polygon_set_2> GetPolygonSet() const {
-		return m_polygonSet;
-	}
-	static std::shared_ptr<Polygon_set_2> GetPolygonSet(pSerialItem item) {
-		std::shared_ptr<CgalItem> cgal = std::dynamic_pointer_cast<CgalItem>(
-				item);
-		if (!cgal) {
-			throw std::invalid_argument("Cgal received non-Cgal item");
-		}
-		return cgal->m_polygonSet;
-	}
+/*
+ * Kernels the CGAL serializer is instantiated for.
+ * Epick is fastest but its constructions are rounded, so boolean operations
+ * may fail on nearly degenerate input. Epec is exact but lazy, and slow.
+ * GridKernel is exact without laziness, with input snapped to the
+ * finest Gerber grid to keep the rationals small.
+ */
+typedef CGAL::Exact_predicates_inexact_constructions_kernel Epick;
+typedef CGAL::Exact_predicates_exact_constructions_kernel Epec;
+typedef CGAL::Simple_cartesian<CGAL::Exact_rational> GridKernel;
 
-	Polarity GetPolarity() const {
-		return m_polarity;
-	}
-
-private:
-	Polarity m_polarity;
-	std::shared_ptr<Polygon_set_2> m_polygonSet;
-};
+// Finest Gerber coordinate resolution, 6 decimal places
+constexpr int GRID_STEPS_PER_UNIT = 1000000;
 
+/*
+ * Joins all objects into a single polygon set, using kernel K.
+ * Consecutive targets of equal polarity are unioned together in one pass.
+ * With tiling enabled, the layer is split into a grid of tiles that are
+ * flattened in parallel and then joined.
+ * Kernel objects are only built when flattening, so that each worker
+ * thread builds its own and lazy kernels are never shared across threads.
+ * Explicitly instantiated for Epick, Epec and GridKernel.
+ */
+template<typename K>
 class CgalSerializer: public Serializer {
 public:
+	typedef CGAL::Polygon_2<K> Polygon_2;
+	typedef CGAL::Polygon_with_holes_2<K> Polygon_with_holes_2;
+	typedef CGAL::Polygon_set_2<K> Polygon_set_2;
+	typedef CGAL::Point_2<K> Point_2;
+
 	CgalSerializer();
 	virtual ~CgalSerializer() = default;
 	pSerialItem NewMask(const Box &box) override;
@@ -79,15 +86,38 @@ public:
 	void AddCircle(pSerialItem target, double radius, const Point &center)
 			override;
 	void AddContour(pSerialItem target, const Contour &contour) override;
-	void SaveFile(const std::string &path) override;
+	// Writes the flattened layer as VTU, WKT or GeoJSON, by file extension
+	void Save(std::ostream &stream, const std::string &extension) override;
+	// Flatten on a grid of tiles x tiles, using the given number of threads.
+	// One tile, the default, flattens the whole layer on the calling thread.
+	void SetTiling(unsigned int tiles, unsigned int threads = 0);
+	// Maximum chord error when approximating arcs, in layer units
+	void SetTolerance(double tolerance);
+	// Shares tessellated shapes with other serializers of the same tolerance
+	void SetShapeCache(std::shared_ptr<ShapeCache> shapes);
+	Polygon_set_2 GetPolygonSet() const;
 
 private:
-	std::vector<Point_2> makeArc(const Point &center, double radius,
-			double start, double end, int N);
-	Polygon_2 makeRegularPolygon(const Point &center, double radius, int N);
-	std::vector<std::shared_ptr<CgalItem>> m_items;
+	Polygon_set_2 flatten(const Box *tile) const;
+	Polygon_set_2 flattenItem(const OutlineItem &item, const Box *tile) const;
+	void appendPolygons(const OutlineItem &item, const Box *tile,
+			std::vector<Polygon_with_holes_2> &polygons) const;
+	Polygon_with_holes_2 makePolygon(const Outline &outline) const;
+	Outline makeOutline(const Polygon_with_holes_2 &polygon) const;
+	std::vector<Point> makePoints(const Polygon_2 &ring) const;
+	Polygon_2 makeRing(const std::vector<Point> &points,
+			CGAL::Orientation orientation) const;
+	Point_2 makePoint(double x, double y) const;
+	std::vector<std::shared_ptr<OutlineItem>> m_items;
+	unsigned int m_tiles;
+	unsigned int m_threads;
+	Tessellator m_tessellator;
 };
 
+extern template class CgalSerializer<Epick>;
+extern template class CgalSerializer<Epec>;
+extern template class CgalSerializer<GridKernel>;
+
 } /* namespace gerbex */
 
 #endif /* CGALSERIALIZER_H_ */
@@ -0,0 +1,177 @@
+/*
+ * ClipperSerializer.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ArcSegment.h"
+#include "ClipperSerializer.h"
+#include "Contour.h"
+#include "PolygonWriter.h"
+#include "Segment.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace gerbex {
+
+ClipperSerializer::ClipperSerializer(double scaling) :
+		m_items { }, m_scaling { scaling }, m_tessellator { } {
+	if (scaling <= 0.0) {
+		throw std::invalid_argument("scaling must be positive");
+	}
+}
+
+pSerialItem ClipperSerializer::NewMask(const Box &box) {
+	(void) box;
+	return std::make_shared<OutlineItem>(Polarity::Clear);
+}
+
+void ClipperSerializer::AddDraw(pSerialItem target, double width,
+		const Segment &segment) {
+	OutlineItem::Get(target)->Add(m_tessellator.MakeDraw(segment, width));
+}
+
+void ClipperSerializer::AddPolygon(pSerialItem target,
+		const std::vector<Point> &points) {
+	if (points.size() < 3) {
+		throw std::invalid_argument("invalid polygon");
+	}
+	OutlineItem::Get(target)->Add(Outline(points));
+}
+
+pSerialItem ClipperSerializer::NewGroup(pSerialItem parent) {
+	std::shared_ptr<OutlineItem> item = std::make_shared<OutlineItem>(
+			OutlineItem::Get(parent)->GetPolarity());
+	m_items.push_back(item);
+	return item;
+}
+
+pSerialItem ClipperSerializer::GetTarget(Polarity polarity) {
+	std::shared_ptr<OutlineItem> item = std::make_shared<OutlineItem>(polarity);
+	m_items.push_back(item);
+	return item;
+}
+
+void ClipperSerializer::AddArc(pSerialItem target, double width,
+		const ArcSegment &segment) {
+	OutlineItem::Get(target)->Add(m_tessellator.MakeArcDraw(segment, width));
+}
+
+void ClipperSerializer::SetMask(pSerialItem target, pSerialItem mask) {
+	OutlineItem::Get(target)->SetMask(OutlineItem::Get(mask));
+}
+
+void ClipperSerializer::AddCircle(pSerialItem target, double radius,
+		const Point &center) {
+	OutlineItem::Get(target)->Add(
+			Outline(m_tessellator.MakeCircle(center, radius)));
+}
+
+void ClipperSerializer::AddContour(pSerialItem target,
+		const Contour &contour) {
+	OutlineItem::Get(target)->Add(
+			Outline(m_tessellator.MakeContour(contour)));
+}
+
+void ClipperSerializer::Save(std::ostream &stream, const std::string &extension) {
+	PolygonFormat format = PolygonWriter::FormatFromExtension(extension);
+	std::vector<Outline> outlines = GetOutlines();
+	size_t numRings = 0;
+	size_t numPoints = 0;
+	for (const Outline &outline : outlines) {
+		numRings += 1 + outline.holes.size();
+		numPoints += outline.boundary.size();
+		for (const std::vector<Point> &hole : outline.holes) {
+			numPoints += hole.size();
+		}
+	}
+
+	PolygonWriter writer(stream, format);
+	writer.Begin(numRings, numPoints);
+	for (const Outline &outline : outlines) {
+		writer.Write(outline);
+	}
+	writer.End();
+}
+
+void ClipperSerializer::SetTolerance(double tolerance) {
+	m_tessellator.SetTolerance(tolerance);
+}
+
+void ClipperSerializer::SetShapeCache(std::shared_ptr<ShapeCache> shapes) {
+	m_tessellator.SetShapeCache(shapes);
+}
+
+std::vector<Outline> ClipperSerializer::GetOutlines() const {
+	PolygonClipper clipper;
+	for (std::shared_ptr<OutlineItem> item : m_items) {
+		if (item->GetOutlines().empty()) {
+			continue;
+		}
+		size_t layer = clipper.AddLayer(item->GetPolarity());
+		addOutlines(clipper, layer, *item, false);
+		if (item->GetMask()) {
+			addOutlines(clipper, layer, *item->GetMask(), true);
+		}
+	}
+
+	std::vector<Outline> outlines;
+	for (const IntPolygon &polygon : clipper.Execute()) {
+		Outline outline(makePoints(polygon.outer));
+		for (const IntRing &hole : polygon.holes) {
+			outline.holes.push_back(makePoints(hole));
+		}
+		outlines.push_back(outline);
+	}
+	return outlines;
+}
+
+void ClipperSerializer::addOutlines(PolygonClipper &clipper, size_t layer,
+		const OutlineItem &item, bool mask) const {
+	for (const Outline &outline : item.GetOutlines()) {
+		std::vector<IntRing> holes;
+		for (const std::vector<Point> &hole : outline.holes) {
+			holes.push_back(makeRing(hole));
+		}
+		if (mask) {
+			clipper.AddMask(layer, makeRing(outline.boundary), holes);
+		} else {
+			clipper.AddPolygon(layer, makeRing(outline.boundary), holes);
+		}
+	}
+}
+
+IntRing ClipperSerializer::makeRing(const std::vector<Point> &points) const {
+	IntRing ring;
+	ring.reserve(points.size());
+	for (const Point &point : points) {
+		ring.push_back( { std::llround(point.GetX() * m_scaling), std::llround(
+				point.GetY() * m_scaling) });
+	}
+	return ring;
+}
+
+std::vector<Point> ClipperSerializer::makePoints(const IntRing &ring) const {
+	std::vector<Point> points;
+	points.reserve(ring.size());
+	for (const IntPoint &point : ring) {
+		points.push_back(Point(point.x / m_scaling, point.y / m_scaling));
+	}
+	return points;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,81 @@
+/*
+ * ClipperSerializer.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLIPPERSERIALIZER_H_
+#define CLIPPERSERIALIZER_H_
+
+#include "Box.h"
+#include "Outline.h"
+#include "OutlineItem.h"
+#include "Point.h"
+#include "PolygonClipper.h"
+#include "Serializer.h"
+#include "Tessellator.h"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Flattens all objects into polygons with holes using the integer
+ * PolygonClipper, with coordinates snapped to a grid of 1 / scaling.
+ * Each target is painted as one layer, in the order they were created.
+ */
+class ClipperSerializer: public Serializer {
+public:
+	ClipperSerializer(double scaling = 1000000.0);
+	virtual ~ClipperSerializer() = default;
+	pSerialItem NewMask(const Box &box) override;
+	void AddDraw(pSerialItem target, double width, const Segment &segment)
+			override;
+	void AddPolygon(pSerialItem target, const std::vector<Point> &points)
+			override;
+	pSerialItem NewGroup(pSerialItem parent) override;
+	pSerialItem GetTarget(Polarity polarity) override;
+	void AddArc(pSerialItem target, double width, const ArcSegment &segment)
+			override;
+	void SetMask(pSerialItem target, pSerialItem mask) override;
+	void AddCircle(pSerialItem target, double radius, const Point &center)
+			override;
+	void AddContour(pSerialItem target, const Contour &contour) override;
+	// Writes the flattened layer as VTU, WKT or GeoJSON, by file extension
+	void Save(std::ostream &stream, const std::string &extension) override;
+	// Maximum chord error when approximating arcs, in layer units
+	void SetTolerance(double tolerance);
+	// Shares tessellated shapes with other serializers of the same tolerance
+	void SetShapeCache(std::shared_ptr<ShapeCache> shapes);
+	// The flattened layer, in layer units
+	std::vector<Outline> GetOutlines() const;
+
+private:
+	void addOutlines(PolygonClipper &clipper, size_t layer,
+			const OutlineItem &item, bool mask) const;
+	IntRing makeRing(const std::vector<Point> &points) const;
+	std::vector<Point> makePoints(const IntRing &ring) const;
+	std::vector<std::shared_ptr<OutlineItem>> m_items;
+	double m_scaling;
+	Tessellator m_tessellator;
+};
+
+} /* namespace gerbex */
+
+#endif /* CLIPPERSERIALIZER_H_ */
@@ -0,0 +1,847 @@
+/*
+ * PolygonClipper.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PolygonClipper.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace gerbex {
+
+// Rounds of snapping before giving up, crossings are all gone after one
+const int MAX_SNAP_ROUNDS = 8;
+
+// Positions within kMaxCoordinate are off by less than 2^-10 in doubles, so
+// further apart than this they need no exact comparison
+const double POSITION_TOLERANCE = 1.0 / 256;
+
+static Int128 cross(int64_t ax, int64_t ay, int64_t bx, int64_t by) {
+	return static_cast<Int128>(ax) * by - static_cast<Int128>(ay) * bx;
+}
+
+static Int128 cross(const IntPoint &a, const IntPoint &b, const IntPoint &c) {
+	return cross(b.x - a.x, b.y - a.y, c.x - a.x, c.y - a.y);
+}
+
+static Int128 signedArea2(const IntRing &ring) {
+	Int128 area = 0;
+	for (size_t i = 0; i < ring.size(); i++) {
+		const IntPoint &a = ring[i];
+		const IntPoint &b = ring[(i + 1) % ring.size()];
+		area += static_cast<Int128>(a.x) * b.y - static_cast<Int128>(b.x) * a.y;
+	}
+	return area;
+}
+
+// Nearest integer to n / d, halves rounded up
+static int64_t roundDiv(Int128 n, Int128 d) {
+	if (d < 0) {
+		n = -n;
+		d = -d;
+	}
+	Int128 twice = 2 * n + d;
+	Int128 quotient = twice / (2 * d);
+	// Division truncates towards zero, rather than down
+	if (twice < 0 && quotient * 2 * d != twice) {
+		quotient--;
+	}
+	return static_cast<int64_t>(quotient);
+}
+
+// Whether segment ab meets the grid cell of c, the square of side 1 centred
+// on it, without its right and top sides so that every point lies in the
+// cell it rounds to
+static bool touches(const IntPoint &a, const IntPoint &b, const IntPoint &c) {
+	// Doubled, so the corners of the square are whole
+	IntPoint a2 { 2 * a.x, 2 * a.y };
+	IntPoint b2 { 2 * b.x, 2 * b.y };
+	if (std::min(a2.x, b2.x) >= 2 * c.x + 1 || std::max(a2.x, b2.x) < 2 * c.x - 1
+			|| std::min(a2.y, b2.y) >= 2 * c.y + 1
+			|| std::max(a2.y, b2.y) < 2 * c.y - 1) {
+		return false;
+	}
+	// Within the bounds, it misses only with every corner to one side. The
+	// open sides are pulled in by a vanishing step, which breaks ties.
+	int64_t dx = b2.x - a2.x;
+	int64_t dy = b2.y - a2.y;
+	int left = 0;
+	int right = 0;
+	for (int x = -1; x <= 1; x += 2) {
+		for (int y = -1; y <= 1; y += 2) {
+			Int128 side = cross(a2, b2, { 2 * c.x + x, 2 * c.y + y });
+			if (side == 0) {
+				side = (x > 0 ? dy : 0) - (y > 0 ? dx : 0);
+			}
+			left += side > 0;
+			right += side < 0;
+		}
+	}
+	return left < 4 && right < 4;
+}
+
+// Whether the point (x2 / 2, y2 / 2), on no edge of the ring, is inside it
+static bool contains(const IntRing &ring, int64_t x2, int64_t y2) {
+	bool inside = false;
+	for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+		const IntPoint &a = ring[i];
+		const IntPoint &b = ring[j];
+		if ((2 * a.y > y2) == (2 * b.y > y2)) {
+			continue;
+		}
+		// Whether the edge passes right of the point, scaled by its height
+		Int128 point = static_cast<Int128>(x2 - 2 * a.x) * (b.y - a.y);
+		Int128 edge = static_cast<Int128>(y2 - 2 * a.y) * (b.x - a.x);
+		if (b.y > a.y ? point < edge : point > edge) {
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+PolygonClipper::PolygonClipper() :
+		m_polarities { }, m_edges { } {
+}
+
+size_t PolygonClipper::AddLayer(Polarity polarity) {
+	m_polarities.push_back(polarity);
+	return m_polarities.size() - 1;
+}
+
+void PolygonClipper::AddPolygon(size_t layer, const IntRing &outer,
+		const std::vector<IntRing> &holes) {
+	addRing(layer, outer, false, false);
+	for (const IntRing &hole : holes) {
+		addRing(layer, hole, false, true);
+	}
+}
+
+void PolygonClipper::AddMask(size_t layer, const IntRing &outer,
+		const std::vector<IntRing> &holes) {
+	addRing(layer, outer, true, false);
+	for (const IntRing &hole : holes) {
+		addRing(layer, hole, true, true);
+	}
+}
+
+void PolygonClipper::addRing(size_t layer, const IntRing &ring, bool mask,
+		bool hole) {
+	if (layer >= m_polarities.size()) {
+		throw std::invalid_argument("unknown clipper layer");
+	}
+	for (const IntPoint &point : ring) {
+		if (point.x < -kMaxCoordinate || point.x > kMaxCoordinate
+				|| point.y < -kMaxCoordinate || point.y > kMaxCoordinate) {
+			throw std::invalid_argument("clipper coordinate out of range");
+		}
+	}
+	Int128 area = signedArea2(ring);
+	if (area == 0) {
+		return;
+	}
+	// Outer rings wind +1 and holes -1, whatever their input orientation
+	int sign = ((area > 0) != hole) ? 1 : -1;
+	for (size_t i = 0; i < ring.size(); i++) {
+		const IntPoint &a = ring[i];
+		const IntPoint &b = ring[(i + 1) % ring.size()];
+		if (a != b) {
+			m_edges.push_back( { a, b, sign, layer, mask });
+		}
+	}
+}
+
+std::vector<IntPolygon> PolygonClipper::Execute() const {
+	return assignHoles(chainRings(traceBoundary(snapRound(m_edges))));
+}
+
+std::vector<PolygonClipper::Edge> PolygonClipper::snapRound(
+		const std::vector<Edge> &edges) {
+	if (edges.empty()) {
+		return edges;
+	}
+	std::vector<IntPoint> pixels;
+	pixels.reserve(2 * edges.size());
+	for (const Edge &edge : edges) {
+		pixels.push_back(edge.start);
+		pixels.push_back(edge.end);
+	}
+
+	// Bent through every hot cell they pass, edges no longer cross. Later
+	// rounds only run while some piece was left passing a cell.
+	std::vector<Edge> current = edges;
+	std::vector<IntPoint> crossings = findCrossings(current);
+	for (int round = 0; round < MAX_SNAP_ROUNDS; round++) {
+		pixels.insert(pixels.end(), crossings.begin(), crossings.end());
+		std::sort(pixels.begin(), pixels.end());
+		pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+
+		// About as many bands as pixels in each, so an edge meets few
+		HotPixels hot { pixels.front().y, 0, { }, pixels };
+		uint64_t height = static_cast<uint64_t>(pixels.back().y - hot.bottom);
+		uint64_t bands = static_cast<uint64_t>(std::sqrt(pixels.size())) + 1;
+		while ((height >> hot.shift) >= bands) {
+			hot.shift++;
+		}
+		auto band = [&hot](const IntPoint &pixel) {
+			return static_cast<size_t>(
+					static_cast<uint64_t>(pixel.y - hot.bottom) >> hot.shift);
+		};
+		std::sort(hot.pixels.begin(), hot.pixels.end(),
+				[&band](const IntPoint &a, const IntPoint &b) {
+					size_t bandA = band(a);
+					size_t bandB = band(b);
+					return bandA < bandB || (bandA == bandB && a.x < b.x);
+				});
+		hot.starts.assign(band(pixels.back()) + 2, 0);
+		for (const IntPoint &pixel : hot.pixels) {
+			hot.starts[band(pixel) + 1]++;
+		}
+		for (size_t i = 1; i < hot.starts.size(); i++) {
+			hot.starts[i] += hot.starts[i - 1];
+		}
+
+		std::vector<Edge> pieces;
+		pieces.reserve(current.size());
+		bool passing = false;
+		for (const Edge &edge : current) {
+			passing |= route(edge, hot, pieces);
+		}
+		current.swap(pieces);
+		if (!passing) {
+			return current;
+		}
+		crossings = findCrossings(current);
+		if (crossings.empty()) {
+			return current;
+		}
+	}
+	throw std::logic_error("clipper crossings did not settle");
+}
+
+std::vector<IntPoint> PolygonClipper::findCrossings(
+		const std::vector<Edge> &edges) {
+	std::vector<Span> spans;
+	std::vector<Span> flats;
+	std::vector<int64_t> ys;
+	ys.reserve(2 * edges.size());
+	for (const Edge &edge : edges) {
+		Span span { std::min(edge.start, edge.end), std::max(edge.start,
+				edge.end) };
+		(span.lo.y == span.hi.y ? flats : spans).push_back(span);
+		ys.push_back(span.lo.y);
+		ys.push_back(span.hi.y);
+	}
+	auto lower = [](const Span &a, const Span &b) {
+		return a.lo < b.lo;
+	};
+	std::sort(spans.begin(), spans.end(), lower);
+	std::sort(flats.begin(), flats.end(), lower);
+	std::sort(ys.begin(), ys.end());
+	ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+	std::vector<IntPoint> crossings;
+	std::vector<Slot> slots;
+	std::vector<Slot> reordered;
+	size_t next = 0;
+	size_t nextFlat = 0;
+	for (size_t i = 0; i + 1 < ys.size(); i++) {
+		int64_t bottom = ys[i];
+		advance(spans, next, bottom, ys[i + 1], slots);
+
+		// Spans passing through one point of the slab bottom meet there,
+		// unless they lie along the same line
+		for (size_t first = 0, end; first < slots.size(); first = end) {
+			end = first + 1;
+			while (end < slots.size()
+					&& compare(slots[end].bottom, slots[first].bottom) == 0) {
+				end++;
+			}
+			const Span *passing = nullptr;
+			for (size_t j = first; j < end; j++) {
+				const Span &span = slots[j].span;
+				if (span.lo.y == bottom) {
+					continue;
+				}
+				if (passing == nullptr) {
+					passing = &span;
+				} else if (cross(passing->hi.x - passing->lo.x,
+						passing->hi.y - passing->lo.y, span.hi.x - span.lo.x,
+						span.hi.y - span.lo.y) != 0) {
+					crossings.push_back( { roundDiv(slots[first].bottom.num,
+							slots[first].bottom.den), bottom });
+					break;
+				}
+			}
+		}
+
+		// As do flat edges, and the spans passing between their ends
+		for (; nextFlat < flats.size() && flats[nextFlat].lo.y == bottom;
+				nextFlat++) {
+			const Span &flat = flats[nextFlat];
+			Position left { flat.lo.x, 1, static_cast<double>(flat.lo.x) };
+			Position right { flat.hi.x, 1, static_cast<double>(flat.hi.x) };
+			auto slot = std::partition_point(slots.begin(), slots.end(),
+					[&left](const Slot &slot) {
+						return compare(slot.bottom, left) <= 0;
+					});
+			for (; slot != slots.end() && compare(slot->bottom, right) < 0;
+					++slot) {
+				if (slot->span.lo.y < bottom) {
+					crossings.push_back( { roundDiv(slot->bottom.num,
+							slot->bottom.den), bottom });
+				}
+			}
+		}
+
+		// Spans that swap places between bottom and top cross in between,
+		// found as the adjacent swaps of an insertion sort on the top ends
+		if (std::is_sorted(slots.begin(), slots.end(),
+				[](const Slot &a, const Slot &b) {
+					return compare(a.top, b.top) < 0;
+				})) {
+			continue;
+		}
+		reordered = slots;
+		for (size_t j = 1; j < reordered.size(); j++) {
+			for (size_t k = j;
+					k > 0 && compare(reordered[k - 1].top, reordered[k].top) > 0;
+					k--) {
+				crossings.push_back(
+						intersection(reordered[k - 1].span,
+								reordered[k].span));
+				std::swap(reordered[k - 1], reordered[k]);
+			}
+		}
+		// In order along the top, which is nearly right for the next slab
+		slots.swap(reordered);
+	}
+	return crossings;
+}
+
+bool PolygonClipper::route(const Edge &edge, const HotPixels &hot,
+		std::vector<Edge> &pieces) {
+	std::vector<IntPoint> path { edge.start };
+	std::vector<IntPoint> enclosing;
+	bool passing = reroute(edge.start, edge.end, hot, path, enclosing);
+	for (size_t i = 0; i + 1 < path.size(); i++) {
+		pieces.push_back( { path[i], path[i + 1], edge.sign, edge.layer,
+				edge.mask });
+	}
+	return passing;
+}
+
+bool PolygonClipper::reroute(const IntPoint &a, const IntPoint &b,
+		const HotPixels &hot, std::vector<IntPoint> &path,
+		std::vector<IntPoint> &enclosing) {
+	// Neighbouring pixels can each touch the piece bent to the other, so a
+	// piece is not bent back through the ends of the pieces it was cut from.
+	// Every level adds a pixel, which ends the recursion, and a pixel met
+	// twice leaves a spur whose windings cancel.
+	std::vector<IntPoint> passed = passedPixels(a, b, hot);
+	size_t count = passed.size();
+	passed.erase(std::remove_if(passed.begin(), passed.end(),
+			[&enclosing](const IntPoint &pixel) {
+				return std::find(enclosing.begin(), enclosing.end(), pixel)
+						!= enclosing.end();
+			}), passed.end());
+	bool passing = passed.size() != count;
+	if (passed.empty()) {
+		path.push_back(b);
+		return passing;
+	}
+	int64_t dx = b.x - a.x;
+	int64_t dy = b.y - a.y;
+	std::sort(passed.begin(), passed.end(),
+			[&a, dx, dy](const IntPoint &p, const IntPoint &q) {
+				Int128 alongP = static_cast<Int128>(p.x - a.x) * dx
+						+ static_cast<Int128>(p.y - a.y) * dy;
+				Int128 alongQ = static_cast<Int128>(q.x - a.x) * dx
+						+ static_cast<Int128>(q.y - a.y) * dy;
+				return alongP < alongQ || (alongP == alongQ && p < q);
+			});
+	enclosing.push_back(a);
+	enclosing.push_back(b);
+	IntPoint from = a;
+	for (const IntPoint &pixel : passed) {
+		passing |= reroute(from, pixel, hot, path, enclosing);
+		from = pixel;
+	}
+	passing |= reroute(from, b, hot, path, enclosing);
+	enclosing.resize(enclosing.size() - 2);
+	return passing;
+}
+
+std::vector<IntPoint> PolygonClipper::passedPixels(const IntPoint &a,
+		const IntPoint &b, const HotPixels &hot) {
+	std::vector<IntPoint> passed;
+	int64_t bottom = std::min(a.y, b.y);
+	int64_t top = std::max(a.y, b.y);
+	size_t bands = hot.starts.size() - 1;
+	if (top + 1 < hot.bottom) {
+		return passed;
+	}
+	size_t first = static_cast<size_t>(static_cast<uint64_t>(std::max(
+			bottom - 1 - hot.bottom, int64_t(0))) >> hot.shift);
+	size_t last = std::min(bands - 1, static_cast<size_t>(
+			static_cast<uint64_t>(top + 1 - hot.bottom) >> hot.shift));
+	for (size_t index = first; index <= last; index++) {
+		// Where the segment runs within the band, in doubles, so candidates
+		// are taken a step wider and tested exactly
+		int64_t low = hot.bottom + (static_cast<int64_t>(index) << hot.shift);
+		int64_t high = low + (int64_t(1) << hot.shift) - 1;
+		double left = std::min(a.x, b.x);
+		double right = std::max(a.x, b.x);
+		if (a.y != b.y) {
+			double slope = static_cast<double>(b.x - a.x) / (b.y - a.y);
+			double y0 = std::max(static_cast<double>(bottom), low - 0.5);
+			double y1 = std::min(static_cast<double>(top), high + 0.5);
+			double x0 = a.x + slope * (y0 - a.y);
+			double x1 = a.x + slope * (y1 - a.y);
+			left = std::min(x0, x1);
+			right = std::max(x0, x1);
+		}
+		auto begin = hot.pixels.begin() + hot.starts[index];
+		auto end = hot.pixels.begin() + hot.starts[index + 1];
+		int64_t stop = static_cast<int64_t>(std::ceil(right)) + 1;
+		for (auto pixel = std::lower_bound(begin, end,
+				static_cast<int64_t>(std::floor(left)) - 1,
+				[](const IntPoint &pixel, int64_t x) {
+					return pixel.x < x;
+				}); pixel != end && pixel->x <= stop; ++pixel) {
+			if (*pixel != a && *pixel != b && touches(a, b, *pixel)) {
+				passed.push_back(*pixel);
+			}
+		}
+	}
+	return passed;
+}
+
+std::vector<PolygonClipper::DirectedEdge> PolygonClipper::traceBoundary(
+		const std::vector<Edge> &pieces) const {
+	// Coinciding pieces become one span adding up their windings, which
+	// cancel where a layer runs both ways. Flat pieces wind nothing.
+	struct Piece {
+		Span span;
+		Winding winding;
+	};
+	std::vector<Piece> sloped;
+	std::vector<Span> flats;
+	for (const Edge &edge : pieces) {
+		if (edge.start.y == edge.end.y) {
+			flats.push_back( { std::min(edge.start, edge.end), std::max(
+					edge.start, edge.end) });
+			continue;
+		}
+		// Left of a counter-clockwise ring, the edges point down
+		bool up = edge.start.y < edge.end.y;
+		sloped.push_back( { up ? Span { edge.start, edge.end } : Span {
+				edge.end, edge.start }, { edge.layer, edge.mask,
+				up ? -edge.sign : edge.sign } });
+	}
+	std::sort(sloped.begin(), sloped.end(), [](const Piece &a, const Piece &b) {
+		if (a.span.lo != b.span.lo) {
+			return a.span.lo < b.span.lo;
+		}
+		if (a.span.hi != b.span.hi) {
+			return a.span.hi < b.span.hi;
+		}
+		return a.winding.layer < b.winding.layer
+				|| (a.winding.layer == b.winding.layer
+						&& a.winding.mask < b.winding.mask);
+	});
+	std::sort(flats.begin(), flats.end(), [](const Span &a, const Span &b) {
+		return a.lo < b.lo || (a.lo == b.lo && a.hi < b.hi);
+	});
+	flats.erase(std::unique(flats.begin(), flats.end(),
+			[](const Span &a, const Span &b) {
+				return a.lo == b.lo && a.hi == b.hi;
+			}), flats.end());
+
+	// The windings of span i are windings[starts[i]] up to starts[i + 1],
+	// spans left winding nothing are dropped
+	std::vector<Span> spans;
+	std::vector<size_t> starts;
+	std::vector<Winding> windings;
+	for (size_t first = 0, end; first < sloped.size(); first = end) {
+		const Span &span = sloped[first].span;
+		size_t start = windings.size();
+		for (end = first;
+				end < sloped.size() && sloped[end].span.lo == span.lo
+						&& sloped[end].span.hi == span.hi; end++) {
+			const Winding &winding = sloped[end].winding;
+			if (windings.size() > start && windings.back().layer == winding.layer
+					&& windings.back().mask == winding.mask) {
+				windings.back().winding += winding.winding;
+			} else {
+				windings.push_back(winding);
+			}
+		}
+		windings.erase(std::remove_if(windings.begin() + start, windings.end(),
+				[](const Winding &winding) {
+					return winding.winding == 0;
+				}), windings.end());
+		if (windings.size() > start) {
+			spans.push_back(span);
+			starts.push_back(start);
+		}
+	}
+	starts.push_back(windings.size());
+
+	std::vector<int64_t> ys;
+	ys.reserve(2 * spans.size() + flats.size());
+	for (const Span &span : spans) {
+		ys.push_back(span.lo.y);
+		ys.push_back(span.hi.y);
+	}
+	for (const Span &flat : flats) {
+		ys.push_back(flat.lo.y);
+	}
+	std::sort(ys.begin(), ys.end());
+	ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+	// The topmost layer covering a point decides its colour, where a layer
+	// covers inside its polygons and outside its mask. Windings are back to
+	// zero at the end of every slab, as all rings are closed.
+	std::vector<DirectedEdge> boundary;
+	std::vector<int> layerWindings(m_polarities.size(), 0);
+	std::vector<int> maskWindings(m_polarities.size(), 0);
+	std::vector<size_t> covering;
+	std::vector<Slot> slots;
+	std::vector<Slot> below;
+	// Whether the gaps left of each slot, and right of the last, are dark
+	std::vector<bool> gaps;
+	std::vector<bool> belowGaps;
+	size_t next = 0;
+	size_t nextFlat = 0;
+	for (size_t i = 0; i < ys.size(); i++) {
+		int64_t y = ys[i];
+		bool slab = i + 1 < ys.size();
+		if (slab) {
+			advance(spans, next, y, ys[i + 1], slots);
+		} else {
+			slots.clear();
+		}
+
+		bool dark = false;
+		gaps.assign(1, false);
+		for (const Slot &slot : slots) {
+			bool wasDark = dark;
+			for (size_t k = starts[slot.index]; k < starts[slot.index + 1]; k++) {
+				const Winding &winding = windings[k];
+				int &layerWinding = layerWindings[winding.layer];
+				int &maskWinding = maskWindings[winding.layer];
+				bool wasCovering = layerWinding != 0 && maskWinding == 0;
+				(winding.mask ? maskWinding : layerWinding) += winding.winding;
+				bool isCovering = layerWinding != 0 && maskWinding == 0;
+				if (isCovering != wasCovering) {
+					auto position = std::lower_bound(covering.begin(),
+							covering.end(), winding.layer);
+					if (isCovering) {
+						covering.insert(position, winding.layer);
+					} else {
+						covering.erase(position);
+					}
+				}
+			}
+			dark = !covering.empty()
+					&& m_polarities[covering.back()] == Polarity::Dark;
+			gaps.push_back(dark);
+
+			// Nothing meets a span between its ends, so its colours hold all
+			// along it and it is traced in its first slab, dark on the left
+			const Span &span = slot.span;
+			if (span.lo.y == y && dark != wasDark) {
+				boundary.push_back(
+						wasDark ? DirectedEdge { span.lo, span.hi } :
+								DirectedEdge { span.hi, span.lo });
+			}
+		}
+		if (dark) {
+			throw std::logic_error("clipper rings are not closed");
+		}
+
+		// Flat edges divide the colours above and below them, found between
+		// the spans either side of their middle, which no span passes
+		for (; nextFlat < flats.size() && flats[nextFlat].lo.y == y;
+				nextFlat++) {
+			const Span &flat = flats[nextFlat];
+			Position middle { flat.lo.x + flat.hi.x, 2, 0.5
+					* static_cast<double>(flat.lo.x + flat.hi.x) };
+			auto above = std::partition_point(slots.begin(), slots.end(),
+					[&middle](const Slot &slot) {
+						return compare(slot.bottom, middle) < 0;
+					});
+			auto under = std::partition_point(below.begin(), below.end(),
+					[&middle](const Slot &slot) {
+						return compare(slot.top, middle) < 0;
+					});
+			bool darkAbove = slab && gaps[above - slots.begin()];
+			bool darkBelow = i > 0 && belowGaps[under - below.begin()];
+			if (darkAbove && !darkBelow) {
+				boundary.push_back( { flat.lo, flat.hi });
+			} else if (darkBelow && !darkAbove) {
+				boundary.push_back( { flat.hi, flat.lo });
+			}
+		}
+		// Kept only for flat edges along the top of this slab
+		if (slab && nextFlat < flats.size()
+				&& flats[nextFlat].lo.y == ys[i + 1]) {
+			below = slots;
+			belowGaps = gaps;
+		} else {
+			below.clear();
+			belowGaps.assign(1, false);
+		}
+	}
+	return boundary;
+}
+
+void PolygonClipper::advance(const std::vector<Span> &spans, size_t &next,
+		int64_t bottom, int64_t top, std::vector<Slot> &slots) {
+	slots.erase(std::remove_if(slots.begin(), slots.end(),
+			[bottom](const Slot &slot) {
+				return slot.span.hi.y <= bottom;
+			}), slots.end());
+	// The top of the slab below is this one's bottom
+	for (Slot &slot : slots) {
+		slot.bottom = slot.top;
+		slot.top = positionAt(slot.span, top);
+	}
+	for (; next < spans.size() && spans[next].lo.y == bottom; next++) {
+		const Span &span = spans[next];
+		slots.push_back( { next, span, positionAt(span, bottom), positionAt(
+				span, top) });
+	}
+	// Spans arrive in their order along the top of the slab below, which
+	// is nearly right, so an insertion sort restores it in close to linear
+	// time. Spans meeting at the bottom are ordered by the top.
+	for (size_t i = 1; i < slots.size(); i++) {
+		for (size_t j = i; j > 0; j--) {
+			int order = compare(slots[j - 1].bottom, slots[j].bottom);
+			if (order < 0
+					|| (order == 0
+							&& compare(slots[j - 1].top, slots[j].top) <= 0)) {
+				break;
+			}
+			std::swap(slots[j - 1], slots[j]);
+		}
+	}
+}
+
+PolygonClipper::Position PolygonClipper::positionAt(const Span &span,
+		int64_t y) {
+	int64_t height = span.hi.y - span.lo.y;
+	int64_t width = span.hi.x - span.lo.x;
+	return {static_cast<Int128>(span.lo.x) * height
+			+ static_cast<Int128>(y - span.lo.y) * width, height, span.lo.x
+			+ static_cast<double>(y - span.lo.y) * width / height};
+}
+
+int PolygonClipper::compare(const Position &a, const Position &b) {
+	if (a.x < b.x - POSITION_TOLERANCE) {
+		return -1;
+	}
+	if (a.x > b.x + POSITION_TOLERANCE) {
+		return 1;
+	}
+	Int128 left = a.num * b.den;
+	Int128 right = b.num * a.den;
+	return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+IntPoint PolygonClipper::intersection(const Span &a, const Span &b) {
+	// Along a by the ratio of the cross products, rounded to the grid
+	Int128 d = cross(a.hi.x - a.lo.x, a.hi.y - a.lo.y, b.hi.x - b.lo.x,
+			b.hi.y - b.lo.y);
+	Int128 n = cross(b.lo.x - a.lo.x, b.lo.y - a.lo.y, b.hi.x - b.lo.x,
+			b.hi.y - b.lo.y);
+	return {roundDiv(a.lo.x * d + n * (a.hi.x - a.lo.x), d),
+		roundDiv(a.lo.y * d + n * (a.hi.y - a.lo.y), d)};
+}
+
+bool PolygonClipper::sharperTurn(const DirectedEdge &in,
+		const DirectedEdge &a, const DirectedEdge &b) {
+	int64_t dx = in.end.x - in.start.x;
+	int64_t dy = in.end.y - in.start.y;
+	// Left turns, then straight on, right turns, and turning back last
+	auto rank = [dx, dy](const DirectedEdge &out) {
+		Int128 side = cross(dx, dy, out.end.x - out.start.x,
+				out.end.y - out.start.y);
+		if (side != 0) {
+			return side > 0 ? 3 : 1;
+		}
+		Int128 along = static_cast<Int128>(dx) * (out.end.x - out.start.x)
+				+ static_cast<Int128>(dy) * (out.end.y - out.start.y);
+		return along > 0 ? 2 : 0;
+	};
+	int rankA = rank(a);
+	int rankB = rank(b);
+	if (rankA != rankB) {
+		return rankA > rankB;
+	}
+	// Within a half plane, the sharper turn is counter-clockwise of the other
+	return (rankA == 3 || rankA == 1)
+			&& cross(b.end.x - b.start.x, b.end.y - b.start.y,
+					a.end.x - a.start.x, a.end.y - a.start.y) > 0;
+}
+
+std::vector<IntRing> PolygonClipper::chainRings(
+		const std::vector<DirectedEdge> &boundary) {
+	std::map<IntPoint, std::vector<size_t>> outgoing;
+	for (size_t i = 0; i < boundary.size(); i++) {
+		outgoing[boundary[i].start].push_back(i);
+	}
+
+	// Where rings touch at a vertex, taking the sharpest left turn keeps
+	// each ring around a single area
+	std::vector<IntRing> rings;
+	std::vector<bool> used(boundary.size(), false);
+	for (size_t first = 0; first < boundary.size(); first++) {
+		if (used[first]) {
+			continue;
+		}
+		used[first] = true;
+		IntRing ring { boundary[first].start };
+		size_t current = first;
+		while (true) {
+			const IntPoint &vertex = boundary[current].end;
+			bool closing = vertex == boundary[first].start;
+			size_t best = boundary.size();
+			if (closing) {
+				best = first;
+			}
+			auto candidates = outgoing.find(vertex);
+			if (candidates != outgoing.end()) {
+				for (size_t candidate : candidates->second) {
+					if (!used[candidate]
+							&& (best == boundary.size()
+									|| sharperTurn(boundary[current],
+											boundary[candidate],
+											boundary[best]))) {
+						best = candidate;
+					}
+				}
+			}
+			if (best == boundary.size()) {
+				throw std::logic_error("clipper boundary is not closed");
+			}
+			if (best == first) {
+				break;
+			}
+			used[best] = true;
+			ring.push_back(vertex);
+			current = best;
+		}
+		IntRing simple = simplifyRing(ring);
+		if (!simple.empty()) {
+			rings.push_back(simple);
+		}
+	}
+	return rings;
+}
+
+IntRing PolygonClipper::simplifyRing(const IntRing &ring) {
+	IntRing simple;
+	simple.reserve(ring.size());
+	for (const IntPoint &point : ring) {
+		simple.push_back(point);
+		while (simple.size() >= 3
+				&& cross(simple[simple.size() - 3], simple[simple.size() - 2],
+						simple.back()) == 0) {
+			simple.erase(simple.end() - 2);
+		}
+	}
+	// Collinear vertices may also remain where the ring wraps around
+	while (simple.size() >= 3) {
+		if (cross(simple[simple.size() - 2], simple.back(), simple.front())
+				== 0) {
+			simple.pop_back();
+		} else if (cross(simple.back(), simple[0], simple[1]) == 0) {
+			simple.erase(simple.begin());
+		} else {
+			break;
+		}
+	}
+	if (simple.size() < 3) {
+		simple.clear();
+	}
+	return simple;
+}
+
+std::vector<IntPolygon> PolygonClipper::assignHoles(
+		const std::vector<IntRing> &rings) {
+	struct Candidate {
+		size_t polygon;
+		Int128 area;
+		int64_t left;
+		int64_t right;
+		int64_t bottom;
+		int64_t top;
+	};
+	std::vector<IntPolygon> polygons;
+	std::vector<Candidate> outers;
+	std::vector<const IntRing*> holes;
+	for (const IntRing &ring : rings) {
+		Int128 area = signedArea2(ring);
+		if (area < 0) {
+			holes.push_back(&ring);
+			continue;
+		}
+		Candidate candidate { polygons.size(), area, ring[0].x, ring[0].x,
+				ring[0].y, ring[0].y };
+		for (const IntPoint &point : ring) {
+			candidate.left = std::min(candidate.left, point.x);
+			candidate.right = std::max(candidate.right, point.x);
+			candidate.bottom = std::min(candidate.bottom, point.y);
+			candidate.top = std::max(candidate.top, point.y);
+		}
+		outers.push_back(candidate);
+		polygons.push_back( { ring, { } });
+	}
+	std::sort(outers.begin(), outers.end(),
+			[](const Candidate &a, const Candidate &b) {
+				return a.area < b.area;
+			});
+
+	// Dark lies left of every boundary, and no other boundary passes the
+	// middle of a hole's edge, so the smallest outline around that point
+	// is the one around the hole
+	for (const IntRing *hole : holes) {
+		const IntPoint &a = (*hole)[0];
+		const IntPoint &b = (*hole)[1];
+		int64_t x2 = a.x + b.x;
+		int64_t y2 = a.y + b.y;
+		for (const Candidate &outer : outers) {
+			if (x2 < 2 * outer.left || x2 > 2 * outer.right
+					|| y2 < 2 * outer.bottom || y2 > 2 * outer.top) {
+				continue;
+			}
+			IntPolygon &polygon = polygons[outer.polygon];
+			if (contains(polygon.outer, x2, y2)) {
+				polygon.holes.push_back(*hole);
+				break;
+			}
+		}
+	}
+	return polygons;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,170 @@
+/*
+ * PolygonClipper.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLYGONCLIPPER_H_
+#define POLYGONCLIPPER_H_
+
+#include "GraphicalObject.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gerbex {
+
+// Products of grid coordinates overflow 64 bits
+__extension__ typedef __int128 Int128;
+
+struct IntPoint {
+	int64_t x;
+	int64_t y;
+	bool operator==(const IntPoint &rhs) const {
+		return x == rhs.x && y == rhs.y;
+	}
+	bool operator!=(const IntPoint &rhs) const {
+		return !(*this == rhs);
+	}
+	bool operator<(const IntPoint &rhs) const {
+		return y < rhs.y || (y == rhs.y && x < rhs.x);
+	}
+};
+
+typedef std::vector<IntPoint> IntRing;
+
+// Outer ring counter-clockwise, holes clockwise, first vertex not repeated
+struct IntPolygon {
+	IntRing outer;
+	std::vector<IntRing> holes;
+};
+
+/*
+ * Boolean engine for polygons on an integer grid, without dependencies.
+ * Layers are painted in the order they are added, each one covering or
+ * clearing the layers before it. A layer is the nonzero union of its
+ * polygons, less the union of its own mask polygons.
+ *
+ * Edges are first snap rounded: every crossing is rounded to the nearest
+ * grid point, and the grid cells around vertices and rounded crossings are
+ * hot. Each edge is bent through the centre of every hot cell it passes,
+ * and each bent piece again, until no piece passes a hot cell other than
+ * at its ends. Edges then only meet at grid points, so the colour on each
+ * side of an edge is the same all along it. A sweep in horizontal slabs
+ * finds those colours, resolving paint order left to right, and the edges
+ * with dark on one side only are chained into rings. Edges move by about
+ * half a grid step near crossings, and nowhere else.
+ *
+ * Every test is exact. Doubles only pick candidates or settle comparisons
+ * far from a tie, and 128 bit integer arithmetic decides the rest, which
+ * holds for coordinates up to kMaxCoordinate.
+ */
+class PolygonClipper {
+public:
+	static constexpr int64_t kMaxCoordinate = int64_t(1) << 40;
+
+	PolygonClipper();
+	virtual ~PolygonClipper() = default;
+	size_t AddLayer(Polarity polarity);
+	// Holes must lie inside the outer ring, either orientation is accepted
+	void AddPolygon(size_t layer, const IntRing &outer,
+			const std::vector<IntRing> &holes = { });
+	// Cut out of this layer only, not the layers painted before it
+	void AddMask(size_t layer, const IntRing &outer,
+			const std::vector<IntRing> &holes = { });
+	std::vector<IntPolygon> Execute() const;
+
+private:
+	struct Edge {
+		IntPoint start;
+		IntPoint end;
+		// 1 along outer rings and -1 along holes, when counter-clockwise
+		int sign;
+		size_t layer;
+		bool mask;
+	};
+	struct DirectedEdge {
+		IntPoint start;
+		IntPoint end;
+	};
+	// An edge without direction, lo before hi
+	struct Span {
+		IntPoint lo;
+		IntPoint hi;
+	};
+	// An x coordinate, num / den with den positive, and x close to it
+	struct Position {
+		Int128 num;
+		int64_t den;
+		double x;
+	};
+	// Where a span crosses the bottom and top of a slab, with the span at
+	// hand so a sweep reads the slots in order
+	struct Slot {
+		size_t index;
+		Span span;
+		Position bottom;
+		Position top;
+	};
+	// Grid points of the vertices and rounded crossings, in bands of rows
+	// 2^shift high from the bottom one, each band ordered by x
+	struct HotPixels {
+		int64_t bottom;
+		int shift;
+		// Where each band starts in pixels, and where the last ends
+		std::vector<size_t> starts;
+		std::vector<IntPoint> pixels;
+	};
+	// Winding a span adds to the polygons or mask of a layer
+	struct Winding {
+		size_t layer;
+		bool mask;
+		int winding;
+	};
+
+	void addRing(size_t layer, const IntRing &ring, bool mask, bool hole);
+	static std::vector<Edge> snapRound(const std::vector<Edge> &edges);
+	static std::vector<IntPoint> findCrossings(const std::vector<Edge> &edges);
+	// Both tell whether a piece was left passing a hot cell
+	static bool route(const Edge &edge, const HotPixels &hot,
+			std::vector<Edge> &pieces);
+	static bool reroute(const IntPoint &a, const IntPoint &b,
+			const HotPixels &hot, std::vector<IntPoint> &path,
+			std::vector<IntPoint> &enclosing);
+	static std::vector<IntPoint> passedPixels(const IntPoint &a,
+			const IntPoint &b, const HotPixels &hot);
+	std::vector<DirectedEdge> traceBoundary(
+			const std::vector<Edge> &pieces) const;
+	static void advance(const std::vector<Span> &spans, size_t &next,
+			int64_t bottom, int64_t top, std::vector<Slot> &slots);
+	static Position positionAt(const Span &span, int64_t y);
+	static int compare(const Position &a, const Position &b);
+	static IntPoint intersection(const Span &a, const Span &b);
+	static bool sharperTurn(const DirectedEdge &in, const DirectedEdge &a,
+			const DirectedEdge &b);
+	static std::vector<IntRing> chainRings(
+			const std::vector<DirectedEdge> &boundary);
+	static IntRing simplifyRing(const IntRing &ring);
+	static std::vector<IntPolygon> assignHoles(
+			const std::vector<IntRing> &rings);
+	std::vector<Polarity> m_polarities;
+	std::vector<Edge> m_edges;
+};
+
+} /* namespace gerbex */
+
+#endif /* POLYGONCLIPPER_H_ */
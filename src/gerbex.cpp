@@ -19,100 +19,1098 @@
  */
 
 #include "CgalSerializer.h"
+#include "ClipperSerializer.h"
 #include "FileProcessor.h"
+#include "ImageWriter.h"
+#include "Instrument.h"
+#include "MacroCache.h"
+#include "NetIndex.h"
+#include "RasterDiff.h"
+#include "RasterSerializer.h"
+#include "Stats.h"
 #include "SvgSerializer.h"
+#include "ThreadPool.h"
+#include "Thumbnail.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 //TODO use an arg lib
 
 using namespace gerbex;
 
+const int SVG_VIEWPORT_SIZE = 1000;
+
+// Pixels along the longer side when no pixel size is given
+const int RASTER_DEFAULT_SIZE = 2000;
+
+// Input or output path naming standard input or output
+const std::string STDIO_PATH = "-";
+
+// A served client idle for longer than this is dropped
+const int SERVE_TIMEOUT_SECONDS = 30;
+
+// Largest request line, and Gerber, a served client may send
+const size_t SERVE_MAX_LINE = 65536;
+const size_t SERVE_MAX_REQUEST = 256 * 1024 * 1024;
+
+// Job layers without a colour take the next of these
+const std::vector<std::string> LAYER_COLORS = { "#b87333", "#2e8b57",
+		"#f0f0f0", "#4169e1", "#daa520", "#c71585" };
+
 enum class GerbexMode {
-	Svg, Cgal
+	Svg, Cgal, Clipper, Raster, Diff, Thumbnail, Job, Serve
 };
 
-int main(int argc, char *argv[]) {
-	std::cout << "Gerbex" << std::endl;
+struct Layer {
+	std::vector<std::shared_ptr<GraphicalObject>> objects;
+	Box box;
+	std::shared_ptr<const NetIndex> nets;
+};
 
-	if (argc < 3) {
-		std::cerr << "Usage: gerbex svg|cgal <gbr_file> [<out_file>]"
-				<< std::endl;
-		return EXIT_FAILURE;
-	}
+struct JobLayer {
+	std::filesystem::path path;
+	std::string color;
+	double opacity;
+};
 
-	GerbexMode mode;
-	std::string modeStr = argv[1];
-	std::string fileExt;
+struct Options {
+	std::optional<unsigned int> threads;
+	bool lod = false;
+	std::string kernel = "epec";
+	unsigned int tiles = 1;
+	double tolerance = Tessellator::kDefaultTolerance;
+	std::optional<double> pixelSize;
+	unsigned int tileSize = RasterSerializer::kDefaultTileSize;
+	unsigned int stripHeight = RasterSerializer::kDefaultStripHeight;
+	int thumbnailSize = Thumbnail::kDefaultSize;
+	std::filesystem::path outDir;
+	unsigned int jobs = 0;
+	// Extension naming the output format, when not given by the output file
+	std::string format;
+	// Stats report written after converting, table or json
+	std::string stats;
+	// Only objects on this net and of this component are converted, when set
+	std::string net;
+	std::string component;
+	// Stream written for an output of -
+	std::ostream *piped = &std::cout;
+	// Macros and tessellated shapes shared between conversions, when set
+	MacroCache *macros = nullptr;
+	std::shared_ptr<ShapeCache> shapes;
+};
+
+template<typename K>
+std::unique_ptr<Serializer> makeCgalSerializer(unsigned int tiles,
+		unsigned int threads, double tolerance,
+		std::shared_ptr<ShapeCache> shapes) {
+	std::unique_ptr<CgalSerializer<K>> cgalSerializer = std::make_unique<
+			CgalSerializer<K>>();
+	cgalSerializer->SetShapeCache(shapes);
+	cgalSerializer->SetTiling(tiles, threads);
+	cgalSerializer->SetTolerance(tolerance);
+	return cgalSerializer;
+}
+
+std::optional<GerbexMode> parseMode(const std::string &modeStr,
+		std::string &fileExt) {
 	if (modeStr == "svg") {
-		mode = GerbexMode::Svg;
 		fileExt = ".svg";
+		return GerbexMode::Svg;
 	} else if (modeStr == "cgal") {
-		mode = GerbexMode::Cgal;
 		fileExt = ".vtu";
-	} else {
-		std::cerr << "unrecognized mode " << modeStr << std::endl;
-		return EXIT_FAILURE;
+		return GerbexMode::Cgal;
+	} else if (modeStr == "clipper") {
+		fileExt = ".vtu";
+		return GerbexMode::Clipper;
+	} else if (modeStr == "raster") {
+		fileExt = ".png";
+		return GerbexMode::Raster;
+	} else if (modeStr == "thumbnail") {
+		fileExt = ".png";
+		return GerbexMode::Thumbnail;
+	} else if (modeStr == "diff") {
+		return GerbexMode::Diff;
+	} else if (modeStr == "job") {
+		fileExt = ".svg";
+		return GerbexMode::Job;
+	} else if (modeStr == "serve") {
+		return GerbexMode::Serve;
+	}
+	return std::nullopt;
+}
+
+Layer readLayer(std::istream &gerber, Stats *stats = nullptr,
+		MacroCache *macros = nullptr) {
+	FileProcessor fileProcessor;
+	fileProcessor.SetStats(stats);
+	fileProcessor.GetProcessor().SetMacroCache(macros);
+	fileProcessor.Process(gerber);
+	Instrument::Scope scope(Instrument::Subsystem::Box);
+	Stats::Clock::time_point start = Stats::Clock::now();
+	Box box = fileProcessor.GetProcessor().GetBox();
+	if (stats) {
+		stats->AddTime("box", start);
 	}
+	return {fileProcessor.GetProcessor().GetObjects(), box,
+		fileProcessor.GetProcessor().GetNetIndex()};
+}
 
-	std::filesystem::path gbr_file = argv[2];
-	std::filesystem::path out_file;
-	if (argc > 3) {
-		out_file = argv[3];
-	} else {
-		out_file = gbr_file.stem();
-		out_file += fileExt;
+Layer processLayer(const std::filesystem::path &path, Stats *stats = nullptr) {
+	if (path == STDIO_PATH) {
+		// Read whole, std::cin stays synced with C stdio, which is slow a
+		// character at a time but not in bulk
+		std::ostringstream buffer;
+		buffer << std::cin.rdbuf();
+		std::istringstream gerber(buffer.str());
+		return readLayer(gerber, stats);
+	}
+	std::ifstream gerber = std::ifstream(path, std::ifstream::in);
+	if (!gerber.good()) {
+		throw std::invalid_argument("failed to open " + path.string());
 	}
+	return readLayer(gerber, stats);
+}
 
-	if (std::filesystem::exists(out_file)) {
-		std::cerr << "output file already exists: " << out_file << std::endl;
-		return EXIT_FAILURE;
+// The output named, else the input's name in the output format. Standard
+// input goes to standard output.
+std::filesystem::path outputPath(const std::vector<std::string> &positional,
+		const std::string &format) {
+	if (positional.size() > 1) {
+		return positional[1];
+	}
+	if (positional[0] == STDIO_PATH) {
+		return STDIO_PATH;
 	}
+	std::filesystem::path out_file = std::filesystem::path(positional[0]).stem();
+	out_file += format;
+	return out_file;
+}
 
-	std::ifstream gerber = std::ifstream(gbr_file, std::ifstream::in);
-	if (!gerber.good()) {
-		std::cerr << "failed to open file" << std::endl;
-		return EXIT_FAILURE;
+// Writes to out_file, or to the piped stream in the options' format
+template<typename Output>
+void saveOutput(Output &output, const std::filesystem::path &out_file,
+		const Options &options, Stats *stats) {
+	Instrument::Scope scope(Instrument::Subsystem::Save);
+	Stats::Clock::time_point start = Stats::Clock::now();
+	if (out_file == STDIO_PATH) {
+		output.Save(*options.piped, options.format);
+		options.piped->flush();
+	} else {
+		output.SaveFile(out_file);
 	}
+	if (stats) {
+		stats->AddTime("save", start);
+	}
+}
 
-	FileProcessor fileProcessor;
-	fileProcessor.Process(gerber);
-	Box box = fileProcessor.GetProcessor().GetBox();
-	std::cout << "Dimensions: " << box << std::endl;
+// The objects on the options' net and of their component, found from the
+// layer's index, or null to take every object
+std::unique_ptr<std::vector<std::shared_ptr<GraphicalObject>>> selectObjects(
+		const Layer &layer, const Options &options) {
+	if (options.net.empty() && options.component.empty()) {
+		return nullptr;
+	}
+	std::vector<ObjectRange> ranges;
+	if (!options.net.empty() && !options.component.empty()) {
+		ranges = NetIndex::Intersect(layer.nets->GetNet(options.net),
+				layer.nets->GetComponent(options.component));
+	} else if (!options.net.empty()) {
+		ranges = layer.nets->GetNet(options.net);
+	} else {
+		ranges = layer.nets->GetComponent(options.component);
+	}
+	return std::make_unique<std::vector<std::shared_ptr<GraphicalObject>>>(
+			NetIndex::Select(layer.objects, ranges));
+}
 
+// Serializes one layer to out_file, noting image sizes to log and phase
+// times to stats when given
+void convertLayer(GerbexMode mode, const Options &options, const Layer &layer,
+		const std::filesystem::path &out_file, std::ostream &log,
+		Stats *stats = nullptr) {
+	Instrument::Scope scope(Instrument::Subsystem::Serialize);
+	Stats::Clock::time_point start = Stats::Clock::now();
+	std::unique_ptr<std::vector<std::shared_ptr<GraphicalObject>>> selected =
+			selectObjects(layer, options);
+	const std::vector<std::shared_ptr<GraphicalObject>> &objects =
+			selected ? *selected : layer.objects;
+	if (selected) {
+		log << "Selected: " << objects.size() << " of "
+				<< layer.objects.size() << " objects" << std::endl;
+	}
 	std::unique_ptr<Serializer> serializer;
 	switch (mode) {
 	case GerbexMode::Svg: {
+		Box viewBox = layer.box.Pad(0.5);
 		std::unique_ptr<SvgSerializer> svgSerializer = std::make_unique<
-				SvgSerializer>(box.Pad(0.5));
-		svgSerializer->SetViewPort(1000, 1000);
+				SvgSerializer>(viewBox);
+		svgSerializer->SetViewPort(SVG_VIEWPORT_SIZE, SVG_VIEWPORT_SIZE);
+		if (options.lod) {
+			svgSerializer->SetPixelSize(
+					std::max(viewBox.GetWidth(), viewBox.GetHeight())
+							/ SVG_VIEWPORT_SIZE);
+		}
 		svgSerializer->SetForeground("red");
 		svgSerializer->SetBackground("black");
+		if (options.threads.has_value()) {
+			svgSerializer->SerializeParallel(objects, *options.threads);
+			if (stats) {
+				stats->AddTime("serialize", start);
+			}
+			saveOutput(*svgSerializer, out_file, options, stats);
+			return;
+		}
 		serializer = std::move(svgSerializer);
 		break;
 	}
 	case GerbexMode::Cgal: {
-		std::unique_ptr<CgalSerializer> cgalSerializer = std::make_unique<
-				CgalSerializer>();
-		serializer = std::move(cgalSerializer);
+		unsigned int tileThreads = options.threads.value_or(0);
+		if (options.kernel == "epick") {
+			serializer = makeCgalSerializer<Epick>(options.tiles, tileThreads,
+					options.tolerance, options.shapes);
+		} else if (options.kernel == "epec") {
+			serializer = makeCgalSerializer<Epec>(options.tiles, tileThreads,
+					options.tolerance, options.shapes);
+		} else if (options.kernel == "grid") {
+			serializer = makeCgalSerializer<GridKernel>(options.tiles,
+					tileThreads, options.tolerance, options.shapes);
+		} else {
+			throw std::invalid_argument("unrecognized kernel " + options.kernel);
+		}
+		break;
+	}
+	case GerbexMode::Clipper: {
+		std::unique_ptr<ClipperSerializer> clipperSerializer =
+				std::make_unique<ClipperSerializer>();
+		clipperSerializer->SetTolerance(options.tolerance);
+		clipperSerializer->SetShapeCache(options.shapes);
+		serializer = std::move(clipperSerializer);
 		break;
 	}
+	case GerbexMode::Raster: {
+		Box viewBox = layer.box.Pad(0.5);
+		std::unique_ptr<RasterSerializer> rasterSerializer = std::make_unique<
+				RasterSerializer>(viewBox,
+				options.pixelSize.value_or(
+						std::max(viewBox.GetWidth(), viewBox.GetHeight())
+								/ RASTER_DEFAULT_SIZE));
+		rasterSerializer->SetTiling(options.tileSize,
+				options.threads.value_or(0));
+		rasterSerializer->SetStripHeight(options.stripHeight);
+		log << "Image: " << rasterSerializer->GetWidth() << " x "
+				<< rasterSerializer->GetHeight() << std::endl;
+		serializer = std::move(rasterSerializer);
+		break;
+	}
+	case GerbexMode::Thumbnail: {
+		Thumbnail thumbnail(layer.box.Pad(0.5), options.thumbnailSize);
+		thumbnail.Add(objects);
+		if (stats) {
+			stats->AddTime("serialize", start);
+		}
+		saveOutput(thumbnail, out_file, options, stats);
+		log << "Image: " << thumbnail.GetWidth() << " x "
+				<< thumbnail.GetHeight() << std::endl;
+		return;
+	}
 	default:
-		std::cerr << "unrecognized mode" << std::endl;
-		return EXIT_FAILURE;
+		throw std::invalid_argument("unrecognized mode");
 	}
 
-	std::vector<std::shared_ptr<GraphicalObject>> objects =
-			fileProcessor.GetProcessor().GetObjects();
-
 	for (std::shared_ptr<GraphicalObject> obj : objects) {
 		obj->Serialize(*serializer, Point());
 	}
+	if (stats) {
+		stats->AddTime("serialize", start);
+	}
+
+	saveOutput(*serializer, out_file, options, stats);
+}
+
+int diffLayers(const std::vector<std::string> &positional,
+		const Options &options) {
+	std::filesystem::path out_file;
+	if (positional[0] == STDIO_PATH && positional[1] == STDIO_PATH) {
+		std::cerr << "only one input may be standard input" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (positional.size() > 2) {
+		out_file = positional[2];
+		if (std::filesystem::exists(out_file)) {
+			std::cerr << "output file already exists: " << out_file
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Both files are read at once, then rendered onto one grid covering both
+	std::future<Layer> beforeLayer = std::async(std::launch::async,
+			processLayer, std::filesystem::path(positional[0]), nullptr);
+	std::future<Layer> afterLayer = std::async(std::launch::async,
+			processLayer, std::filesystem::path(positional[1]), nullptr);
+	Layer before = beforeLayer.get();
+	Layer after = afterLayer.get();
+
+	Box viewBox = before.box.Extend(after.box).Pad(0.5);
+	double pixel = options.pixelSize.value_or(
+			std::max(viewBox.GetWidth(), viewBox.GetHeight())
+					/ RASTER_DEFAULT_SIZE);
+	RasterSerializer beforeImage(viewBox, pixel);
+	RasterSerializer afterImage(viewBox, pixel);
+	for (std::shared_ptr<GraphicalObject> obj : before.objects) {
+		obj->Serialize(beforeImage, Point());
+	}
+	for (std::shared_ptr<GraphicalObject> obj : after.objects) {
+		obj->Serialize(afterImage, Point());
+	}
+	std::cout << "Image: " << beforeImage.GetWidth() << " x "
+			<< beforeImage.GetHeight() << std::endl;
+
+	RasterDiff diff(beforeImage, afterImage, options.threads.value_or(0));
+	if (out_file.empty()) {
+		diff.Compare();
+	} else {
+		std::ofstream stream(out_file, std::ios::binary);
+		ImageWriter writer(stream, ImageWriter::FormatFromPath(out_file));
+		writer.Begin(beforeImage.GetWidth(), beforeImage.GetHeight());
+		diff.Compare([&writer](const uint8_t *pixels, int rows) {
+			writer.WriteRows(pixels, rows);
+		});
+		writer.End();
+	}
+
+	std::cout << "Changed: " << diff.GetChangedPixels() << " pixels, area "
+			<< diff.GetChangedPixels() * pixel * pixel << std::endl;
+	for (const PixelRect &rect : diff.GetRegions()) {
+		Box region(rect.width * pixel, rect.height * pixel,
+				viewBox.GetLeft() + rect.left * pixel,
+				viewBox.GetTop() - (rect.top + rect.height) * pixel);
+		std::cout << "Region: " << region << std::endl;
+	}
+	return diff.GetChangedPixels() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Gerber files named, and those directly inside directories named
+std::vector<std::filesystem::path> collectFiles(
+		const std::vector<std::string> &inputs) {
+	std::vector<std::filesystem::path> files;
+	for (const std::string &input : inputs) {
+		std::filesystem::path path = input;
+		if (std::filesystem::is_directory(path)) {
+			std::vector<std::filesystem::path> found;
+			for (const auto &entry : std::filesystem::directory_iterator(path)) {
+				if (entry.path().extension() == ".gbr") {
+					found.push_back(entry.path());
+				}
+			}
+			std::sort(found.begin(), found.end());
+			files.insert(files.end(), found.begin(), found.end());
+		} else {
+			files.push_back(path);
+		}
+	}
+	return files;
+}
+
+int batchLayers(GerbexMode mode, Options options,
+		const std::vector<std::string> &inputs) {
+	std::vector<std::filesystem::path> files = collectFiles(inputs);
+	if (files.empty()) {
+		std::cerr << "no input files" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!options.outDir.empty()) {
+		std::filesystem::create_directories(options.outDir);
+	}
+	// Files already run side by side, so each keeps to one thread unless told
+	if (!options.threads.has_value()) {
+		options.threads = 1;
+	}
+
+	// Checked before any work starts, tasks never race for an output
+	std::vector<std::filesystem::path> outFiles;
+	std::map<std::filesystem::path, std::filesystem::path> sources;
+	for (const std::filesystem::path &file : files) {
+		std::filesystem::path out_file = options.outDir / file.stem();
+		out_file += options.format;
+		out_file = out_file.lexically_normal();
+		auto source = sources.emplace(out_file, file);
+		if (!source.second) {
+			std::cerr << "both " << source.first->second.string() << " and "
+					<< file.string() << " would write " << out_file.string()
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+		if (std::filesystem::exists(out_file)) {
+			std::cerr << "output file already exists: " << out_file.string()
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+		outFiles.push_back(out_file);
+	}
+
+	struct Result {
+		size_t objects = 0;
+		double readMs = 0.0;
+		double writeMs = 0.0;
+		std::string error;
+	};
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::future<Result>> results;
+	// Only as many layers as jobs are ever held in memory
+	ThreadPool pool(options.jobs);
+	for (size_t i = 0; i < files.size(); i++) {
+		std::filesystem::path file = files[i];
+		std::filesystem::path out_file = outFiles[i];
+		results.push_back(pool.Submit([mode, &options, file, out_file]() {
+			Result result;
+			try {
+				auto readStart = std::chrono::steady_clock::now();
+				Layer layer = processLayer(file);
+				auto writeStart = std::chrono::steady_clock::now();
+				std::ostringstream log;
+				convertLayer(mode, options, layer, out_file, log);
+				auto end = std::chrono::steady_clock::now();
+				result.objects = layer.objects.size();
+				result.readMs = std::chrono::duration<double, std::milli>(
+						writeStart - readStart).count();
+				result.writeMs = std::chrono::duration<double, std::milli>(
+						end - writeStart).count();
+			} catch (const std::exception &ex) {
+				result.error = ex.what();
+			}
+			return result;
+		}));
+	}
+
+	int failures = 0;
+	for (size_t i = 0; i < files.size(); i++) {
+		Result result = results[i].get();
+		std::cout << files[i].filename().string() << ": ";
+		if (!result.error.empty()) {
+			std::cout << "failed: " << result.error << std::endl;
+			failures++;
+			continue;
+		}
+		std::cout << result.objects << " objects, read " << std::fixed
+				<< std::setprecision(1) << result.readMs << " ms, write "
+				<< result.writeMs << " ms" << std::endl;
+	}
+	std::chrono::duration<double, std::milli> total =
+			std::chrono::steady_clock::now() - start;
+	std::cout << "Converted " << files.size() - failures << " of "
+			<< files.size() << " files in " << std::fixed
+			<< std::setprecision(1) << total.count() << " ms, "
+			<< pool.GetThreadCount() << " at a time" << std::endl;
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// One layer per line, bottom first, as: <gbr_file> [<colour> [<opacity>]]
+// Files may be quoted and are relative to the job file, lines starting
+// with # are comments
+std::vector<JobLayer> readJob(const std::filesystem::path &path) {
+	std::ifstream job(path);
+	if (!job.good()) {
+		throw std::invalid_argument("failed to open " + path.string());
+	}
+	std::vector<JobLayer> layers;
+	std::string line;
+	for (int lineNumber = 1; std::getline(job, line); lineNumber++) {
+		std::istringstream fields(line);
+		std::string file;
+		if (!(fields >> std::ws) || fields.peek() == '#'
+				|| !(fields >> std::quoted(file))) {
+			continue;
+		}
+		JobLayer layer { path.parent_path() / file, LAYER_COLORS[layers.size()
+				% LAYER_COLORS.size()], 1.0 };
+		std::string color;
+		if (fields >> color) {
+			layer.color = color;
+		}
+		if (!(fields >> std::ws).eof()
+				&& (!(fields >> layer.opacity) || layer.opacity < 0.0
+						|| layer.opacity > 1.0)) {
+			throw std::invalid_argument(
+					"opacity must be from 0 to 1 on line "
+							+ std::to_string(lineNumber));
+		}
+		layers.push_back(layer);
+	}
+	return layers;
+}
+
+int jobLayers(const std::filesystem::path &jobFile,
+		const std::filesystem::path &out_file, const Options &options,
+		std::ostream &log) {
+	if (out_file != STDIO_PATH && std::filesystem::exists(out_file)) {
+		std::cerr << "output file already exists: " << out_file << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<JobLayer> entries;
+	try {
+		entries = readJob(jobFile);
+	} catch (const std::invalid_argument &ex) {
+		std::cerr << ex.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (entries.empty()) {
+		std::cerr << "no layers in " << jobFile << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Every file is read once, even when listed for more than one layer
+	std::vector<std::shared_future<Layer>> processed;
+	{
+		ThreadPool pool(options.threads.value_or(0));
+		std::vector<std::filesystem::path> files;
+		for (const JobLayer &jobLayer : entries) {
+			auto found = std::find(files.begin(), files.end(), jobLayer.path);
+			if (found != files.end()) {
+				processed.push_back(processed[found - files.begin()]);
+				files.push_back(jobLayer.path);
+				continue;
+			}
+			std::filesystem::path file = jobLayer.path;
+			processed.push_back(pool.Submit([file]() {
+				return processLayer(file);
+			}).share());
+			files.push_back(file);
+		}
+	}
+	Box box = processed.front().get().box;
+	for (const std::shared_future<Layer> &layer : processed) {
+		box = box.Extend(layer.get().box);
+	}
+	Box viewBox = box.Pad(0.5);
+	log << "Dimensions: " << box << std::endl;
+
+	SvgSerializer svgSerializer(viewBox);
+	svgSerializer.SetViewPort(SVG_VIEWPORT_SIZE, SVG_VIEWPORT_SIZE);
+	if (options.lod) {
+		svgSerializer.SetPixelSize(
+				std::max(viewBox.GetWidth(), viewBox.GetHeight())
+						/ SVG_VIEWPORT_SIZE);
+	}
+	svgSerializer.SetBackground("black");
+	for (size_t i = 0; i < entries.size(); i++) {
+		const JobLayer &jobLayer = entries[i];
+		svgSerializer.AddLayer(jobLayer.path.filename().string(),
+				processed[i].get().objects, jobLayer.color, jobLayer.opacity,
+				options.threads.value_or(0));
+	}
+	saveOutput(svgSerializer, out_file, options, nullptr);
+	return EXIT_SUCCESS;
+}
+
+unsigned long parseCount(const std::string &arg, const std::string &value) {
+	// std::stoul accepts a sign, and wraps a negative value around
+	if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+		throw std::invalid_argument("invalid value for " + arg);
+	}
+	try {
+		return std::stoul(value);
+	} catch (const std::logic_error&) {
+		throw std::invalid_argument("invalid value for " + arg);
+	}
+}
+
+double parseNumber(const std::string &arg, const std::string &value) {
+	try {
+		return std::stod(value);
+	} catch (const std::logic_error&) {
+		throw std::invalid_argument("invalid value for " + arg);
+	}
+}
+
+// Reads options into options and the rest into positional, throwing on an
+// unrecognized or malformed option. The output format defaults to fileExt.
+void parseArgs(const std::vector<std::string> &args,
+		const std::string &fileExt, Options &options,
+		std::vector<std::string> &positional) {
+	for (size_t i = 0; i < args.size(); i++) {
+		const std::string &arg = args[i];
+		bool hasValue = i + 1 < args.size();
+		if (arg == "--threads" && hasValue) {
+			options.threads = parseCount(arg, args[++i]);
+		} else if (arg == "--lod") {
+			options.lod = true;
+		} else if (arg == "--kernel" && hasValue) {
+			options.kernel = args[++i];
+		} else if (arg == "--tiles" && hasValue) {
+			options.tiles = parseCount(arg, args[++i]);
+		} else if (arg == "--tolerance" && hasValue) {
+			options.tolerance = parseNumber(arg, args[++i]);
+		} else if (arg == "--pixel" && hasValue) {
+			options.pixelSize = parseNumber(arg, args[++i]);
+		} else if (arg == "--tile" && hasValue) {
+			options.tileSize = parseCount(arg, args[++i]);
+		} else if (arg == "--strip" && hasValue) {
+			options.stripHeight = parseCount(arg, args[++i]);
+		} else if (arg == "--size" && hasValue) {
+			options.thumbnailSize = parseCount(arg, args[++i]);
+		} else if (arg == "--out" && hasValue) {
+			options.outDir = args[++i];
+		} else if (arg == "--jobs" && hasValue) {
+			options.jobs = parseCount(arg, args[++i]);
+		} else if (arg == "--format" && hasValue) {
+			options.format = args[++i];
+		} else if (arg == "--stats" && hasValue) {
+			options.stats = args[++i];
+		} else if (arg == "--net" && hasValue) {
+			options.net = args[++i];
+		} else if (arg == "--component" && hasValue) {
+			options.component = args[++i];
+		} else if (arg.rfind("--", 0) == 0) {
+			throw std::invalid_argument("unrecognized option " + arg);
+		} else {
+			positional.push_back(arg);
+		}
+	}
+
+	if (options.kernel != "epick" && options.kernel != "epec"
+			&& options.kernel != "grid") {
+		throw std::invalid_argument("unrecognized kernel " + options.kernel);
+	}
+	if (!options.stats.empty() && options.stats != "table"
+			&& options.stats != "json") {
+		throw std::invalid_argument(
+				"unrecognized stats format " + options.stats);
+	}
+	if (options.format.empty()) {
+		options.format = fileExt;
+	} else if (options.format[0] != '.') {
+		options.format.insert(0, ".");
+	}
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Appends what arrives on fd to data until the peer stops writing, or only
+// until data holds a newline when untilLine is set. Throws once data would
+// exceed maxSize, or on a read error or timeout.
+void readSocket(int fd, std::string &data, bool untilLine, size_t maxSize) {
+	char buffer[65536];
+	while (!untilLine || data.find('\n') == std::string::npos) {
+		ssize_t count = read(fd, buffer, sizeof(buffer));
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+		if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			throw std::invalid_argument("timed out");
+		}
+		if (count < 0) {
+			throw std::invalid_argument(
+					"failed to read: " + std::string(std::strerror(errno)));
+		}
+		if (count == 0) {
+			break;
+		}
+		if (data.size() + count > maxSize) {
+			throw std::invalid_argument(
+					"request larger than " + std::to_string(maxSize)
+							+ " bytes");
+		}
+		data.append(buffer, count);
+	}
+}
+
+bool writeSocket(int fd, const std::string &data) {
+	size_t written = 0;
+	while (written < data.size()) {
+		ssize_t count = write(fd, data.data() + written, data.size() - written);
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+		if (count < 0) {
+			return false;
+		}
+		written += count;
+	}
+	return true;
+}
+
+// Runs the one request a client sends, as a line of
+// <mode> [options] <gbr_file|-> [<out_file|->], with the Gerber following
+// the line when read from -. Replies ok <out_file>, or ok <size> and the
+// output when written to -, else error <message>.
+void serveJob(int client, const Options &defaults, std::mutex &logMutex) {
+	auto start = std::chrono::steady_clock::now();
+	std::string request;
+	std::string reply;
+	try {
+		std::string data;
+		readSocket(client, data, true, SERVE_MAX_LINE);
+		size_t newline = data.find('\n');
+		if (newline == std::string::npos) {
+			throw std::invalid_argument("request must end in a newline");
+		}
+		request = data.substr(0, newline);
+		data.erase(0, newline + 1);
+
+		std::istringstream line(request);
+		std::vector<std::string> words;
+		std::string word;
+		while (line >> std::quoted(word)) {
+			words.push_back(word);
+		}
+		if (words.empty()) {
+			throw std::invalid_argument("empty request");
+		}
+		std::string fileExt;
+		std::optional<GerbexMode> mode = parseMode(words[0], fileExt);
+		if (!mode.has_value() || *mode == GerbexMode::Diff
+				|| *mode == GerbexMode::Job || *mode == GerbexMode::Serve) {
+			throw std::invalid_argument("unrecognized mode " + words[0]);
+		}
+		Options options = defaults;
+		std::vector<std::string> positional;
+		parseArgs(std::vector<std::string>(words.begin() + 1, words.end()),
+				fileExt, options, positional);
+		// A client may not take more than the machine, or all of it
+		unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+		if (options.threads.value_or(1) == 0 || *options.threads > cores) {
+			options.threads = cores;
+		}
+		if (positional.empty() || positional.size() > 2) {
+			throw std::invalid_argument(
+					"expected <gbr_file|-> [<out_file|->]");
+		}
+		std::filesystem::path out_file = outputPath(positional,
+				options.format);
+		if (out_file != STDIO_PATH && std::filesystem::exists(out_file)) {
+			throw std::invalid_argument(
+					"output file already exists: " + out_file.string());
+		}
+
+		Layer layer;
+		if (positional[0] == STDIO_PATH) {
+			readSocket(client, data, false, SERVE_MAX_REQUEST);
+			std::istringstream gerber(data);
+			data.clear();
+			layer = readLayer(gerber, nullptr, options.macros);
+		} else {
+			std::ifstream gerber(positional[0], std::ifstream::in);
+			if (!gerber.good()) {
+				throw std::invalid_argument("failed to open " + positional[0]);
+			}
+			layer = readLayer(gerber, nullptr, options.macros);
+		}
+
+		std::ostringstream output;
+		std::ostringstream log;
+		options.piped = &output;
+		convertLayer(*mode, options, layer, out_file, log);
+		if (out_file == STDIO_PATH) {
+			std::string bytes = output.str();
+			reply = "ok " + std::to_string(bytes.size()) + "\n" + bytes;
+		} else {
+			reply = "ok " + out_file.string() + "\n";
+		}
+	} catch (const std::exception &ex) {
+		reply = "error " + std::string(ex.what()) + "\n";
+	}
+	bool sent = writeSocket(client, reply);
+
+	std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+	std::lock_guard<std::mutex> lock(logMutex);
+	std::cout << request << ": " << reply.substr(0, reply.find('\n'))
+			<< (sent ? "" : ", not sent") << ", " << std::fixed
+			<< std::setprecision(1) << elapsed.count() << " ms" << std::endl;
+}
+#endif
+
+// Converts the requests of each client connecting to a Unix domain socket
+// at socketPath, a pool of jobs at a time. Macro templates and aperture
+// outlines are kept between requests, so repeated definitions are compiled
+// and tessellated once.
+int serveJobs(const std::filesystem::path &socketPath, Options options) {
+#if defined(__unix__) || defined(__APPLE__)
+	sockaddr_un address { };
+	address.sun_family = AF_UNIX;
+	std::string name = socketPath.string();
+	if (name.size() >= sizeof(address.sun_path)) {
+		std::cerr << "socket path too long: " << socketPath << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server < 0) {
+		std::cerr << "failed to create socket: " << std::strerror(errno)
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	// A socket left by a server that is no longer running is replaced
+	std::error_code error;
+	if (std::filesystem::is_socket(socketPath, error)) {
+		if (connect(server, reinterpret_cast<sockaddr*>(&address),
+				sizeof(address)) == 0) {
+			std::cerr << "already serving on " << socketPath << std::endl;
+			close(server);
+			return EXIT_FAILURE;
+		}
+		close(server);
+		std::filesystem::remove(socketPath, error);
+		server = socket(AF_UNIX, SOCK_STREAM, 0);
+	} else if (std::filesystem::exists(socketPath, error)) {
+		std::cerr << "file already exists: " << socketPath << std::endl;
+		close(server);
+		return EXIT_FAILURE;
+	}
+	// Only the owner may connect, as requests name any file it can write.
+	// Created so, which leaves no window for others as chmod would.
+	mode_t mask = umask(S_IRWXG | S_IRWXO);
+	bool bound = server >= 0
+			&& bind(server, reinterpret_cast<sockaddr*>(&address),
+					sizeof(address)) == 0;
+	umask(mask);
+	if (!bound || listen(server, SOMAXCONN) < 0) {
+		std::cerr << "failed to listen on " << socketPath << ": "
+				<< std::strerror(errno) << std::endl;
+		if (server >= 0) {
+			close(server);
+		}
+		return EXIT_FAILURE;
+	}
+	// A client leaving early fails its write rather than ending the server
+	std::signal(SIGPIPE, SIG_IGN);
 
-	serializer->SaveFile(out_file);
+	MacroCache macros;
+	options.macros = &macros;
+	options.shapes = std::make_shared<ShapeCache>(options.tolerance);
+	// Jobs already run side by side, so each keeps to one thread unless told
+	if (!options.threads.has_value()) {
+		options.threads = 1;
+	}
+	std::mutex logMutex;
+	ThreadPool pool(options.jobs);
+	std::cout << "Serving on " << socketPath << ", " << pool.GetThreadCount()
+			<< " jobs at a time" << std::endl;
+	while (true) {
+		int client = accept(server, nullptr, nullptr);
+		if (client < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			std::cerr << "failed to accept: " << std::strerror(errno)
+					<< std::endl;
+			break;
+		}
+		timeval timeout { SERVE_TIMEOUT_SECONDS, 0 };
+		setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+		pool.Submit([client, &options, &logMutex]() {
+			serveJob(client, options, logMutex);
+			close(client);
+		});
+	}
+	close(server);
+	return EXIT_FAILURE;
+#else
+	(void) socketPath;
+	(void) options;
+	std::cerr << "serve needs Unix domain sockets" << std::endl;
+	return EXIT_FAILURE;
+#endif
+}
+
+void printUsage() {
+	std::cerr << "Usage: gerbex svg|cgal|clipper|raster|thumbnail [options]"
+			<< " <gbr_file>"
+			<< " [<out_file>]" << std::endl;
+	std::cerr << "       gerbex diff [options] <gbr_file> <gbr_file>"
+			<< " [<out_file>]" << std::endl;
+	std::cerr << "       gerbex batch <mode> [options] <gbr_file_or_dir>..."
+			<< std::endl;
+	std::cerr << "       gerbex job [options] <job_file> [<out_file>]"
+			<< std::endl;
+	std::cerr << "       gerbex serve [options] <socket>" << std::endl;
+	std::cerr << "cgal and clipper write .vtu (default), .wkt or .geojson"
+			<< " by extension" << std::endl;
+	std::cerr << "raster writes .png (default), .pgm or 1 bit .pbm by extension,"
+			<< " thumbnail .png (default) or .pgm" << std::endl;
+	std::cerr << "diff exits 1 when the files differ, writing removed, added"
+			<< " and unchanged pixels to an optional image" << std::endl;
+	std::cerr << "- reads standard input or writes standard output, logging to"
+			<< " standard error" << std::endl;
+	std::cerr << "job stacks one SVG layer per line of <gbr_file> [<colour>"
+			<< " [<opacity>]], bottom first" << std::endl;
+	std::cerr << "serve takes one request per connection, a line of <mode>"
+			<< " [options] <gbr_file|-> [<out_file|->], and replies ok <out_file>,"
+			<< " ok <size> and the output for -, or error <message>. The socket"
+			<< " is its owner's alone, and idle clients are dropped after "
+			<< SERVE_TIMEOUT_SECONDS << " s" << std::endl;
+	std::cerr << "Options:" << std::endl;
+	std::cerr << "  --threads <n>   serialize SVG, flatten CGAL, render raster tiles"
+			<< " or diff strips on n threads, 0 for all cores" << std::endl;
+	std::cerr << "  --lod           simplify SVG detail below one pixel"
+			<< std::endl;
+	std::cerr << "  --kernel <k>    CGAL kernel: epick, epec (default) or grid"
+			<< std::endl;
+	std::cerr << "  --tiles <n>     flatten CGAL on a grid of n x n tiles"
+			<< std::endl;
+	std::cerr << "  --tolerance <t> maximum arc chord error, in file units"
+			<< std::endl;
+	std::cerr << "  --pixel <size>  raster or diff pixel size, in file units"
+			<< std::endl;
+	std::cerr << "  --tile <n>      render raster tiles of n x n pixels"
+			<< std::endl;
+	std::cerr << "  --strip <n>     hold n rows at once when writing .pbm"
+			<< std::endl;
+	std::cerr << "  --size <n>      thumbnail pixels along the longer side"
+			<< std::endl;
+	std::cerr << "  --out <dir>     batch output directory" << std::endl;
+	std::cerr << "  --jobs <n>      batch or serve files converted at once, 0 for all"
+			<< " cores" << std::endl;
+	std::cerr << "  --format <ext>  output format when not named by the output"
+			<< " file, such as wkt" << std::endl;
+	std::cerr << "  --stats <fmt>   report time per phase and counts as table or"
+			<< " json, converting one file" << std::endl;
+	std::cerr << "  --net <name>    convert only objects on the net, from their"
+			<< " .N attribute" << std::endl;
+	std::cerr << "  --component <c> convert only objects of the component, from"
+			<< " their .C attribute" << std::endl;
 }
 
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	bool batch = std::string(argv[1]) == "batch";
+	int firstArg = batch ? 3 : 2;
+	if (argc <= firstArg) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::string modeStr = argv[batch ? 2 : 1];
+	std::string fileExt;
+	std::optional<GerbexMode> mode = parseMode(modeStr, fileExt);
+	if (!mode.has_value()
+			|| (batch
+					&& (*mode == GerbexMode::Diff || *mode == GerbexMode::Job
+							|| *mode == GerbexMode::Serve))) {
+		std::cerr << "unrecognized mode " << modeStr << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> positional;
+	Options options;
+	try {
+		parseArgs(std::vector<std::string>(argv + firstArg, argv + argc),
+				fileExt, options, positional);
+	} catch (const std::invalid_argument &ex) {
+		std::cerr << ex.what() << std::endl;
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::filesystem::path out_file;
+	if (!batch && *mode != GerbexMode::Diff && *mode != GerbexMode::Serve
+			&& !positional.empty()) {
+		out_file = outputPath(positional, options.format);
+	}
+	// Keep standard output for the result when it goes there
+	std::ostream &log = out_file == STDIO_PATH ? std::cerr : std::cout;
+	log << "Gerbex" << std::endl;
+
+	if (batch) {
+		if (positional.empty()) {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+		return batchLayers(*mode, options, positional);
+	}
+	if (*mode == GerbexMode::Serve) {
+		if (positional.size() != 1) {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+		return serveJobs(positional[0], options);
+	}
+	if (*mode == GerbexMode::Job) {
+		if (positional.empty() || positional.size() > 2) {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+		return jobLayers(positional[0], out_file, options, log);
+	}
+	if (*mode == GerbexMode::Diff) {
+		if (positional.size() < 2 || positional.size() > 3) {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+		return diffLayers(positional, options);
+	}
+	if (positional.empty() || positional.size() > 2) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::filesystem::path gbr_file = positional[0];
+	if (out_file != STDIO_PATH && std::filesystem::exists(out_file)) {
+		std::cerr << "output file already exists: " << out_file << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Stats stats;
+	Stats *keptStats = options.stats.empty() ? nullptr : &stats;
+	Layer layer;
+	try {
+		layer = processLayer(gbr_file, keptStats);
+	} catch (const std::invalid_argument &ex) {
+		std::cerr << ex.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	log << "Dimensions: " << layer.box << std::endl;
+
+	try {
+		convertLayer(*mode, options, layer, out_file, log, keptStats);
+	} catch (const std::invalid_argument &ex) {
+		std::cerr << ex.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	// Empty unless built with GERBEX_INSTRUMENT
+	if (keptStats) {
+		for (const auto &count : Instrument::GetCounts()) {
+			stats.Count(count.first, count.second);
+		}
+	}
+	if (options.stats == "table") {
+		stats.WriteTable(log);
+	} else if (options.stats == "json") {
+		stats.WriteJson(log);
+	}
+	return EXIT_SUCCESS;
+}
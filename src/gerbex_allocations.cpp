@@ -0,0 +1,49 @@
+/*
+ * gerbex_allocations.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replaces operator new to count every allocation of the gerbex executable
+ * by subsystem, when built with GERBEX_INSTRUMENT. Only the executable links
+ * this, the test runner has its own replacement.
+ */
+
+#ifdef GERBEX_INSTRUMENT
+
+#include "Instrument.h"
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t size) {
+	gerbex::Instrument::AddAllocation(size);
+	if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+#endif
@@ -0,0 +1,555 @@
+/*
+ * gerbex_generate.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Writes a synthetic Gerber board for scale testing, with every feature
+ * that stresses the reader and serializers in one file: flashes across
+ * many apertures, long track chains, large regions with arcs, nested
+ * block apertures, a step and repeat panel, a library of macro pads and
+ * frequent polarity changes. The same seed and options always give the
+ * same file, on any platform, so benchmark inputs are reproducible.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Coordinates are written in mm with 6 decimals
+const double UNITS_PER_MM = 1e6;
+
+// First standard aperture number, macro pads and blocks follow
+const int FIRST_APERTURE = 10;
+
+// Macro pads defined per macro, each with its own parameters
+const int PADS_PER_MACRO = 4;
+
+const double PI = 3.14159265358979323846;
+
+struct Options {
+	uint64_t seed = 1;
+	// Board edge, in mm
+	double size = 300.0;
+	// Multiplies every count
+	double scale = 1.0;
+	uint64_t flashes = 1000000;
+	uint64_t apertures = 200;
+	uint64_t segments = 200000;
+	uint64_t chain = 1000;
+	uint64_t regions = 100;
+	uint64_t vertices = 2000;
+	uint64_t depth = 6;
+	uint64_t panel = 20;
+	uint64_t macros = 50;
+	uint64_t pads = 100000;
+	uint64_t toggles = 1000;
+};
+
+/*
+ * Uniform numbers from a 64 bit Mersenne Twister, whose sequence the
+ * standard fixes. The standard distributions are left to each library, so
+ * they are not used.
+ */
+class Random {
+public:
+	Random(uint64_t seed) :
+			m_engine { seed } {
+	}
+
+	// From lo up to but excluding hi
+	double Uniform(double lo, double hi) {
+		return lo + (m_engine() >> 11) * 0x1.0p-53 * (hi - lo);
+	}
+
+	// From 0 up to but excluding n
+	uint64_t Index(uint64_t n) {
+		return m_engine() % n;
+	}
+
+	bool Chance(double probability) {
+		return Uniform(0.0, 1.0) < probability;
+	}
+
+private:
+	std::mt19937_64 m_engine;
+};
+
+/*
+ * Writes objects, changing polarity every so many of them. Standard
+ * apertures are numbered from FIRST_APERTURE, round ones first.
+ */
+class Writer {
+public:
+	Writer(std::ostream &out, const Options &options) :
+			m_out { out }, m_options { options }, m_random { options.seed }, m_objects {
+					0 }, m_toggleEvery { 0 }, m_clear { false }, m_aperture {
+					-1 }, m_plotState { 0 } {
+		uint64_t total = options.flashes + options.segments + options.regions
+				+ options.pads;
+		if (options.toggles > 0) {
+			m_toggleEvery = std::max<uint64_t>(1, total / options.toggles);
+		}
+	}
+
+	std::ostream& Out() {
+		return m_out;
+	}
+
+	Random& GetRandom() {
+		return m_random;
+	}
+
+	// Counts one object, changing polarity when it is due
+	void Object() {
+		if (m_toggleEvery > 0 && ++m_objects % m_toggleEvery == 0) {
+			SetPolarity(!m_clear);
+		}
+	}
+
+	void SetPolarity(bool clear) {
+		m_clear = clear;
+		m_out << (clear ? "%LPC*%\n" : "%LPD*%\n");
+	}
+
+	void SelectAperture(int ident) {
+		if (ident != m_aperture) {
+			m_out << "D" << ident << "*\n";
+			m_aperture = ident;
+		}
+	}
+
+	// Forgets the aperture and plot state, as a block or panel was opened
+	void Reset() {
+		m_aperture = -1;
+		m_plotState = 0;
+	}
+
+	void PlotState(int state) {
+		if (state != m_plotState) {
+			m_out << "G0" << state << "*\n";
+			m_plotState = state;
+		}
+	}
+
+	void Move(double x, double y) {
+		m_out << "X" << Coord(x) << "Y" << Coord(y) << "D02*\n";
+	}
+
+	void Line(double x, double y) {
+		PlotState(1);
+		m_out << "X" << Coord(x) << "Y" << Coord(y) << "D01*\n";
+	}
+
+	// Counter-clockwise unless clockwise, around an offset from the start
+	void Arc(double x, double y, double i, double j, bool clockwise) {
+		PlotState(clockwise ? 2 : 3);
+		m_out << "X" << Coord(x) << "Y" << Coord(y) << "I" << Coord(i) << "J"
+				<< Coord(j) << "D01*\n";
+	}
+
+	void Flash(double x, double y) {
+		m_out << "X" << Coord(x) << "Y" << Coord(y) << "D03*\n";
+	}
+
+	static long long Coord(double mm) {
+		return std::llround(mm * UNITS_PER_MM);
+	}
+
+	int RoundApertures() const {
+		return std::max<int>(1, m_options.apertures / 2);
+	}
+
+private:
+	std::ostream &m_out;
+	const Options &m_options;
+	Random m_random;
+	uint64_t m_objects;
+	uint64_t m_toggleEvery;
+	bool m_clear;
+	int m_aperture;
+	int m_plotState;
+};
+
+// Round apertures first, for tracks, then rectangles, obrounds and polygons
+void writeApertures(Writer &writer, const Options &options) {
+	Random &random = writer.GetRandom();
+	int round = writer.RoundApertures();
+	for (uint64_t i = 0; i < options.apertures; i++) {
+		int ident = FIRST_APERTURE + i;
+		double a = random.Uniform(0.1, 2.0);
+		double b = random.Uniform(0.1, 2.0);
+		writer.Out() << "%ADD" << ident;
+		if (int(i) < round) {
+			writer.Out() << "C," << a;
+		} else if (i % 3 == 0) {
+			writer.Out() << "R," << a << "X" << b;
+		} else if (i % 3 == 1) {
+			writer.Out() << "O," << a << "X" << b;
+		} else {
+			writer.Out() << "P," << a << "X" << 3 + i % 6 << "X"
+					<< random.Uniform(0.0, 90.0);
+		}
+		// Every seventh has a hole
+		if (i % 7 == 0) {
+			writer.Out() << "X" << std::min(a, b) * 0.4;
+		}
+		writer.Out() << "*%\n";
+	}
+}
+
+// Macros of each primitive type, with expressions and variables, and
+// PADS_PER_MACRO pads of each
+void writeMacros(Writer &writer, const Options &options, int firstPad) {
+	Random &random = writer.GetRandom();
+	for (uint64_t i = 0; i < options.macros; i++) {
+		std::ostream &out = writer.Out();
+		out << "%AMPAD" << i << "*\n0 Generated pad " << i << "*\n";
+		switch (i % 5) {
+		case 0:
+			// Rounded rectangle of width $1, height $2 and corner radius $3
+			out << "$4=$1-$3x2*\n$5=$2-$3x2*\n"
+					<< "21,1,$4,$2,0,0,0*\n21,1,$1,$5,0,0,0*\n"
+					<< "1,1,$3x2,$4/2,$5/2*\n1,1,$3x2,-$4/2,$5/2*\n"
+					<< "1,1,$3x2,-$4/2,-$5/2*\n1,1,$3x2,$4/2,-$5/2*\n";
+			break;
+		case 1:
+			// Thermal of outer diameter $1, inner $2, gap $3
+			out << "7,0,0,$1,$2,$3,45*\n";
+			break;
+		case 2: {
+			// Star of size $1, rotated by $2
+			int points = 5 + i % 4;
+			out << "4,1," << points * 2;
+			for (int p = 0; p <= points * 2; p++) {
+				double angle = PI * p / points;
+				double radius = p % 2 == 0 ? 0.5 : 0.2;
+				out << "," << radius * std::cos(angle) << "x$1,"
+						<< radius * std::sin(angle) << "x$1";
+			}
+			out << ",$2*\n";
+			break;
+		}
+		case 3:
+			// Polygon of diameter $1 with a cleared centre of $2
+			out << "5,1," << 3 + i % 10 << ",0,0,$1,0*\n1,0,$2,0,0*\n";
+			break;
+		default:
+			// Cross of vector lines $1 long and $2 wide
+			out << "20,1,$2,-$1/2,0,$1/2,0,0*\n20,1,$2,0,-$1/2,0,$1/2,0*\n";
+			break;
+		}
+		out << "%\n";
+		for (int p = 0; p < PADS_PER_MACRO; p++) {
+			double size = random.Uniform(0.5, 2.5);
+			out << "%ADD" << firstPad + i * PADS_PER_MACRO + p << "PAD" << i
+					<< "," << size << "X" << size * random.Uniform(0.2, 0.35)
+					<< "X" << size * 0.1 << "*%\n";
+		}
+	}
+}
+
+// Runs of flashes of one aperture at a time, anywhere on the board
+void writeFlashes(Writer &writer, const Options &options, uint64_t count,
+		int first, int apertures) {
+	Random &random = writer.GetRandom();
+	for (uint64_t i = 0; i < count;) {
+		writer.SelectAperture(first + random.Index(apertures));
+		uint64_t run = std::min<uint64_t>(count - i, 1 + random.Index(50));
+		double x = random.Uniform(0.0, options.size);
+		double y = random.Uniform(0.0, options.size);
+		for (uint64_t r = 0; r < run; r++, i++) {
+			writer.Object();
+			writer.Flash(x + r * 1.27, y);
+		}
+	}
+}
+
+// Chains of segments walking across the board, one in eight an arc
+void writeTracks(Writer &writer, const Options &options) {
+	Random &random = writer.GetRandom();
+	uint64_t chain = std::max<uint64_t>(1, options.chain);
+	for (uint64_t i = 0; i < options.segments;) {
+		writer.SelectAperture(
+				FIRST_APERTURE + random.Index(writer.RoundApertures()));
+		double x = random.Uniform(0.0, options.size);
+		double y = random.Uniform(0.0, options.size);
+		writer.Move(x, y);
+		double heading = random.Uniform(0.0, 2.0 * PI);
+		for (uint64_t s = 0; s < chain && i < options.segments; s++, i++) {
+			writer.Object();
+			heading += random.Uniform(-0.8, 0.8);
+			double step = random.Uniform(0.2, 3.0);
+			double nx = std::clamp(x + step * std::cos(heading), 0.0,
+					options.size);
+			double ny = std::clamp(y + step * std::sin(heading), 0.0,
+					options.size);
+			if (random.Chance(0.125)) {
+				// Turn about a centre beside the track, keeping the radius
+				double radius = random.Uniform(0.5, 3.0);
+				bool clockwise = random.Chance(0.5);
+				double side = heading + (clockwise ? -PI / 2 : PI / 2);
+				double cx = x + radius * std::cos(side);
+				double cy = y + radius * std::sin(side);
+				double sweep = random.Uniform(0.3, 2.5);
+				double start = std::atan2(y - cy, x - cx);
+				double end = clockwise ? start - sweep : start + sweep;
+				nx = cx + radius * std::cos(end);
+				ny = cy + radius * std::sin(end);
+				writer.Arc(nx, ny, cx - x, cy - y, clockwise);
+				heading += clockwise ? -sweep : sweep;
+			} else {
+				writer.Line(nx, ny);
+			}
+			x = nx;
+			y = ny;
+		}
+	}
+}
+
+// Large star shaped regions, runs of their edges arcs about the centre
+void writeRegions(Writer &writer, const Options &options) {
+	Random &random = writer.GetRandom();
+	uint64_t vertices = std::max<uint64_t>(3, options.vertices);
+	for (uint64_t i = 0; i < options.regions; i++) {
+		writer.Object();
+		double cx = random.Uniform(0.0, options.size);
+		double cy = random.Uniform(0.0, options.size);
+		double base = random.Uniform(5.0, options.size / 10.0);
+		writer.Out() << "G36*\n";
+		double radius = base;
+		double startX = cx + radius;
+		double startY = cy;
+		writer.Move(startX, startY);
+		double x = startX;
+		double y = startY;
+		for (uint64_t v = 1; v < vertices; v++) {
+			double angle = 2.0 * PI * v / vertices;
+			if (random.Chance(0.3)) {
+				double nx = cx + radius * std::cos(angle);
+				double ny = cy + radius * std::sin(angle);
+				writer.Arc(nx, ny, cx - x, cy - y, false);
+				x = nx;
+				y = ny;
+			} else {
+				radius = base * random.Uniform(0.6, 1.0);
+				x = cx + radius * std::cos(angle);
+				y = cy + radius * std::sin(angle);
+				writer.Line(x, y);
+			}
+		}
+		writer.Line(startX, startY);
+		writer.Out() << "G37*\n";
+	}
+}
+
+// Block ident holds two flashes of the block nested in it, down to depth
+// levels, the innermost a few flashes, so it expands to 2^depth of those
+void writeBlock(Writer &writer, int ident, uint64_t level, uint64_t depth) {
+	writer.Out() << "%ABD" << ident << "*%\n";
+	writer.Reset();
+	if (level + 1 < depth) {
+		writeBlock(writer, ident + 1, level + 1, depth);
+		writer.Reset();
+		writer.SelectAperture(ident + 1);
+		double offset = 2.0 * std::pow(2.0, (depth - level) / 2.0);
+		writer.Flash(0.0, 0.0);
+		writer.Flash(level % 2 == 0 ? offset : 0.0,
+				level % 2 == 0 ? 0.0 : offset);
+	} else {
+		writer.SelectAperture(FIRST_APERTURE);
+		writer.Flash(0.0, 0.0);
+		writer.Flash(1.0, 0.0);
+		writer.Flash(0.5, 1.0);
+	}
+	writer.Out() << "%AB*%\n";
+	writer.Reset();
+}
+
+// A board of panel x panel copies of some flashes and a track
+void writePanel(Writer &writer, const Options &options, int firstPad) {
+	Random &random = writer.GetRandom();
+	double pitch = options.size / options.panel;
+	writer.Out() << "%SRX" << options.panel << "Y" << options.panel << "I"
+			<< pitch << "J" << pitch << "*%\n";
+	writer.Reset();
+	for (int i = 0; i < 20; i++) {
+		writer.SelectAperture(
+				options.macros > 0 && i % 2 == 0 ?
+						firstPad + random.Index(options.macros * PADS_PER_MACRO) :
+						FIRST_APERTURE + random.Index(options.apertures));
+		writer.Flash(random.Uniform(0.0, pitch), random.Uniform(0.0, pitch));
+	}
+	writer.SelectAperture(FIRST_APERTURE);
+	writer.Move(0.1 * pitch, 0.1 * pitch);
+	writer.Line(0.9 * pitch, 0.1 * pitch);
+	writer.Line(0.9 * pitch, 0.9 * pitch);
+	writer.Out() << "%SR*%\n";
+	writer.Reset();
+}
+
+void generate(std::ostream &out, const Options &options) {
+	Writer writer(out, options);
+	out << "G04 Generated by gerbex_generate, seed " << options.seed
+			<< "*\n%FSLAX36Y36*%\n%MOMM*%\n";
+	out.precision(6);
+	out << std::fixed;
+	writeApertures(writer, options);
+	int firstPad = FIRST_APERTURE + options.apertures;
+	writeMacros(writer, options, firstPad);
+	int firstBlock = firstPad + options.macros * PADS_PER_MACRO;
+	if (options.depth > 0) {
+		writeBlock(writer, firstBlock, 0, options.depth);
+	}
+	writer.SetPolarity(false);
+	out << "G75*\n";
+
+	writeFlashes(writer, options, options.flashes, FIRST_APERTURE,
+			options.apertures);
+	if (options.macros > 0) {
+		writeFlashes(writer, options, options.pads, firstPad,
+				options.macros * PADS_PER_MACRO);
+	}
+	writeTracks(writer, options);
+	writeRegions(writer, options);
+	writer.SetPolarity(false);
+	if (options.depth > 0) {
+		writer.SelectAperture(firstBlock);
+		for (int i = 0; i < 4; i++) {
+			writer.Flash(options.size * (0.2 + 0.2 * i), options.size * 0.5);
+		}
+	}
+	if (options.panel > 0) {
+		writePanel(writer, options, firstPad);
+	}
+	out << "M02*\n";
+}
+
+void printUsage() {
+	Options defaults;
+	std::cerr << "Usage: gerbex_generate [options] <out_file|->" << std::endl;
+	std::cerr << "Options, counts before scaling:" << std::endl;
+	std::cerr << "  --seed <n>      random seed, default " << defaults.seed
+			<< std::endl;
+	std::cerr << "  --size <mm>     board edge, default " << defaults.size
+			<< std::endl;
+	std::cerr << "  --scale <f>     multiply every count by f" << std::endl;
+	std::cerr << "  --flashes <n>   standard aperture flashes, default "
+			<< defaults.flashes << std::endl;
+	std::cerr << "  --apertures <n> standard apertures, default "
+			<< defaults.apertures << std::endl;
+	std::cerr << "  --segments <n>  track segments, default "
+			<< defaults.segments << std::endl;
+	std::cerr << "  --chain <n>     segments per track chain, default "
+			<< defaults.chain << std::endl;
+	std::cerr << "  --regions <n>   regions, default " << defaults.regions
+			<< std::endl;
+	std::cerr << "  --vertices <n>  vertices per region, default "
+			<< defaults.vertices << std::endl;
+	std::cerr << "  --depth <n>     nested block aperture levels, default "
+			<< defaults.depth << std::endl;
+	std::cerr << "  --panel <n>     step and repeat n x n copies, default "
+			<< defaults.panel << std::endl;
+	std::cerr << "  --macros <n>    macros, " << PADS_PER_MACRO
+			<< " pads each, default " << defaults.macros << std::endl;
+	std::cerr << "  --pads <n>      macro pad flashes, default " << defaults.pads
+			<< std::endl;
+	std::cerr << "  --toggles <n>   polarity changes, default "
+			<< defaults.toggles << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	std::vector<std::string> positional;
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (arg == "--seed" && hasValue) {
+				options.seed = std::stoull(argv[++i]);
+			} else if (arg == "--size" && hasValue) {
+				options.size = std::stod(argv[++i]);
+			} else if (arg == "--scale" && hasValue) {
+				options.scale = std::stod(argv[++i]);
+			} else if (arg == "--flashes" && hasValue) {
+				options.flashes = std::stoull(argv[++i]);
+			} else if (arg == "--apertures" && hasValue) {
+				options.apertures = std::stoull(argv[++i]);
+			} else if (arg == "--segments" && hasValue) {
+				options.segments = std::stoull(argv[++i]);
+			} else if (arg == "--chain" && hasValue) {
+				options.chain = std::stoull(argv[++i]);
+			} else if (arg == "--regions" && hasValue) {
+				options.regions = std::stoull(argv[++i]);
+			} else if (arg == "--vertices" && hasValue) {
+				options.vertices = std::stoull(argv[++i]);
+			} else if (arg == "--depth" && hasValue) {
+				options.depth = std::stoull(argv[++i]);
+			} else if (arg == "--panel" && hasValue) {
+				options.panel = std::stoull(argv[++i]);
+			} else if (arg == "--macros" && hasValue) {
+				options.macros = std::stoull(argv[++i]);
+			} else if (arg == "--pads" && hasValue) {
+				options.pads = std::stoull(argv[++i]);
+			} else if (arg == "--toggles" && hasValue) {
+				options.toggles = std::stoull(argv[++i]);
+			} else if (arg.rfind("--", 0) == 0) {
+				throw std::invalid_argument("unrecognized option " + arg);
+			} else {
+				positional.push_back(arg);
+			}
+		}
+	} catch (const std::logic_error &ex) {
+		std::cerr << ex.what() << std::endl;
+		printUsage();
+		return EXIT_FAILURE;
+	}
+	if (positional.size() != 1 || options.size <= 0.0 || options.scale < 0.0
+			|| options.apertures == 0) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+	for (uint64_t *count : { &options.flashes, &options.segments,
+			&options.regions, &options.pads, &options.toggles }) {
+		*count = std::llround(*count * options.scale);
+	}
+	// Blocks nested deeper would double the flashes past any use
+	options.depth = std::min<uint64_t>(options.depth, 24);
+
+	if (positional[0] == "-") {
+		std::ios::sync_with_stdio(false);
+		generate(std::cout, options);
+		std::cout.flush();
+		return std::cout.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	std::ofstream out(positional[0], std::ofstream::out | std::ofstream::binary);
+	if (!out.good()) {
+		std::cerr << "failed to open " << positional[0] << std::endl;
+		return EXIT_FAILURE;
+	}
+	generate(out, options);
+	out.close();
+	return out.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
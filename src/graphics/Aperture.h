@@ -21,6 +21,7 @@
 #ifndef APERTURE_H_
 #define APERTURE_H_
 
+#include "AttributeSet.h"
 #include "Box.h"
 #include "Serializer.h"
 #include <memory>
@@ -33,12 +34,24 @@ namespace gerbex {
  */
 class Aperture {
 public:
-	Aperture() = default;
+	Aperture() :
+			m_attributes { } {
+	}
 	virtual ~Aperture() = default;
 	virtual void Serialize(Serializer &serializer, pSerialItem target, const Point &origin) const = 0;
 	virtual Box GetBox() const = 0;
 	virtual std::unique_ptr<Aperture> Clone() const = 0;
 	virtual void ApplyTransform(const Transform &transform) = 0;
+	// Aperture attributes from TA commands, carried by clones; may be null
+	const std::shared_ptr<const AttributeSet>& GetAttributes() const {
+		return m_attributes;
+	}
+	void SetAttributes(const std::shared_ptr<const AttributeSet> &attributes) {
+		m_attributes = attributes;
+	}
+
+protected:
+	std::shared_ptr<const AttributeSet> m_attributes;
 
 };
 
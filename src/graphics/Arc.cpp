@@ -20,6 +20,7 @@
 
 #include "Arc.h"
 #include "Circle.h"
+#include "Instrument.h"
 #include "Serializer.h"
 
 namespace gerbex {
@@ -31,6 +32,7 @@ Arc::Arc() :
 
 Arc::Arc(const ArcSegment &segment, std::shared_ptr<Aperture> aperture) :
 		m_segment { segment } {
+	Instrument::Count("cast", "Arc::Arc");
 	std::shared_ptr<Circle> circle = std::dynamic_pointer_cast<Circle>(
 			aperture);
 	if (!circle) {
@@ -66,6 +68,7 @@ void Arc::ApplyTransform(const Transform &transform) {
 }
 
 std::unique_ptr<GraphicalObject> Arc::Clone() {
+	Instrument::Count("clone", "Arc");
 	return std::make_unique<Arc>(*this);
 }
 
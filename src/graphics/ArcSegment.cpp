@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "ArcSegment.h"
+#include "Instrument.h"
 
 namespace gerbex {
 
@@ -87,6 +88,7 @@ bool ArcSegment::operator !=(const ArcSegment &rhs) const {
 }
 
 std::unique_ptr<Segment> ArcSegment::Clone() {
+	Instrument::Count("clone", "ArcSegment");
 	return std::make_unique<ArcSegment>(*this);
 }
 
@@ -0,0 +1,69 @@
+/*
+ * AttributeSet.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AttributeSet.h"
+#include <algorithm>
+
+namespace gerbex {
+
+static bool compareNames(const AttributeSet::Attribute &a,
+		const AttributeSet::Attribute &b) {
+	return *a.name < *b.name;
+}
+
+AttributeSet::AttributeSet(std::shared_ptr<const StringTable> strings,
+		std::vector<Attribute> attributes) :
+		m_strings { strings }, m_attributes { std::move(attributes) } {
+	std::sort(m_attributes.begin(), m_attributes.end(), compareNames);
+}
+
+const std::vector<AttributeSet::Attribute>& AttributeSet::GetAttributes() const {
+	return m_attributes;
+}
+
+const AttributeSet::Attribute* AttributeSet::Find(
+		const std::string &name) const {
+	auto it = std::lower_bound(m_attributes.begin(), m_attributes.end(), name,
+			[](const Attribute &attribute, const std::string &key) {
+				return *attribute.name < key;
+			});
+	if (it == m_attributes.end() || *it->name != name) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+std::string AttributeSet::GetValue(const std::string &name) const {
+	const Attribute *attribute = Find(name);
+	if (attribute == nullptr || attribute->values.empty()) {
+		return "";
+	}
+	return *attribute->values.front();
+}
+
+bool AttributeSet::IsEmpty() const {
+	return m_attributes.empty();
+}
+
+size_t AttributeSet::GetSize() const {
+	return m_attributes.size();
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,64 @@
+/*
+ * AttributeSet.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATTRIBUTESET_H_
+#define ATTRIBUTESET_H_
+
+#include "StringTable.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * An immutable collection of named attributes, each with a list of values,
+ * as attached by TA and TO commands. Names and values are interned in a
+ * StringTable the set keeps alive, and a set is shared by every object
+ * given the same attributes.
+ */
+class AttributeSet {
+public:
+	struct Attribute {
+		const std::string *name;
+		std::vector<const std::string*> values;
+	};
+
+	// Attributes must be interned in strings, and are sorted by name
+	AttributeSet(std::shared_ptr<const StringTable> strings,
+			std::vector<Attribute> attributes);
+	virtual ~AttributeSet() = default;
+	const std::vector<Attribute>& GetAttributes() const;
+	// The named attribute, or null when absent
+	const Attribute* Find(const std::string &name) const;
+	// The first value of the named attribute, or empty
+	std::string GetValue(const std::string &name) const;
+	bool IsEmpty() const;
+	size_t GetSize() const;
+
+private:
+	std::shared_ptr<const StringTable> m_strings;
+	std::vector<Attribute> m_attributes;
+};
+
+} /* namespace gerbex */
+
+#endif /* ATTRIBUTESET_H_ */
@@ -19,6 +19,7 @@
  */
 
 #include "BlockAperture.h"
+#include "Instrument.h"
 #include "Serializer.h"
 #include <stdexcept>
 
@@ -55,7 +56,9 @@ size_t BlockAperture::GetObjectCount() const {
 }
 
 std::unique_ptr<Aperture> BlockAperture::Clone() const {
+	Instrument::Count("clone", "BlockAperture");
 	std::unique_ptr<BlockAperture> block = std::make_unique<BlockAperture>();
+	block->m_attributes = m_attributes;
 	block->m_objects.reserve(m_objects.size());
 	for (std::shared_ptr<GraphicalObject> obj : m_objects) {
 		block->m_objects.push_back(obj->Clone());
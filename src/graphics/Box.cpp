@@ -101,6 +101,11 @@ Box Box::Extend(const Box &other) const {
 	return Box(right - left, top - bottom, left, bottom);
 }
 
+bool Box::Overlaps(const Box &other) const {
+	return GetLeft() <= other.GetRight() && other.GetLeft() <= GetRight()
+			&& GetBottom() <= other.GetTop() && other.GetBottom() <= GetTop();
+}
+
 Box Box::Pad(double pad) const {
 	double width = m_width + 2 * pad;
 	double height = m_height + 2 * pad;
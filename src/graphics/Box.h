@@ -47,6 +47,7 @@ public:
 	double GetRight() const;
 	double GetAspectRatio() const;
 	Box Extend(const Box &other) const;
+	bool Overlaps(const Box &other) const;
 	Box Pad(double pad) const;
 	Box Translate(const Point &offset) const;
 	friend std::ostream& operator<<(std::ostream &os, const Box &box);
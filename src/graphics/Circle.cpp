@@ -19,6 +19,7 @@
  */
 
 #include "Circle.h"
+#include "Instrument.h"
 #include "Serializer.h"
 #include <stdexcept>
 
@@ -73,6 +74,7 @@ bool Circle::operator !=(const Circle &rhs) const {
 }
 
 std::unique_ptr<Aperture> Circle::Clone() const {
+	Instrument::Count("clone", "Circle");
 	return std::make_unique<Circle>(*this);
 }
 
@@ -20,6 +20,7 @@
 
 #include "ArcSegment.h"
 #include "Contour.h"
+#include "Instrument.h"
 #include "Point.h"
 #include "Serializer.h"
 #include <stdexcept>
@@ -52,6 +53,7 @@ bool Contour::IsClosed() const {
 
 bool Contour::IsCircle() const {
 	if (m_segments.size() == 1) {
+		Instrument::Count("cast", "Contour::IsCircle");
 		std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<ArcSegment>(
 				m_segments.back());
 		return arc && arc->IsCircle();
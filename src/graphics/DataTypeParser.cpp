@@ -19,6 +19,7 @@
  */
 
 #include "DataTypeParser.h"
+#include "Instrument.h"
 #include <regex>
 #include <stdexcept>
 
@@ -39,6 +40,7 @@ const std::string DataTypeParser::GetFieldPattern() {
 std::string DataTypeParser::Match(const std::string &word,
 		const std::string &pattern) {
 	std::smatch match;
+	Instrument::Count("regex", "DataTypeParser::Match");
 	std::regex regex(pattern);
 	if (std::regex_match(word, match, regex)) {
 		return match[0].str();
@@ -69,6 +71,7 @@ Parameters DataTypeParser::SplitParams(const std::string &field, char delim) {
 	}
 
 	std::smatch match;
+	Instrument::Count("regex", "DataTypeParser::SplitParams");
 	std::regex regex(GetNumberPattern());
 	std::istringstream istr(field);
 	while (!istr.eof()) {
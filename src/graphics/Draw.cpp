@@ -20,6 +20,7 @@
 
 #include "Circle.h"
 #include "Draw.h"
+#include "Instrument.h"
 #include "Serializer.h"
 #include <algorithm>
 
@@ -32,6 +33,7 @@ Draw::Draw() :
 
 Draw::Draw(const Segment &segment, std::shared_ptr<Aperture> aperture) :
 		m_segment { segment } {
+	Instrument::Count("cast", "Draw::Draw");
 	std::shared_ptr<Circle> circle = std::dynamic_pointer_cast<Circle>(aperture);
 	if (!circle) {
 		throw std::invalid_argument("draw only supports circle apertures");
@@ -66,6 +68,7 @@ void Draw::ApplyTransform(const Transform &transform) {
 }
 
 std::unique_ptr<GraphicalObject> Draw::Clone() {
+	Instrument::Count("clone", "Draw");
 	return std::make_unique<Draw>(*this);
 }
 
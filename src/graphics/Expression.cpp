@@ -19,14 +19,22 @@
  */
 
 #include "Expression.h"
-#include <regex>
-#include <sstream>
+#include <cctype>
+#include <cstring>
 #ifdef DEBUG_MACRO
 	#include <iostream>
 #endif
 
 namespace gerbex {
 
+// Index of the first non-digit at or after start
+static size_t skipDigits(const std::string &text, size_t start) {
+	while (start < text.size() && std::isdigit((unsigned char) text[start])) {
+		start++;
+	}
+	return start;
+}
+
 Operator::Operator(char op) :
 		m_op { op } {
 }
@@ -86,8 +94,8 @@ Expression::Expression() :
 }
 
 Expression::Expression(std::string body) :
-		m_body { body } {
-	// Empty
+		m_body { body }, m_tokens { }, m_error { } {
+	tokenize();
 }
 
 const std::string& Expression::GetBody() const {
@@ -95,37 +103,25 @@ const std::string& Expression::GetBody() const {
 }
 
 double Expression::Evaluate(const Variables &vars) const {
+	if (!m_error.empty()) {
+		throw std::invalid_argument(m_error);
+	}
 	// Shunting yard algorithm
 	std::vector<double> output;
-	std::vector<std::shared_ptr<Operator>> operators;
-	std::ostringstream pattern;
-	pattern << "(";
-	pattern << "([0-9]*[.]?[0-9]+)";	// Normal number
-	pattern << "|([$][0-9]+)";			// Variable
-	pattern << "|([()+x/-])";			// Operator (- must be last!)
-	pattern << "|(\\S+)";				// Other invalid chars
-	pattern << ")";
-	std::regex re(pattern.str());
+	std::vector<Operator> operators;
 #ifdef DEBUG_MACRO
 	std::cout << "\n" << m_body;
 #endif
-	auto tokens_begin = std::sregex_iterator(m_body.begin(), m_body.end(), re);
-	auto tokens_end = std::sregex_iterator();
-
-	for (auto it = tokens_begin; it != tokens_end; ++it) {
-		std::smatch match = *it;
-		if (match[2].matched) {
-			// Number
-			output.push_back(std::stod(match.str()));
-		} else if (match[3].matched) {
-			// Variable
-			output.push_back(LookupVariable(match.str(), vars));
-		} else if (match[4].matched) {
-			// Operator
-			std::shared_ptr<Operator> new_op = MakeOperator(match.str());
-			if (new_op->OpChar() == ')') {
+	for (const Token &token : m_tokens) {
+		if (token.kind == Token::Kind::Number) {
+			output.push_back(token.number);
+		} else if (token.kind == Token::Kind::Variable) {
+			output.push_back(LookupVariable(token.variable, vars));
+		} else {
+			Operator new_op(token.op);
+			if (new_op.OpChar() == ')') {
 				// Process all operators until open bracket
-				while (!operators.empty() && operators.back()->OpChar() != '(') {
+				while (!operators.empty() && operators.back().OpChar() != '(') {
 					ApplyOperator(output, operators);
 				}
 				if (operators.empty()) {
@@ -133,28 +129,25 @@ double Expression::Evaluate(const Variables &vars) const {
 				} else {
 					operators.pop_back();	// Discard '('
 				}
-			} else if (new_op->OpChar() == '(') {
+			} else if (new_op.OpChar() == '(') {
 				// Add open bracket to stack
 				operators.push_back(new_op);
 			} else {
 				// Process + - x /
-				while (!operators.empty() && operators.back()->OpChar() != '(') {
+				while (!operators.empty() && operators.back().OpChar() != '(') {
 					// Process all higher precedence operators first, up to open bracket
-					if (new_op->Precedence() > operators.back()->Precedence()) {
+					if (new_op.Precedence() > operators.back().Precedence()) {
 						break;
 					}
 					ApplyOperator(output, operators);
 				}
 				operators.push_back(new_op);
 			}
-
-		} else {
-			throw std::invalid_argument("unrecognized tokens");
 		}
 #ifdef DEBUG_MACRO
 		std::cout << "\nOp: ";
-		for (auto op : operators) {
-			std::cout << op->OpChar() << " ";
+		for (Operator &op : operators) {
+			std::cout << op.OpChar() << " ";
 		}
 		std::cout << "Out: ";
 		for (auto out : output) {
@@ -164,7 +157,7 @@ double Expression::Evaluate(const Variables &vars) const {
 	}
 	while (!operators.empty()) {
 		// Process remaining operators
-		if (operators.back()->OpChar() == '(') {
+		if (operators.back().OpChar() == '(') {
 			throw std::invalid_argument("open bracket without close");
 		}
 		ApplyOperator(output, operators);
@@ -177,12 +170,40 @@ double Expression::Evaluate(const Variables &vars) const {
 	}
 }
 
-std::unique_ptr<Operator> Expression::MakeOperator(const std::string &op) {
-	return std::make_unique<Operator>(op[0]);
+void Expression::tokenize() {
+	// Numbers [0-9]*[.]?[0-9]+, variables [$][0-9]+ and operators ()+x/-,
+	// anything else but spaces is invalid
+	size_t i = 0;
+	while (i < m_body.size()) {
+		char c = m_body[i];
+		size_t end = skipDigits(m_body, i);
+		if (end < m_body.size() && m_body[end] == '.'
+				&& skipDigits(m_body, end + 1) > end + 1) {
+			end = skipDigits(m_body, end + 1);
+		}
+		if (end > i) {
+			m_tokens.push_back( { Token::Kind::Number, std::stod(
+					m_body.substr(i, end - i)), 0, 0 });
+		} else if (c == '$' && skipDigits(m_body, i + 1) > i + 1) {
+			end = skipDigits(m_body, i + 1);
+			m_tokens.push_back( { Token::Kind::Variable, 0.0, std::stoi(
+					m_body.substr(i + 1, end - i - 1)), 0 });
+		} else if (c != '\0' && std::strchr("()+x/-", c)) {
+			m_tokens.push_back( { Token::Kind::Operator, 0.0, 0, c });
+			end = i + 1;
+		} else if (std::isspace((unsigned char) c)) {
+			end = i + 1;
+		} else {
+			m_error = "unrecognized tokens";
+			m_tokens.clear();
+			return;
+		}
+		i = end;
+	}
 }
 
 void Expression::ApplyOperator(std::vector<double> &output,
-		std::vector<std::shared_ptr<Operator>> &operators) {
+		std::vector<Operator> &operators) {
 	if (output.empty()) {
 		throw std::invalid_argument("missing operand");
 	}
@@ -190,26 +211,18 @@ void Expression::ApplyOperator(std::vector<double> &output,
 		throw std::invalid_argument("missing operator");
 	}
 
-	operators.back()->Apply(output);
+	operators.back().Apply(output);
 	operators.pop_back();
 }
 
-double Expression::LookupVariable(const std::string &id,
-		const Variables &vars) {
-	std::smatch match;
-	std::regex var_re("[$]([0-9]+)");
-	if (std::regex_search(id, match, var_re)) {
-		int var_id = std::stoi(match[1].str());
-		auto value = vars.find(var_id);
-		if (value != vars.end()) {
-			return value->second;
-		} else {
-			throw std::invalid_argument(
-					"variable " + match.str()
-							+ " was not provided in macro call");
-		}
+double Expression::LookupVariable(int id, const Variables &vars) {
+	auto value = vars.find(id);
+	if (value != vars.end()) {
+		return value->second;
 	} else {
-		throw std::invalid_argument("invalid variable id " + id);
+		throw std::invalid_argument(
+				"variable $" + std::to_string(id)
+						+ " was not provided in macro call");
 	}
 }
 
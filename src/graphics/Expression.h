@@ -44,7 +44,9 @@ private:
 };
 
 /*
- *
+ * An arithmetic expression of a macro, split into tokens once when made so
+ * it can be evaluated for any number of calls. Invalid characters are only
+ * reported when evaluating.
  */
 class Expression {
 public:
@@ -55,13 +57,23 @@ public:
 	const std::string& GetBody() const;
 
 private:
-	static std::unique_ptr<Operator> MakeOperator(const std::string &op);
-	static double LookupVariable(const std::string &id, const Variables &vars);
+	struct Token {
+		enum class Kind {
+			Number, Variable, Operator
+		} kind;
+		double number;
+		int variable;
+		char op;
+	};
+	void tokenize();
+	static double LookupVariable(int id, const Variables &vars);
 	static void ApplyOperator(std::vector<double> &output,
-			std::vector<std::shared_ptr<Operator>> &operators);
+			std::vector<Operator> &operators);
 
 private:
 	std::string m_body;
+	std::vector<Token> m_tokens;
+	std::string m_error;
 };
 
 } /* namespace gerbex */
@@ -21,6 +21,7 @@
 #include "BlockAperture.h"
 #include "Circle.h"
 #include "Flash.h"
+#include "Instrument.h"
 #include "Serializer.h"
 
 namespace gerbex {
@@ -59,6 +60,7 @@ void Flash::ApplyTransform(const Transform &transform) {
 }
 
 std::unique_ptr<GraphicalObject> Flash::Clone() {
+	Instrument::Count("clone", "Flash");
 	return std::make_unique<Flash>(*this);
 }
 
@@ -68,6 +70,7 @@ void Flash::Translate(const Point &offset) {
 
 void Flash::SetPolarity(Polarity polarity) {
 	GraphicalObject::SetPolarity(polarity);
+	Instrument::Count("cast", "Flash::SetPolarity");
 	std::shared_ptr<BlockAperture> block = std::dynamic_pointer_cast<
 			BlockAperture>(m_aperture);
 	if (block && polarity == Polarity::Clear) {
@@ -26,6 +26,7 @@
 
 namespace gerbex {
 
+class AttributeSet;
 class Box;
 class Point;
 class Serializer;
@@ -41,7 +42,7 @@ enum class Polarity {
 class GraphicalObject {
 public:
 	GraphicalObject() :
-			m_polarity { Polarity::Dark } {
+			m_polarity { Polarity::Dark }, m_attributes { } {
 	}
 	virtual ~GraphicalObject() = default;
 	virtual void Translate(const Point &offset) = 0;
@@ -63,6 +64,13 @@ public:
 	virtual void SetPolarity(Polarity polarity) {
 		m_polarity = polarity;
 	}
+	// Object attributes from TO commands, shared with other objects; may be null
+	const std::shared_ptr<const AttributeSet>& GetAttributes() const {
+		return m_attributes;
+	}
+	void SetAttributes(const std::shared_ptr<const AttributeSet> &attributes) {
+		m_attributes = attributes;
+	}
 	static Polarity PolarityFromCommand(const std::string &str) {
 		if (str == "C") {
 			return Polarity::Clear;
@@ -75,6 +83,7 @@ public:
 
 protected:
 	Polarity m_polarity;
+	std::shared_ptr<const AttributeSet> m_attributes;
 
 };
 
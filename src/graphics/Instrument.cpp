@@ -0,0 +1,136 @@
+/*
+ * Instrument.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Instrument.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace gerbex {
+
+static const size_t SUBSYSTEMS =
+		static_cast<size_t>(Instrument::Subsystem::Count);
+
+static const char *SUBSYSTEM_NAMES[SUBSYSTEMS] = { "other", "lex",
+		"commands", "box", "serialize", "save" };
+
+static thread_local Instrument::Subsystem t_subsystem =
+		Instrument::Subsystem::Other;
+
+// Zero initialized before any allocation can reach them
+static std::array<std::atomic<uint64_t>, SUBSYSTEMS> g_allocations;
+static std::array<std::atomic<uint64_t>, SUBSYSTEMS> g_allocatedBytes;
+
+// Counts by kind and name, in a fixed table so that counting never
+// allocates. Names are literals, compared by address before contents.
+struct Counted {
+	const char *kind;
+	const char *name;
+	uint64_t count;
+};
+static const size_t MAX_COUNTED = 256;
+static std::array<Counted, MAX_COUNTED> g_counted;
+static size_t g_countedSize = 0;
+static uint64_t g_dropped = 0;
+static std::mutex g_mutex;
+
+Instrument::Scope::Scope(Subsystem subsystem) :
+		m_previous { t_subsystem } {
+	Set(subsystem);
+}
+
+Instrument::Scope::~Scope() {
+	Set(m_previous);
+}
+
+void Instrument::Scope::Set(Subsystem subsystem) {
+	if (kEnabled) {
+		t_subsystem = subsystem;
+	}
+}
+
+void Instrument::count(const char *kind, const char *name) {
+	std::lock_guard<std::mutex> lock(g_mutex);
+	for (size_t i = 0; i < g_countedSize; i++) {
+		Counted &counted = g_counted[i];
+		if ((counted.name == name || std::strcmp(counted.name, name) == 0)
+				&& (counted.kind == kind
+					|| std::strcmp(counted.kind, kind) == 0)) {
+			counted.count++;
+			return;
+		}
+	}
+	if (g_countedSize < MAX_COUNTED) {
+		g_counted[g_countedSize++] = { kind, name, 1 };
+	} else {
+		g_dropped++;
+	}
+}
+
+void Instrument::AddAllocation(size_t bytes) noexcept {
+	size_t subsystem = static_cast<size_t>(t_subsystem);
+	g_allocations[subsystem].fetch_add(1, std::memory_order_relaxed);
+	g_allocatedBytes[subsystem].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+Instrument::Subsystem Instrument::GetSubsystem() {
+	return t_subsystem;
+}
+
+const char* Instrument::GetSubsystemName(Subsystem subsystem) {
+	size_t index = static_cast<size_t>(subsystem);
+	return index < SUBSYSTEMS ? SUBSYSTEM_NAMES[index] : "unknown";
+}
+
+std::map<std::string, uint64_t> Instrument::GetCounts() {
+	std::map<std::string, uint64_t> result;
+	for (size_t i = 0; i < SUBSYSTEMS; i++) {
+		uint64_t allocations = g_allocations[i].load();
+		if (allocations > 0) {
+			result[std::string("allocations ") + SUBSYSTEM_NAMES[i]] =
+					allocations;
+			result[std::string("allocated bytes ") + SUBSYSTEM_NAMES[i]] =
+					g_allocatedBytes[i].load();
+		}
+	}
+	std::lock_guard<std::mutex> lock(g_mutex);
+	for (size_t i = 0; i < g_countedSize; i++) {
+		const Counted &counted = g_counted[i];
+		result[std::string(counted.kind) + " " + counted.name] +=
+				counted.count;
+	}
+	if (g_dropped > 0) {
+		result["dropped counts"] = g_dropped;
+	}
+	return result;
+}
+
+void Instrument::Reset() {
+	for (size_t i = 0; i < SUBSYSTEMS; i++) {
+		g_allocations[i] = 0;
+		g_allocatedBytes[i] = 0;
+	}
+	std::lock_guard<std::mutex> lock(g_mutex);
+	g_countedSize = 0;
+	g_dropped = 0;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,94 @@
+/*
+ * Instrument.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INSTRUMENT_H_
+#define INSTRUMENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace gerbex {
+
+/*
+ * Opt-in counts of the work the object model does: heap allocations and
+ * bytes by subsystem, Clone calls by class, regex compilations and dynamic
+ * pointer casts by where they happen. Counting is compiled in only when
+ * GERBEX_INSTRUMENT is defined, set by the CMake option of that name.
+ * Otherwise every call is empty and the counts stay empty, so the hooks
+ * cost nothing in a normal build.
+ *
+ * Allocations reach AddAllocation from an operator new replacement that
+ * only the gerbex executable links, as the test runner has its own. They
+ * are charged to the subsystem a Scope set on the allocating thread. Pool
+ * threads have no scope, so their allocations count as "other".
+ * Thread safe.
+ */
+class Instrument {
+public:
+	enum class Subsystem {
+		Other, Lex, Commands, Box, Serialize, Save, Count
+	};
+
+#ifdef GERBEX_INSTRUMENT
+	static constexpr bool kEnabled = true;
+#else
+	static constexpr bool kEnabled = false;
+#endif
+
+	/*
+	 * Charges allocations on this thread to a subsystem until destroyed or
+	 * set to another, then restores the one before.
+	 */
+	class Scope {
+	public:
+		Scope(Subsystem subsystem);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+		void Set(Subsystem subsystem);
+
+	private:
+		Subsystem m_previous;
+	};
+
+	// Counts one event of a kind, such as "clone", at a named place
+	static void Count(const char *kind, const char *name) {
+		if (kEnabled) {
+			count(kind, name);
+		}
+	}
+	// Must not allocate, it is called from operator new
+	static void AddAllocation(size_t bytes) noexcept;
+	static Subsystem GetSubsystem();
+	static const char* GetSubsystemName(Subsystem subsystem);
+	// Every non-zero count, as "<kind> <name>", "allocations <subsystem>"
+	// and "allocated bytes <subsystem>"
+	static std::map<std::string, uint64_t> GetCounts();
+	static void Reset();
+
+private:
+	static void count(const char *kind, const char *name);
+};
+
+} /* namespace gerbex */
+
+#endif /* INSTRUMENT_H_ */
@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Macro.h"
 #include "Serializer.h"
 
@@ -72,6 +73,7 @@ Box Macro::GetBox() const {
 }
 
 std::unique_ptr<Aperture> Macro::Clone() const {
+	Instrument::Count("clone", "Macro");
 	return std::make_unique<Macro>(*this);
 }
 
@@ -20,6 +20,7 @@
 
 #include "DataTypeParser.h"
 #include "Expression.h"
+#include "Instrument.h"
 #include "Macro.h"
 #include "MacroCircle.h"
 #include "MacroCenterLine.h"
@@ -29,6 +30,7 @@
 #include "MacroThermal.h"
 #include "MacroVectorLine.h"
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 
 namespace gerbex {
@@ -39,35 +41,29 @@ MacroTemplate::MacroTemplate() {
 }
 
 MacroTemplate::MacroTemplate(Fields body) :
-		m_body { body } {
-	// Empty
+		m_body { body }, m_statements { }, m_error { } {
+	try {
+		compile();
+	} catch (const std::invalid_argument &ex) {
+		m_error = ex.what();
+		m_statements.clear();
+	}
 }
 
 std::unique_ptr<Aperture> MacroTemplate::Call(const Parameters &parameters) {
+	if (!m_error.empty()) {
+		throw std::invalid_argument(m_error);
+	}
 	Variables variables = MacroTemplate::GetVariables(parameters);
 	std::unique_ptr<Macro> macro = std::make_unique<Macro>();
-	for (std::string &block : m_body) {
-		std::smatch match;
-		std::regex regex("^(([0-9]+)|([$][0-9]+=))");
-		MacroCodes code;
-		if (std::regex_search(block, match, regex)) {
-			if (match[3].matched) {
-				// Variable definition, $x=
-				MacroTemplate::DefineVariable(block, variables);
-				continue;
-			}
-		} else {
-			throw std::invalid_argument("invalid macro body");
-		}
-		// Statement, starting with primitive code
-		std::deque<Expression> expr = SplitStatement(block);
-		code = (MacroCodes) std::stoi(expr.front().GetBody());
-		if (code == MacroCodes::COMMENT) {
+	for (const Statement &statement : m_statements) {
+		if (statement.variable.has_value()) {
+			MacroTemplate::DefineVariable(statement, variables);
 			continue;
 		}
-		expr.pop_front();	// Discard code
-		Parameters prim_params = ProcessExpressions(expr, variables);
-		switch (code) {
+		Parameters prim_params = ProcessExpressions(statement.expressions,
+				variables);
+		switch (statement.code) {
 		case MacroCodes::CIRCLE:
 			macro->AddPrimitive(MacroCircle::FromParameters(prim_params));
 			break;
@@ -87,7 +83,7 @@ std::unique_ptr<Aperture> MacroTemplate::Call(const Parameters &parameters) {
 			macro->AddPrimitive(MacroThermal::FromParameters(prim_params));
 			break;
 		default:
-			throw std::invalid_argument("invalid macro code " + block);
+			break;	// Rejected when compiled
 		}
 	}
 	return macro;
@@ -97,6 +93,47 @@ const Fields& MacroTemplate::GetBody() const {
 	return m_body;
 }
 
+void MacroTemplate::compile() {
+	Instrument::Count("regex", "MacroTemplate::compile");
+	std::regex regex("^(([0-9]+)|([$][0-9]+=))");
+	Instrument::Count("regex", "MacroTemplate::compile");
+	std::regex definition("[$]([0-9]+)=([^%*,]+)");
+	for (const std::string &block : m_body) {
+		std::smatch match;
+		if (!std::regex_search(block, match, regex)) {
+			throw std::invalid_argument("invalid macro body");
+		}
+		if (match[3].matched) {
+			// Variable definition, $x=
+			if (!std::regex_match(block, match, definition)) {
+				throw std::invalid_argument("invalid variable definition");
+			}
+			m_statements.push_back( { std::stoi(match[1].str()),
+					MacroCodes::COMMENT, { Expression(match[2].str()) } });
+			continue;
+		}
+		// Statement, starting with primitive code
+		std::deque<Expression> expr = SplitStatement(block);
+		MacroCodes code = (MacroCodes) std::stoi(expr.front().GetBody());
+		expr.pop_front();	// Discard code
+		switch (code) {
+		case MacroCodes::COMMENT:
+			continue;
+		case MacroCodes::CIRCLE:
+		case MacroCodes::VECTOR_LINE:
+		case MacroCodes::CENTER_LINE:
+		case MacroCodes::OUTLINE:
+		case MacroCodes::POLYGON:
+		case MacroCodes::THERMAL:
+			m_statements.push_back( { std::nullopt, code, { expr.begin(),
+					expr.end() } });
+			break;
+		default:
+			throw std::invalid_argument("invalid macro code " + block);
+		}
+	}
+}
+
 Variables MacroTemplate::GetVariables(const Parameters &parameters) {
 	// Variables start with $1
 	Variables vars;
@@ -106,26 +143,18 @@ Variables MacroTemplate::GetVariables(const Parameters &parameters) {
 	return vars;
 }
 
-void MacroTemplate::DefineVariable(std::string &block, Variables &vars) {
-	std::smatch match;
-	std::regex regex(
-			"[$]([0-9]+)=([^%*,]+)");
-	if (std::regex_match(block, match, regex)) {
-		int var_id = std::stoi(match[1].str());
-		if (vars.find(var_id) == vars.end()) {
-			Expression expr(match[2].str());
-			vars[var_id] = expr.Evaluate(vars);
-		} else {
-			throw std::invalid_argument(
-					"variable $" + std::to_string(var_id)
-							+ " cannot be redefined");
-		}
+void MacroTemplate::DefineVariable(const Statement &statement,
+		Variables &vars) {
+	int var_id = *statement.variable;
+	if (vars.find(var_id) == vars.end()) {
+		vars[var_id] = statement.expressions.front().Evaluate(vars);
 	} else {
-		throw std::invalid_argument("invalid variable definition");
+		throw std::invalid_argument(
+				"variable $" + std::to_string(var_id) + " cannot be redefined");
 	}
 }
 
-std::deque<Expression> MacroTemplate::SplitStatement(std::string &block) {
+std::deque<Expression> MacroTemplate::SplitStatement(const std::string &block) {
 	std::deque<Expression> expr;
 	if (block.empty()) {
 		return expr;
@@ -141,11 +170,11 @@ std::deque<Expression> MacroTemplate::SplitStatement(std::string &block) {
 	return expr;
 }
 
-Parameters MacroTemplate::ProcessExpressions(std::deque<Expression> &expr, const Variables &vars) {
+Parameters MacroTemplate::ProcessExpressions(
+		const std::vector<Expression> &expr, const Variables &vars) {
 	Parameters params;
-	for (auto e: expr) {
-		double p = e.Evaluate(vars);
-		params.push_back(p);
+	for (const Expression &e : expr) {
+		params.push_back(e.Evaluate(vars));
 	}
 	return params;
 }
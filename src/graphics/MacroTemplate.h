@@ -25,7 +25,9 @@
 #include "Expression.h"
 #include "MacroPrimitive.h"
 #include <deque>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace gerbex {
 
@@ -41,6 +43,9 @@ enum class MacroCodes {
 
 /*
  * Creates a Macro aperture using parameters, variables and expressions.
+ * The body is compiled once when made, so a call only evaluates it. Calls
+ * do not change the template, which may be shared between threads. An
+ * invalid body is reported when called.
  */
 class MacroTemplate: public ApertureTemplate {
 public:
@@ -51,12 +56,22 @@ public:
 	const Fields &GetBody() const;
 
 private:
+	// A variable definition, $n=expression, or a primitive with its code
+	struct Statement {
+		std::optional<int> variable;
+		MacroCodes code;
+		std::vector<Expression> expressions;
+	};
+	void compile();
 	static Variables GetVariables(const Parameters &parameters);
-	static void DefineVariable(std::string &block, Variables &vars);
-	static std::deque<Expression> SplitStatement(std::string &block);
-	static Parameters ProcessExpressions(std::deque<Expression> &expr, const Variables &vars);
+	static void DefineVariable(const Statement &statement, Variables &vars);
+	static std::deque<Expression> SplitStatement(const std::string &block);
+	static Parameters ProcessExpressions(const std::vector<Expression> &expr,
+			const Variables &vars);
 
 	Fields m_body;
+	std::vector<Statement> m_statements;
+	std::string m_error;
 };
 
 } /* namespace gerbex */
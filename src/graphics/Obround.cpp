@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Obround.h"
 #include "Serializer.h"
 #include <stdexcept>
@@ -75,6 +76,7 @@ Box Obround::GetBox() const {
 }
 
 std::unique_ptr<Aperture> Obround::Clone() const {
+	Instrument::Count("clone", "Obround");
 	return std::make_unique<Obround>(*this);
 }
 
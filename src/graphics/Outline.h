@@ -0,0 +1,46 @@
+/*
+ * Outline.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTLINE_H_
+#define OUTLINE_H_
+
+#include "Box.h"
+#include "Point.h"
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Polygon outline in plain coordinates, with optional holes.
+ * The polygonising backends buffer their input as outlines, and convert
+ * flattened results back to outlines for writing.
+ */
+struct Outline {
+	Outline(const std::vector<Point> &boundary) :
+			boundary { boundary }, holes { }, box { boundary } {
+	}
+	std::vector<Point> boundary;
+	std::vector<std::vector<Point>> holes;
+	Box box;
+};
+
+} /* namespace gerbex */
+
+#endif /* OUTLINE_H_ */
@@ -0,0 +1,83 @@
+/*
+ * OutlineItem.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTLINEITEM_H_
+#define OUTLINEITEM_H_
+
+#include "Instrument.h"
+#include "Outline.h"
+#include "Serializer.h"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Buffers the tessellated outlines of one target until the layer is
+ * flattened, so a polygon backend can join them in one pass rather than
+ * overlay them one at a time.
+ */
+class OutlineItem: public SerialItem {
+public:
+	OutlineItem(Polarity polarity) :
+			m_polarity { polarity }, m_outlines { }, m_mask { } {
+	}
+	virtual ~OutlineItem() = default;
+	static std::shared_ptr<OutlineItem> Get(pSerialItem item) {
+		Instrument::Count("cast", "OutlineItem::Get");
+		std::shared_ptr<OutlineItem> outline = std::dynamic_pointer_cast<
+				OutlineItem>(item);
+		if (!outline) {
+			throw std::invalid_argument("Expected an outline item");
+		}
+		return outline;
+	}
+
+	void Add(const Outline &outline) {
+		m_outlines.push_back(outline);
+	}
+
+	const std::vector<Outline>& GetOutlines() const {
+		return m_outlines;
+	}
+
+	// The mask is applied when flattening, so it may still be filled later
+	void SetMask(const std::shared_ptr<OutlineItem> &mask) {
+		m_mask = mask;
+	}
+
+	const std::shared_ptr<OutlineItem>& GetMask() const {
+		return m_mask;
+	}
+
+	Polarity GetPolarity() const {
+		return m_polarity;
+	}
+
+private:
+	Polarity m_polarity;
+	std::vector<Outline> m_outlines;
+	std::shared_ptr<OutlineItem> m_mask;
+};
+
+} /* namespace gerbex */
+
+#endif /* OUTLINEITEM_H_ */
@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Polygon.h"
 #include "Serializer.h"
 #include <cmath>
@@ -83,6 +84,7 @@ Box Polygon::GetBox() const {
 }
 
 std::unique_ptr<Aperture> Polygon::Clone() const {
+	Instrument::Count("clone", "Polygon");
 	return std::make_unique<Polygon>(*this);
 }
 
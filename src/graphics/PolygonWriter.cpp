@@ -0,0 +1,194 @@
+/*
+ * PolygonWriter.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PolygonWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iomanip>
+#include <stdexcept>
+
+namespace gerbex {
+
+// VTK cell type for a polygon
+constexpr int VTK_POLYGON = 7;
+
+// Decimals written, matching the finest Gerber coordinate format
+constexpr int COORDINATE_DECIMALS = 6;
+
+PolygonWriter::PolygonWriter(std::ostream &stream, PolygonFormat format) :
+		m_stream { stream }, m_format { format }, m_numPolygons { 0 }, m_ringSizes {
+				}, m_ringPolygons { }, m_ringHoles { } {
+	m_stream << std::fixed << std::setprecision(COORDINATE_DECIMALS);
+}
+
+PolygonFormat PolygonWriter::FormatFromPath(const std::string &path) {
+	return FormatFromExtension(std::filesystem::path(path).extension().string());
+}
+
+PolygonFormat PolygonWriter::FormatFromExtension(const std::string &extension) {
+	std::string ext = extension;
+	std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
+		return std::tolower(c);
+	});
+	if (ext == ".vtu") {
+		return PolygonFormat::Vtu;
+	} else if (ext == ".wkt") {
+		return PolygonFormat::Wkt;
+	} else if (ext == ".geojson" || ext == ".json") {
+		return PolygonFormat::GeoJson;
+	}
+	throw std::invalid_argument("unsupported polygon file type: " + ext);
+}
+
+void PolygonWriter::Begin(size_t numRings, size_t numPoints) {
+	m_numPolygons = 0;
+	switch (m_format) {
+	case PolygonFormat::Vtu:
+		m_ringSizes.clear();
+		m_ringSizes.reserve(numRings);
+		m_ringPolygons.clear();
+		m_ringPolygons.reserve(numRings);
+		m_ringHoles.clear();
+		m_ringHoles.reserve(numRings);
+		m_stream << "<?xml version=\"1.0\"?>\n";
+		m_stream << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\""
+				<< " byte_order=\"LittleEndian\">\n";
+		m_stream << "<UnstructuredGrid>\n";
+		m_stream << "<Piece NumberOfPoints=\"" << numPoints
+				<< "\" NumberOfCells=\"" << numRings << "\">\n";
+		m_stream << "<Points>\n";
+		m_stream << "<DataArray type=\"Float64\" NumberOfComponents=\"3\""
+				<< " format=\"ascii\">\n";
+		break;
+	case PolygonFormat::Wkt:
+		m_stream << "MULTIPOLYGON ";
+		break;
+	case PolygonFormat::GeoJson:
+		m_stream << "{\"type\": \"MultiPolygon\", \"coordinates\": [";
+		break;
+	}
+}
+
+void PolygonWriter::Write(const Outline &polygon) {
+	if (m_format == PolygonFormat::Wkt) {
+		m_stream << (m_numPolygons > 0 ? ", (" : "((");
+	} else if (m_format == PolygonFormat::GeoJson) {
+		m_stream << (m_numPolygons > 0 ? ", [" : "[");
+	}
+	writeRing(polygon.boundary, false);
+	for (const std::vector<Point> &hole : polygon.holes) {
+		writeRing(hole, true);
+	}
+	if (m_format != PolygonFormat::Vtu) {
+		m_stream << (m_format == PolygonFormat::Wkt ? ")" : "]");
+	}
+	m_numPolygons++;
+}
+
+void PolygonWriter::writeRing(const std::vector<Point> &ring, bool hole) {
+	switch (m_format) {
+	case PolygonFormat::Vtu:
+		// Points are written as they come, cells once they are all known
+		for (const Point &point : ring) {
+			m_stream << point.GetX() << " " << point.GetY() << " 0\n";
+		}
+		m_ringSizes.push_back(ring.size());
+		m_ringPolygons.push_back(m_numPolygons);
+		m_ringHoles.push_back(hole);
+		break;
+	case PolygonFormat::Wkt:
+		// Rings are closed by repeating the first point
+		m_stream << (hole ? ", (" : "(");
+		for (const Point &point : ring) {
+			m_stream << point.GetX() << " " << point.GetY() << ", ";
+		}
+		m_stream << ring.front().GetX() << " " << ring.front().GetY() << ")";
+		break;
+	case PolygonFormat::GeoJson:
+		m_stream << (hole ? ", [" : "[");
+		for (const Point &point : ring) {
+			m_stream << "[" << point.GetX() << ", " << point.GetY() << "], ";
+		}
+		m_stream << "[" << ring.front().GetX() << ", " << ring.front().GetY()
+				<< "]]";
+		break;
+	}
+}
+
+void PolygonWriter::End() {
+	switch (m_format) {
+	case PolygonFormat::Vtu: {
+		m_stream << "</DataArray>\n";
+		m_stream << "</Points>\n";
+		m_stream << "<Cells>\n";
+		m_stream << "<DataArray type=\"Int64\" Name=\"connectivity\""
+				<< " format=\"ascii\">\n";
+		size_t index = 0;
+		for (size_t size : m_ringSizes) {
+			for (size_t i = 0; i < size; i++) {
+				m_stream << index++ << (i + 1 < size ? " " : "\n");
+			}
+		}
+		m_stream << "</DataArray>\n";
+		m_stream << "<DataArray type=\"Int64\" Name=\"offsets\""
+				<< " format=\"ascii\">\n";
+		size_t offset = 0;
+		for (size_t size : m_ringSizes) {
+			offset += size;
+			m_stream << offset << "\n";
+		}
+		m_stream << "</DataArray>\n";
+		m_stream << "<DataArray type=\"UInt8\" Name=\"types\""
+				<< " format=\"ascii\">\n";
+		for (size_t i = 0; i < m_ringSizes.size(); i++) {
+			m_stream << VTK_POLYGON << "\n";
+		}
+		m_stream << "</DataArray>\n";
+		m_stream << "</Cells>\n";
+		m_stream << "<CellData>\n";
+		m_stream << "<DataArray type=\"Int64\" Name=\"polygon\""
+				<< " format=\"ascii\">\n";
+		for (size_t polygon : m_ringPolygons) {
+			m_stream << polygon << "\n";
+		}
+		m_stream << "</DataArray>\n";
+		m_stream << "<DataArray type=\"UInt8\" Name=\"hole\""
+				<< " format=\"ascii\">\n";
+		for (bool hole : m_ringHoles) {
+			m_stream << hole << "\n";
+		}
+		m_stream << "</DataArray>\n";
+		m_stream << "</CellData>\n";
+		m_stream << "</Piece>\n";
+		m_stream << "</UnstructuredGrid>\n";
+		m_stream << "</VTKFile>\n";
+		break;
+	}
+	case PolygonFormat::Wkt:
+		m_stream << (m_numPolygons > 0 ? ")\n" : "EMPTY\n");
+		break;
+	case PolygonFormat::GeoJson:
+		m_stream << "]}\n";
+		break;
+	}
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,66 @@
+/*
+ * PolygonWriter.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLYGONWRITER_H_
+#define POLYGONWRITER_H_
+
+#include "Outline.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+enum class PolygonFormat {
+	Vtu,	// VTK unstructured grid, one polygon cell per ring
+	Wkt,	// Well-known text MULTIPOLYGON
+	GeoJson	// GeoJSON MultiPolygon geometry
+};
+
+/*
+ * Streams polygons with holes to a file format, without keeping them.
+ * Call Begin with the totals, Write for each polygon, then End.
+ * VTU needs the totals up front for its header, the other formats ignore them.
+ */
+class PolygonWriter {
+public:
+	PolygonWriter(std::ostream &stream, PolygonFormat format);
+	virtual ~PolygonWriter() = default;
+	static PolygonFormat FormatFromPath(const std::string &path);
+	// Extension with its dot, in any case
+	static PolygonFormat FormatFromExtension(const std::string &extension);
+	void Begin(size_t numRings, size_t numPoints);
+	void Write(const Outline &polygon);
+	void End();
+
+private:
+	void writeRing(const std::vector<Point> &ring, bool hole);
+	std::ostream &m_stream;
+	PolygonFormat m_format;
+	size_t m_numPolygons;
+	std::vector<size_t> m_ringSizes;
+	std::vector<size_t> m_ringPolygons;
+	std::vector<bool> m_ringHoles;
+};
+
+} /* namespace gerbex */
+
+#endif /* POLYGONWRITER_H_ */
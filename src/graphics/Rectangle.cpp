@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Rectangle.h"
 #include "Serializer.h"
 #include <stdexcept>
@@ -70,6 +71,7 @@ Box Rectangle::GetBox() const {
 }
 
 std::unique_ptr<Aperture> Rectangle::Clone() const {
+	Instrument::Count("clone", "Rectangle");
 	return std::make_unique<Rectangle>(*this);
 }
 
@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Region.h"
 #include "Serializer.h"
 #include <stdexcept>
@@ -94,6 +95,7 @@ void Region::ApplyTransform(const gerbex::Transform &transform) {
 }
 
 std::unique_ptr<GraphicalObject> Region::Clone() {
+	Instrument::Count("clone", "Region");
 	return std::make_unique<Region>(*this);
 }
 
@@ -18,6 +18,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "Instrument.h"
 #include "Segment.h"
 #include <algorithm>
 
@@ -68,6 +69,7 @@ bool Segment::operator !=(const Segment &rhs) const {
 }
 
 std::unique_ptr<Segment> Segment::Clone() {
+	Instrument::Count("clone", "Segment");
 	return std::make_unique<Segment>(*this);
 }
 
@@ -0,0 +1,36 @@
+/*
+ * Serializer.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Serializer.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace gerbex {
+
+void Serializer::SaveFile(const std::string &path) {
+	std::ofstream stream(path, std::ios::binary);
+	if (!stream.good()) {
+		throw std::invalid_argument("failed to open " + path);
+	}
+	Save(stream, std::filesystem::path(path).extension().string());
+}
+
+} /* namespace gerbex */
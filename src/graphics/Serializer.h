@@ -23,6 +23,7 @@
 
 #include "GraphicalObject.h"
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -61,7 +62,10 @@ public:
 	virtual void AddPolygon(pSerialItem target,
 			const std::vector<Point> &points) = 0;
 	virtual pSerialItem GetTarget(Polarity polarity) = 0;
-	virtual void SaveFile(const std::string &path) = 0;
+	// Writes the result in the format named by a file extension, such as ".svg"
+	virtual void Save(std::ostream &stream, const std::string &extension) = 0;
+	// Writes the result to a file, in the format of its extension
+	virtual void SaveFile(const std::string &path);
 };
 
 } /* namespace gerbex */
@@ -0,0 +1,38 @@
+/*
+ * StringTable.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StringTable.h"
+
+namespace gerbex {
+
+StringTable::StringTable() :
+		m_strings { } {
+}
+
+const std::string* StringTable::Intern(const std::string &text) {
+	// Elements of an unordered_set keep their address when it rehashes
+	return &*m_strings.insert(text).first;
+}
+
+size_t StringTable::GetSize() const {
+	return m_strings.size();
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,49 @@
+/*
+ * StringTable.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STRINGTABLE_H_
+#define STRINGTABLE_H_
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+
+namespace gerbex {
+
+/*
+ * Keeps one copy of each distinct string. Interned strings are compared and
+ * hashed by address, and live as long as the table.
+ */
+class StringTable {
+public:
+	StringTable();
+	virtual ~StringTable() = default;
+	StringTable(const StringTable&) = delete;
+	StringTable& operator=(const StringTable&) = delete;
+	const std::string* Intern(const std::string &text);
+	size_t GetSize() const;
+
+private:
+	std::unordered_set<std::string> m_strings;
+};
+
+} /* namespace gerbex */
+
+#endif /* STRINGTABLE_H_ */
@@ -0,0 +1,309 @@
+/*
+ * Tessellator.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Tessellator.h"
+#include "Instrument.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace gerbex {
+
+Tessellator::Tessellator(double tolerance) :
+		m_tolerance { tolerance }, m_shapes { }, m_shared { }, m_found { } {
+	SetTolerance(tolerance);
+}
+
+double Tessellator::GetTolerance() const {
+	return m_tolerance;
+}
+
+void Tessellator::SetTolerance(double tolerance) {
+	if (tolerance <= 0.0) {
+		throw std::invalid_argument("tolerance must be positive");
+	}
+	m_tolerance = tolerance;
+	m_shapes.clear();
+}
+
+int Tessellator::GetSegmentCount(double radius, double sweep) const {
+	sweep = fabs(sweep);
+	double minimum = std::ceil(kMinCircleSegments * sweep / (2.0 * M_PI));
+	if (radius <= m_tolerance) {
+		return static_cast<int>(std::max(1.0, minimum));
+	}
+	// A chord spanning angle a deviates r * (1 - cos(a / 2)) from the arc
+	double step = 2.0 * std::acos(1.0 - m_tolerance / radius);
+	double count = std::max( { 1.0, minimum, std::ceil(sweep / step) });
+	return static_cast<int>(count);
+}
+
+std::vector<Point> Tessellator::MakeArc(const Point &center, double radius,
+		double start, double end) const {
+	int segments = GetSegmentCount(radius, end - start);
+	double step = (end - start) / segments;
+	std::vector<Point> vertices;
+	vertices.reserve(segments + 1);
+	for (int i = 0; i <= segments; i++) {
+		double angle = start + i * step;
+		vertices.push_back(
+				Point(center.GetX() + radius * cos(angle),
+						center.GetY() + radius * sin(angle)));
+	}
+	return vertices;
+}
+
+std::vector<Point> Tessellator::MakeCircle(const Point &center,
+		double radius) const {
+	ShapeKey key { Shape::Circle, { radius, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+	const Outline *cached = findShape(key);
+	if (cached) {
+		return translate(cached->boundary, center);
+	}
+	std::vector<Point> vertices = MakeArc(Point(), radius, 0.0, 2.0 * M_PI);
+	vertices.pop_back();
+	cacheShape(key, Outline(vertices));
+	return translate(vertices, center);
+}
+
+Outline Tessellator::MakeDraw(const Segment &segment, double width) const {
+	Point start = segment.GetStart();
+	Point delta = segment.GetEnd() - start;
+	ShapeKey key { Shape::Draw, { delta.GetX(), delta.GetY(), width, 0.0, 0.0,
+			0.0 } };
+	const Outline *cached = findShape(key);
+	if (cached) {
+		return translate(*cached, start);
+	}
+	Outline outline = makeDraw(Point(), delta, width);
+	cacheShape(key, outline);
+	return translate(outline, start);
+}
+
+Outline Tessellator::MakeArcDraw(const ArcSegment &segment,
+		double width) const {
+	Point center = segment.GetCenter();
+	Point start = segment.GetStart() - center;
+	Point end = segment.GetEnd() - center;
+	double direction =
+			segment.GetDirection() == ArcDirection::Clockwise ? -1.0 : 1.0;
+	ShapeKey key { Shape::Arc, { start.GetX(), start.GetY(), end.GetX(),
+			end.GetY(), width, direction } };
+	const Outline *cached = findShape(key);
+	if (cached) {
+		return translate(*cached, center);
+	}
+	Outline outline = makeArcDraw(
+			ArcSegment(start, end, segment.GetCenterOffset(),
+					segment.GetDirection()), width);
+	cacheShape(key, outline);
+	return translate(outline, center);
+}
+
+std::vector<Point> Tessellator::MakeContour(const Contour &contour) const {
+	if (contour.IsCircle()) {
+		Instrument::Count("cast", "Tessellator::MakeContour");
+		const std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<
+				ArcSegment>(contour.GetSegments().back());
+		return MakeCircle(arc->GetCenter(), arc->GetRadius());
+	}
+
+	std::vector<Point> poly;
+	for (std::shared_ptr<Segment> seg : contour.GetSegments()) {
+		Instrument::Count("cast", "Tessellator::MakeContour");
+		std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<ArcSegment>(
+				seg);
+		if (arc) {
+			Point start = arc->GetStart();
+			Point end = arc->GetEnd();
+			Point center = arc->GetCenter();
+			double startAngle = atan2(start.GetY() - center.GetY(),
+					start.GetX() - center.GetX());
+			double endAngle = atan2(end.GetY() - center.GetY(),
+					end.GetX() - center.GetX());
+			if (arc->GetDirection() == ArcDirection::Clockwise
+					&& endAngle > startAngle) {
+				endAngle -= 2.0 * M_PI;
+			} else if (arc->GetDirection() == ArcDirection::CounterClockwise
+					&& endAngle < startAngle) {
+				endAngle += 2.0 * M_PI;
+			}
+			std::vector<Point> arcPoints = MakeArc(center, arc->GetRadius(),
+					startAngle, endAngle);
+			arcPoints.pop_back();
+			poly.insert(poly.end(), arcPoints.begin(), arcPoints.end());
+		} else {
+			poly.push_back(seg->GetStart());
+		}
+	}
+	return poly;
+}
+
+size_t Tessellator::GetCachedShapes() const {
+	return m_shapes.size();
+}
+
+void Tessellator::SetShapeCache(std::shared_ptr<ShapeCache> shapes) {
+	m_shared = shapes;
+}
+
+Outline Tessellator::makeDraw(const Point &start, const Point &end,
+		double width) const {
+	double angle = atan2(end.GetY() - start.GetY(), end.GetX() - start.GetX());
+	double radius = 0.5 * width;
+	std::vector<Point> startCap = MakeArc(start, radius, angle + M_PI_2,
+			angle + 3.0 * M_PI_2);
+	std::vector<Point> endCap = MakeArc(end, radius, angle - M_PI_2,
+			angle + M_PI_2);
+
+	std::vector<Point> poly;
+	poly.insert(poly.end(), startCap.begin(), startCap.end());
+	poly.insert(poly.end(), endCap.begin(), endCap.end());
+	return Outline(poly);
+}
+
+Outline Tessellator::makeArcDraw(const ArcSegment &segment,
+		double width) const {
+	if (segment.IsCircle()) {
+		Point c = segment.GetCenter();
+		double r = segment.GetRadius();
+		double dr = 0.5 * width;
+		Outline circle(MakeCircle(c, r + dr));
+		circle.holes.push_back(MakeCircle(c, r - dr));
+		return circle;
+	}
+
+	Point start = segment.GetStart();
+	Point end = segment.GetEnd();
+	Point center = segment.GetCenter();
+	if (segment.GetDirection() == ArcDirection::Clockwise) {
+		start = segment.GetEnd();
+		end = segment.GetStart();
+	}
+	double startAngle = atan2(start.GetY() - center.GetY(),
+			start.GetX() - center.GetX());
+	double endAngle = atan2(end.GetY() - center.GetY(),
+			end.GetX() - center.GetX());
+	double capRadius = 0.5 * width;
+	double outerRadius = segment.GetRadius() + capRadius;
+	double innerRadius = segment.GetRadius() - capRadius;
+	std::vector<Point> startCap = MakeArc(start, capRadius, startAngle - M_PI,
+			startAngle);
+	startCap.pop_back();
+	std::vector<Point> outerArc = MakeArc(center, outerRadius, startAngle,
+			endAngle);
+	outerArc.pop_back();
+	std::vector<Point> endCap = MakeArc(end, capRadius, endAngle,
+			endAngle + M_PI);
+	endCap.pop_back();
+	std::vector<Point> innerArc = MakeArc(center, innerRadius, endAngle,
+			startAngle);
+	innerArc.pop_back();
+
+	std::vector<Point> poly;
+	poly.insert(poly.end(), startCap.begin(), startCap.end());
+	poly.insert(poly.end(), outerArc.begin(), outerArc.end());
+	poly.insert(poly.end(), endCap.begin(), endCap.end());
+	poly.insert(poly.end(), innerArc.begin(), innerArc.end());
+	return Outline(poly);
+}
+
+const Outline* Tessellator::findShape(const ShapeKey &key) const {
+	auto shape = m_shapes.find(key);
+	if (shape != m_shapes.end()) {
+		return &shape->second;
+	}
+	if (!m_shared || m_shared->GetTolerance() != m_tolerance) {
+		return nullptr;
+	}
+	m_found = m_shared->Find(key);
+	if (!m_found.has_value()) {
+		return nullptr;
+	}
+	if (m_shapes.size() < kMaxCachedShapes) {
+		return &m_shapes.emplace(key, *m_found).first->second;
+	}
+	return &*m_found;
+}
+
+void Tessellator::cacheShape(const ShapeKey &key,
+		const Outline &outline) const {
+	// Layers of unique tracks would only fill the cache, so it stops growing
+	if (m_shapes.size() < kMaxCachedShapes) {
+		m_shapes.emplace(key, outline);
+	}
+	if (m_shared && m_shared->GetTolerance() == m_tolerance) {
+		m_shared->Add(key, outline);
+	}
+}
+
+ShapeCache::ShapeCache(double tolerance) :
+		m_tolerance { tolerance }, m_mutex { }, m_shapes { } {
+	if (tolerance <= 0.0) {
+		throw std::invalid_argument("tolerance must be positive");
+	}
+}
+
+double ShapeCache::GetTolerance() const {
+	return m_tolerance;
+}
+
+std::optional<Outline> ShapeCache::Find(const Key &key) const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	auto shape = m_shapes.find(key);
+	if (shape == m_shapes.end()) {
+		return std::nullopt;
+	}
+	return shape->second;
+}
+
+void ShapeCache::Add(const Key &key, const Outline &outline) {
+	std::unique_lock<std::shared_mutex> lock(m_mutex);
+	if (m_shapes.size() < kMaxShapes) {
+		m_shapes.emplace(key, outline);
+	}
+}
+
+size_t ShapeCache::GetSize() const {
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	return m_shapes.size();
+}
+
+std::vector<Point> Tessellator::translate(const std::vector<Point> &points,
+		const Point &offset) {
+	std::vector<Point> translated;
+	translated.reserve(points.size());
+	for (const Point &point : points) {
+		translated.push_back(point + offset);
+	}
+	return translated;
+}
+
+Outline Tessellator::translate(const Outline &outline, const Point &offset) {
+	Outline translated(translate(outline.boundary, offset));
+	for (const std::vector<Point> &hole : outline.holes) {
+		translated.holes.push_back(translate(hole, offset));
+	}
+	return translated;
+}
+
+} /* namespace gerbex */
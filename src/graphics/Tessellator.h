@@ -0,0 +1,124 @@
+/*
+ * Tessellator.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESSELLATOR_H_
+#define TESSELLATOR_H_
+
+#include "ArcSegment.h"
+#include "Contour.h"
+#include "Outline.h"
+#include "Point.h"
+#include "Segment.h"
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Tessellated shapes around the origin, kept for every tessellator of one
+ * tolerance in a process, such as those of the layers a long running
+ * process converts one after another. Thread safe.
+ */
+class ShapeCache {
+public:
+	enum class Shape {
+		Circle, Draw, Arc
+	};
+	typedef std::pair<Shape, std::array<double, 6>> Key;
+	static constexpr size_t kMaxShapes = 65536;
+
+	ShapeCache(double tolerance);
+	virtual ~ShapeCache() = default;
+	ShapeCache(const ShapeCache&) = delete;
+	ShapeCache& operator=(const ShapeCache&) = delete;
+	double GetTolerance() const;
+	// A copy of the cached shape, if any
+	std::optional<Outline> Find(const Key &key) const;
+	void Add(const Key &key, const Outline &outline);
+	size_t GetSize() const;
+
+private:
+	double m_tolerance;
+	mutable std::shared_mutex m_mutex;
+	std::map<Key, Outline> m_shapes;
+};
+
+/*
+ * Approximates arcs and circles with straight segments, using as few
+ * vertices as keep the chord error within a tolerance, in layer units.
+ * Shared by the serializers that output polygons.
+ * Circles and strokes are cached by shape around the origin, so repeated
+ * flashes of an aperture are only translated. Apertures are copied for
+ * every flash, hence the shape rather than the aperture is the key.
+ * Shapes missing from this cache are looked for in a shared ShapeCache of
+ * the same tolerance, when set, and added to it.
+ * Not thread safe, each serializer owns its tessellator.
+ */
+class Tessellator {
+public:
+	static constexpr double kDefaultTolerance = 0.0025;
+	static constexpr int kMinCircleSegments = 8;
+	static constexpr size_t kMaxCachedShapes = 4096;
+
+	Tessellator(double tolerance = kDefaultTolerance);
+	virtual ~Tessellator() = default;
+	double GetTolerance() const;
+	void SetTolerance(double tolerance);
+	int GetSegmentCount(double radius, double sweep) const;
+	// Vertices from start to end angle in radians, including both ends
+	std::vector<Point> MakeArc(const Point &center, double radius,
+			double start, double end) const;
+	// Counter-clockwise vertices, without repeating the first
+	std::vector<Point> MakeCircle(const Point &center, double radius) const;
+	// Outline of a segment stroked with round caps
+	Outline MakeDraw(const Segment &segment, double width) const;
+	// Outline of an arc stroked with round caps, a ring for full circles
+	Outline MakeArcDraw(const ArcSegment &segment, double width) const;
+	// Vertices of a closed contour, without repeating the first
+	std::vector<Point> MakeContour(const Contour &contour) const;
+	size_t GetCachedShapes() const;
+	void SetShapeCache(std::shared_ptr<ShapeCache> shapes);
+
+private:
+	typedef ShapeCache::Shape Shape;
+	typedef ShapeCache::Key ShapeKey;
+	Outline makeDraw(const Point &start, const Point &end, double width) const;
+	Outline makeArcDraw(const ArcSegment &segment, double width) const;
+	const Outline* findShape(const ShapeKey &key) const;
+	void cacheShape(const ShapeKey &key, const Outline &outline) const;
+	static std::vector<Point> translate(const std::vector<Point> &points,
+			const Point &offset);
+	static Outline translate(const Outline &outline, const Point &offset);
+	double m_tolerance;
+	mutable std::map<ShapeKey, Outline> m_shapes;
+	std::shared_ptr<ShapeCache> m_shared;
+	// Holds a shared shape when this cache is full
+	mutable std::optional<Outline> m_found;
+};
+
+} /* namespace gerbex */
+
+#endif /* TESSELLATOR_H_ */
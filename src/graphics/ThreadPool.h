@@ -0,0 +1,73 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Fixed set of worker threads executing submitted tasks in FIFO order.
+ * The destructor waits for all queued tasks to finish.
+ */
+class ThreadPool {
+public:
+	ThreadPool(unsigned int threads = 0);
+	virtual ~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	unsigned int GetThreadCount() const;
+	static unsigned int DefaultThreadCount();
+
+	template<typename F>
+	std::future<std::invoke_result_t<F>> Submit(F &&task) {
+		using Result = std::invoke_result_t<F>;
+		auto packaged = std::make_shared<std::packaged_task<Result()>>(
+				std::forward<F>(task));
+		std::future<Result> result = packaged->get_future();
+		enqueue([packaged]() {
+			(*packaged)();
+		});
+		return result;
+	}
+
+private:
+	void enqueue(std::function<void()> task);
+	void workerLoop();
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping;
+};
+
+} /* namespace gerbex */
+
+#endif /* THREADPOOL_H_ */
@@ -0,0 +1,125 @@
+/*
+ * AttributeDictionary.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AttributeDictionary.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace gerbex {
+
+AttributeDictionary::AttributeDictionary() :
+		m_strings { std::make_shared<StringTable>() }, m_dictionaries { }, m_current { }, m_changed { }, m_sets { } {
+}
+
+void AttributeDictionary::Set(AttributeTarget target, const std::string &name,
+		const std::vector<std::string> &values) {
+	if (name.empty()) {
+		throw std::invalid_argument("attribute requires a name");
+	}
+	AttributeSet::Attribute attribute { m_strings->Intern(name), { } };
+	attribute.values.reserve(values.size());
+	for (const std::string &value : values) {
+		attribute.values.push_back(m_strings->Intern(value));
+	}
+
+	size_t index = static_cast<size_t>(target);
+	Dictionary &dictionary = m_dictionaries[index];
+	auto it = std::find_if(dictionary.begin(), dictionary.end(),
+			[&attribute](const AttributeSet::Attribute &a) {
+				return a.name == attribute.name;
+			});
+	if (it == dictionary.end()) {
+		dictionary.push_back(std::move(attribute));
+	} else if (it->values != attribute.values) {
+		it->values = std::move(attribute.values);
+	} else {
+		return;
+	}
+	m_changed[index] = true;
+}
+
+void AttributeDictionary::Delete(const std::string &name) {
+	for (AttributeTarget target : { AttributeTarget::Aperture,
+			AttributeTarget::Object }) {
+		size_t index = static_cast<size_t>(target);
+		Dictionary &dictionary = m_dictionaries[index];
+		size_t size = dictionary.size();
+		if (name.empty()) {
+			dictionary.clear();
+		} else {
+			dictionary.erase(
+					std::remove_if(dictionary.begin(), dictionary.end(),
+							[&name](const AttributeSet::Attribute &a) {
+								return *a.name == name;
+							}), dictionary.end());
+		}
+		if (dictionary.size() != size) {
+			m_changed[index] = true;
+		}
+	}
+}
+
+std::shared_ptr<const AttributeSet> AttributeDictionary::GetSet(
+		AttributeTarget target) {
+	size_t index = static_cast<size_t>(target);
+	if (m_changed[index]) {
+		m_current[index] = intern(m_dictionaries[index]);
+		m_changed[index] = false;
+	}
+	return m_current[index];
+}
+
+size_t AttributeDictionary::GetSetCount() const {
+	return m_sets.size();
+}
+
+const std::shared_ptr<StringTable>& AttributeDictionary::GetStrings() const {
+	return m_strings;
+}
+
+std::shared_ptr<const AttributeSet> AttributeDictionary::intern(
+		const Dictionary &dictionary) {
+	if (dictionary.empty()) {
+		return nullptr;
+	}
+
+	// Key on the interned addresses, in name order, each attribute ended by null
+	Dictionary sorted = dictionary;
+	std::sort(sorted.begin(), sorted.end(),
+			[](const AttributeSet::Attribute &a,
+					const AttributeSet::Attribute &b) {
+				return *a.name < *b.name;
+			});
+	std::vector<const std::string*> key;
+	for (const AttributeSet::Attribute &attribute : sorted) {
+		key.push_back(attribute.name);
+		key.insert(key.end(), attribute.values.begin(),
+				attribute.values.end());
+		key.push_back(nullptr);
+	}
+
+	std::shared_ptr<const AttributeSet> &set = m_sets[key];
+	if (set == nullptr) {
+		set = std::make_shared<AttributeSet>(m_strings, std::move(sorted));
+	}
+	return set;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,76 @@
+/*
+ * AttributeDictionary.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATTRIBUTEDICTIONARY_H_
+#define ATTRIBUTEDICTIONARY_H_
+
+#include "AttributeSet.h"
+#include "StringTable.h"
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+enum class AttributeTarget {
+	File, Aperture, Object
+};
+
+/*
+ * The attribute dictionaries of a file, as changed by TF, TA, TO and TD.
+ * Aperture and object attributes are handed out as interned sets, so every
+ * object created under the same attributes shares one set, and a set is
+ * only built again once a command changes its dictionary.
+ */
+class AttributeDictionary {
+public:
+	AttributeDictionary();
+	virtual ~AttributeDictionary() = default;
+	AttributeDictionary(const AttributeDictionary&) = delete;
+	AttributeDictionary& operator=(const AttributeDictionary&) = delete;
+	// Adds the attribute, replacing any of the same name
+	void Set(AttributeTarget target, const std::string &name,
+			const std::vector<std::string> &values);
+	// Deletes the named aperture or object attribute, or all of them if empty
+	void Delete(const std::string &name);
+	// The current attributes, null when there are none
+	std::shared_ptr<const AttributeSet> GetSet(AttributeTarget target);
+	// Number of distinct sets handed out
+	size_t GetSetCount() const;
+	const std::shared_ptr<StringTable>& GetStrings() const;
+
+private:
+	typedef std::vector<AttributeSet::Attribute> Dictionary;
+	static constexpr size_t kTargets = 3;
+	std::shared_ptr<const AttributeSet> intern(const Dictionary &dictionary);
+	std::shared_ptr<StringTable> m_strings;
+	std::array<Dictionary, kTargets> m_dictionaries;
+	std::array<std::shared_ptr<const AttributeSet>, kTargets> m_current;
+	std::array<bool, kTargets> m_changed;
+	std::map<std::vector<const std::string*>,
+			std::shared_ptr<const AttributeSet>> m_sets;
+};
+
+} /* namespace gerbex */
+
+#endif /* ATTRIBUTEDICTIONARY_H_ */
@@ -21,10 +21,13 @@
 #include "CommandHandler.h"
 #include "CoordinateData.h"
 #include "DataTypeParser.h"
+#include "Instrument.h"
+#include "MacroCache.h"
 #include "MacroTemplate.h"
 #include <iostream>
 #include <regex>
 #include <stdexcept>
+#include <vector>
 
 namespace gerbex {
 
@@ -77,6 +80,7 @@ void CommandHandler::ApertureDefine(CommandsProcessor &processor,
 	pattern << "(" << DataTypeParser::GetNamePattern() << ")";
 	pattern << "(,(" << DataTypeParser::GetFieldPattern() << "))?";
 
+	Instrument::Count("regex", "CommandHandler::ApertureDefine");
 	std::regex regex(pattern.str());
 	std::smatch match;
 	if (std::regex_search(words.front(), match, regex)) {
@@ -87,23 +91,28 @@ void CommandHandler::ApertureDefine(CommandsProcessor &processor,
 				name);
 		processor.ApertureDefine(ident, aperture->Call(params));
 	} else {
-		throw std::invalid_argument("invalid aperture define");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid aperture define");
 	}
 }
 
 void CommandHandler::ApertureMacro(CommandsProcessor &processor,
 		Fields &words) {
 	std::string pattern = "AM(" + DataTypeParser::GetNamePattern() + ")";
+	Instrument::Count("regex", "CommandHandler::ApertureMacro");
 	std::regex regex(pattern);
 	std::smatch match;
 	if (std::regex_search(words.front(), match, regex)) {
 		std::string name = match[1].str();
 		words.pop_front();
-		std::shared_ptr<MacroTemplate> macro = std::make_shared<MacroTemplate>(
-				words);
+		MacroCache *cache = processor.GetMacroCache();
+		std::shared_ptr<MacroTemplate> macro =
+				cache ? cache->Get(words) : std::make_shared<MacroTemplate>(
+								words);
 		processor.AddTemplate(name, macro);
 	} else {
-		throw std::invalid_argument("invalid aperture macro");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid aperture macro");
 	}
 }
 
@@ -111,6 +120,7 @@ void CommandHandler::SetCurrentAperture(CommandsProcessor &processor,
 		Fields &words) {
 	AssertWordCommand(words);
 	std::smatch match;
+	Instrument::Count("regex", "CommandHandler::SetCurrentAperture");
 	std::regex regex("D(" + DataTypeParser::GetNumberPattern() + ")");
 	if (std::regex_search(words.front(), match, regex)) {
 		int ident = std::stoi(match[1].str());
@@ -182,6 +192,7 @@ void CommandHandler::ApertureTransformations(CommandsProcessor &processor,
 	pattern << "L([PMRS])";
 	pattern << "([CDNXY]+|" << num_re << ")";
 
+	Instrument::Count("regex", "CommandHandler::ApertureTransformations");
 	std::regex regex(pattern.str());
 	std::smatch match;
 	if (std::regex_search(words.front(), match, regex)) {
@@ -202,7 +213,8 @@ void CommandHandler::ApertureTransformations(CommandsProcessor &processor,
 			state.GetTransform().SetScaling(scale);
 		}
 	} else {
-		throw std::invalid_argument("invalid aperture transformation");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid aperture transformation");
 	}
 }
 
@@ -214,7 +226,8 @@ void CommandHandler::RegionStatement(CommandsProcessor &processor,
 	} else if (words.front() == "G37") {
 		processor.EndRegion();
 	} else {
-		throw std::invalid_argument("invalid region statement");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid region statement");
 	}
 }
 
@@ -225,6 +238,7 @@ void CommandHandler::BlockAperture(CommandsProcessor &processor,
 	std::ostringstream pattern;
 	pattern << "AB(D(" << DataTypeParser::GetNumberPattern() << "))?";
 
+	Instrument::Count("regex", "CommandHandler::BlockAperture");
 	std::regex regex(pattern.str());
 	std::smatch match;
 	if (std::regex_search(words.front(), match, regex)) {
@@ -237,7 +251,8 @@ void CommandHandler::BlockAperture(CommandsProcessor &processor,
 			processor.CloseApertureBlock();
 		}
 	} else {
-		throw std::invalid_argument("invalid block aperture statement");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid block aperture statement");
 	}
 }
 
@@ -254,6 +269,7 @@ void CommandHandler::StepAndRepeat(CommandsProcessor &processor,
 	pattern << "J(" << num_re << ")";
 	pattern << ")?";
 
+	Instrument::Count("regex", "CommandHandler::StepAndRepeat");
 	std::regex regex(pattern.str());
 	std::smatch match;
 	if (std::regex_search(words.front(), match, regex)) {
@@ -269,7 +285,8 @@ void CommandHandler::StepAndRepeat(CommandsProcessor &processor,
 			processor.CloseStepAndRepeat();
 		}
 	} else {
-		throw std::invalid_argument("invalid step and repeat statement");
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid step and repeat statement");
 	}
 }
 
@@ -285,4 +302,48 @@ void CommandHandler::ArcMode(CommandsProcessor &processor, Fields &words) {
 	processor.GetGraphicsState().SetArcMode(mode);
 }
 
+void CommandHandler::Attribute(CommandsProcessor &processor, Fields &words) {
+	AssertWordCommand(words);
+
+	// Split by hand rather than by regex, nearly every object has attributes
+	const std::string &word = words.front();
+	std::string code = word.substr(0, 2);
+	std::vector<std::string> fields;
+	size_t start = 2;
+	while (true) {
+		size_t end = word.find(',', start);
+		fields.push_back(word.substr(start, end - start));
+		if (end == std::string::npos) {
+			break;
+		}
+		start = end + 1;
+	}
+	std::string name = fields.front();
+	fields.erase(fields.begin());
+	if (name.empty() && code != "TD") {
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"attribute requires a name");
+		return;
+	}
+
+	AttributeDictionary &dictionary = processor.GetAttributeDictionary();
+	if (code == "TF") {
+		dictionary.Set(AttributeTarget::File, name, fields);
+	} else if (code == "TA") {
+		dictionary.Set(AttributeTarget::Aperture, name, fields);
+	} else if (code == "TO") {
+		dictionary.Set(AttributeTarget::Object, name, fields);
+	} else if (code == "TD") {
+		if (!fields.empty()) {
+			processor.GetDiagnostics().Report(Severity::Warning,
+					"TD takes only an attribute name");
+			return;
+		}
+		dictionary.Delete(name);
+	} else {
+		processor.GetDiagnostics().Report(Severity::Warning,
+				"invalid attribute command " + code);
+	}
+}
+
 } /* namespace gerbex */
@@ -54,6 +54,7 @@ public:
 	static void BlockAperture(CommandsProcessor &processor, Fields &words);
 	static void StepAndRepeat(CommandsProcessor &processor, Fields &words);
 	static void EndOfFile(CommandsProcessor &processor, Fields &words);
+	static void Attribute(CommandsProcessor &processor, Fields &words);
 };
 
 } /* namespace gerbex */
@@ -35,12 +35,14 @@ namespace gerbex {
 
 CommandsProcessor::CommandsProcessor() :
 		m_commandState { CommandState::Normal }, m_graphicsState { }, m_objects { }, m_apertures { }, m_templates { }, m_activeRegion {
-				nullptr }, m_openBlocks { 0 } {
+				nullptr }, m_openBlocks { 0 }, m_clones { 0 }, m_macroCache {
+				nullptr }, m_attributes { }, m_netIndex { std::make_shared<NetIndex>() }, m_diagnostics { } {
 	m_templates["C"] = std::make_unique<CircleTemplate>();
 	m_templates["R"] = std::make_unique<RectangleTemplate>();
 	m_templates["O"] = std::make_unique<ObroundTemplate>();
 	m_templates["P"] = std::make_unique<PolygonTemplate>();
 	m_objectDest.push(&m_objects);
+	m_graphicsState.SetDiagnostics(&m_diagnostics);
 }
 
 CommandsProcessor::~CommandsProcessor() {
@@ -57,6 +59,7 @@ void CommandsProcessor::ApertureDefine(int ident,
 		throw std::invalid_argument("aperture ident must be >= 10");
 	}
 	if (m_apertures.find(ident) == m_apertures.end()) {
+		aperture->SetAttributes(m_attributes.GetSet(AttributeTarget::Aperture));
 		m_apertures[ident] = aperture;
 	} else {
 		throw std::invalid_argument("aperture ident already used");
@@ -99,9 +102,11 @@ void CommandsProcessor::PlotDraw(const Point &coord) {
 		std::shared_ptr<Aperture> clone =
 				m_graphicsState.GetCurrentAperture()->Clone();
 		clone->ApplyTransform(m_graphicsState.GetTransform());
+		m_clones++;
 		std::shared_ptr<Draw> obj = std::make_shared<Draw>(*segment, clone);
 		obj->SetPolarity(m_graphicsState.GetPolarity());
-		m_objectDest.top()->push_back(obj);
+		obj->SetAttributes(m_attributes.GetSet(AttributeTarget::Object));
+		addObject(obj);
 	} else {
 		m_activeRegion->AddSegment(segment);
 	}
@@ -134,9 +139,11 @@ void CommandsProcessor::PlotArc(const Point &coord, const Point &offset) {
 		std::shared_ptr<Aperture> clone =
 				m_graphicsState.GetCurrentAperture()->Clone();
 		clone->ApplyTransform(m_graphicsState.GetTransform());
+		m_clones++;
 		std::shared_ptr<Arc> obj = std::make_shared<Arc>(*segment, clone);
 		obj->SetPolarity(m_graphicsState.GetPolarity());
-		m_objectDest.top()->push_back(obj);
+		obj->SetAttributes(m_attributes.GetSet(AttributeTarget::Object));
+		addObject(obj);
 	} else {
 		m_activeRegion->AddSegment(segment);
 	}
@@ -159,10 +166,12 @@ void CommandsProcessor::Flash(const Point &coord) {
 	std::unique_ptr<Aperture> clone =
 			m_graphicsState.GetCurrentAperture()->Clone();
 	clone->ApplyTransform(m_graphicsState.GetTransform());
+	m_clones++;
 	std::shared_ptr<gerbex::Flash> obj = std::make_shared<gerbex::Flash>(coord,
 			std::move(clone));
 	obj->SetPolarity(m_graphicsState.GetPolarity());
-	m_objectDest.top()->push_back(obj);
+	obj->SetAttributes(m_attributes.GetSet(AttributeTarget::Object));
+	addObject(obj);
 	m_graphicsState.SetCurrentPoint(coord);
 }
 
@@ -214,7 +223,8 @@ void CommandsProcessor::EndRegion() {
 	if (m_commandState != CommandState::InsideRegion) {
 		throw std::logic_error("cannot end region; not inside a region");
 	}
-	m_objectDest.top()->push_back(std::move(m_activeRegion));
+	m_activeRegion->SetAttributes(m_attributes.GetSet(AttributeTarget::Object));
+	addObject(std::move(m_activeRegion));
 	m_commandState = CommandState::Normal;
 }
 
@@ -248,7 +258,16 @@ void CommandsProcessor::OpenStepAndRepeat(int nx, int ny, double dx,
 void CommandsProcessor::CloseStepAndRepeat() {
 	if (m_activeStepAndRepeat != nullptr) {
 		m_objectDest.pop();
+		size_t first = m_objectDest.top()->size();
 		m_activeStepAndRepeat->ExpandObjects(*m_objectDest.top());
+		if (m_objectDest.top() == &m_objects) {
+			for (size_t i = first; i < m_objects.size(); i++) {
+				m_netIndex->Add(i, m_objects[i]->GetAttributes());
+			}
+		}
+		m_clones += (uint64_t) m_activeStepAndRepeat->GetNx()
+				* m_activeStepAndRepeat->GetNy()
+				* m_activeStepAndRepeat->GetObjectList()->size();
 		m_activeStepAndRepeat.reset();
 		m_graphicsState.SetCurrentPoint(std::nullopt);
 	} else {
@@ -267,4 +286,40 @@ Box CommandsProcessor::GetBox() const {
 	return box;
 }
 
+size_t CommandsProcessor::GetApertureCount() const {
+	return m_apertures.size();
+}
+
+uint64_t CommandsProcessor::GetCloneCount() const {
+	return m_clones;
+}
+
+void CommandsProcessor::SetMacroCache(MacroCache *cache) {
+	m_macroCache = cache;
+}
+
+MacroCache* CommandsProcessor::GetMacroCache() const {
+	return m_macroCache;
+}
+
+AttributeDictionary& CommandsProcessor::GetAttributeDictionary() {
+	return m_attributes;
+}
+
+Diagnostics& CommandsProcessor::GetDiagnostics() {
+	return m_diagnostics;
+}
+
+std::shared_ptr<const NetIndex> CommandsProcessor::GetNetIndex() const {
+	return m_netIndex;
+}
+
+void CommandsProcessor::addObject(std::shared_ptr<GraphicalObject> object) {
+	std::vector<std::shared_ptr<GraphicalObject>> *dest = m_objectDest.top();
+	if (dest == &m_objects) {
+		m_netIndex->Add(m_objects.size(), object->GetAttributes());
+	}
+	dest->push_back(std::move(object));
+}
+
 } /* namespace gerbex */
@@ -23,11 +23,17 @@
 
 #include "Aperture.h"
 #include "ApertureTemplate.h"
+#include "AttributeDictionary.h"
 #include "Box.h"
+#include "Diagnostics.h"
 #include "GraphicalObject.h"
 #include "GraphicsState.h"
+#include "MacroCache.h"
+#include "NetIndex.h"
 #include "Region.h"
 #include "StepAndRepeat.h"
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <stack>
@@ -70,8 +76,21 @@ public:
 	virtual void OpenStepAndRepeat(int nx, int ny, double dx, double dy);
 	virtual void CloseStepAndRepeat();
 	virtual Box GetBox() const;
+	virtual size_t GetApertureCount() const;
+	// Apertures cloned for objects and objects cloned by step and repeat
+	virtual uint64_t GetCloneCount() const;
+	// Macros are taken from the cache, when set, rather than compiled
+	virtual void SetMacroCache(MacroCache *cache);
+	virtual MacroCache* GetMacroCache() const;
+	// Attributes given to apertures as defined and objects as created
+	virtual AttributeDictionary& GetAttributeDictionary();
+	// Problems found in the commands, reported rather than thrown
+	virtual Diagnostics& GetDiagnostics();
+	// Nets and components of the objects, outside of blocks
+	virtual std::shared_ptr<const NetIndex> GetNetIndex() const;
 
 private:
+	void addObject(std::shared_ptr<GraphicalObject> object);
 	CommandState m_commandState;
 	GraphicsState m_graphicsState;
 	std::stack<std::vector<std::shared_ptr<GraphicalObject>>*> m_objectDest;
@@ -81,6 +100,11 @@ private:
 	std::unique_ptr<Region> m_activeRegion;
 	std::unique_ptr<StepAndRepeat> m_activeStepAndRepeat;
 	int m_openBlocks;
+	uint64_t m_clones;
+	MacroCache *m_macroCache;
+	AttributeDictionary m_attributes;
+	std::shared_ptr<NetIndex> m_netIndex;
+	Diagnostics m_diagnostics;
 };
 
 } /* namespace gerbex */
@@ -20,6 +20,7 @@
 
 #include "CoordinateData.h"
 #include "DataTypeParser.h"
+#include "Instrument.h"
 
 #include <ostream>
 #include <regex>
@@ -49,6 +50,7 @@ CoordinateData CoordinateData::FromString(const std::string &str) {
 	pattern << "(Y(" << num_re << "))?";
 	pattern << "(I(" << num_re << ")J(" << num_re << "))?";
 
+	Instrument::Count("regex", "CoordinateData::FromString");
 	std::regex regex(pattern.str());
 	std::smatch match;
 	std::regex_search(str, match, regex);
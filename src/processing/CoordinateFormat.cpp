@@ -19,6 +19,7 @@
  */
 
 #include "CoordinateFormat.h"
+#include "Instrument.h"
 #include <cmath>
 #include <regex>
 #include <stdexcept>
@@ -60,6 +61,7 @@ double CoordinateFormat::Convert(FixedPointType value) const {
 }
 
 CoordinateFormat CoordinateFormat::FromCommand(const std::string &str) {
+	Instrument::Count("regex", "CoordinateFormat::FromCommand");
 	std::regex pattern("FS([A-Z]{2})X([0-9]{2})Y([0-9]{2})");
 	std::smatch match;
 	if (std::regex_search(str, match, pattern)) {
@@ -0,0 +1,136 @@
+/*
+ * Diagnostics.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Diagnostics.h"
+#include <iostream>
+
+namespace gerbex {
+
+static const char *SEVERITY_NAMES[] = { "WARNING", "ERROR" };
+
+Diagnostics::Diagnostics() :
+		m_stream { &std::cerr }, m_limit { kDefaultLimit }, m_line { 0 }, m_code { }, m_word { }, m_counts { 0, 0 }, m_suppressed { 0 }, m_diagnostics { }, m_seen { }, m_order { }, m_buffer { } {
+}
+
+Diagnostics::~Diagnostics() {
+	Flush();
+}
+
+void Diagnostics::SetStream(std::ostream *stream) {
+	Flush();
+	m_stream = stream;
+}
+
+void Diagnostics::SetLimit(size_t limit) {
+	m_limit = limit;
+}
+
+void Diagnostics::SetCommand(int line, const std::string &code,
+		const std::string &word) {
+	m_line = line;
+	m_code = code;
+	m_word = word;
+}
+
+void Diagnostics::Report(Severity severity, const std::string &message) {
+	size_t index = static_cast<size_t>(severity);
+	m_counts[index]++;
+	if (m_diagnostics.size() < kMaxKept) {
+		m_diagnostics.push_back( { severity, m_line, m_code, message });
+	}
+
+	// Keyed by severity and message alone, the word differs every time
+	std::string key = SEVERITY_NAMES[index];
+	key += ' ';
+	key += message;
+	size_t &seen = m_seen[key];
+	if (seen == 0) {
+		m_order.push_back(key);
+	}
+	seen++;
+	if (seen > m_limit) {
+		m_suppressed++;
+		return;
+	}
+
+	std::string text = SEVERITY_NAMES[index];
+	if (m_line > 0) {
+		text += " line " + std::to_string(m_line) + ":";
+	}
+	text += ' ';
+	text += message;
+	if (!m_word.empty()) {
+		text += ": ";
+		text += m_word;
+	}
+	text += '\n';
+	write(text);
+}
+
+size_t Diagnostics::GetCount(Severity severity) const {
+	return m_counts[static_cast<size_t>(severity)];
+}
+
+size_t Diagnostics::GetSuppressed() const {
+	return m_suppressed;
+}
+
+const std::vector<Diagnostic>& Diagnostics::GetDiagnostics() const {
+	return m_diagnostics;
+}
+
+void Diagnostics::Flush() {
+	if (m_stream != nullptr && !m_buffer.empty()) {
+		m_stream->write(m_buffer.data(), m_buffer.size());
+		m_stream->flush();
+	}
+	m_buffer.clear();
+}
+
+void Diagnostics::WriteSummary() {
+	size_t warnings = m_counts[static_cast<size_t>(Severity::Warning)];
+	size_t errors = m_counts[static_cast<size_t>(Severity::Error)];
+	if (warnings + errors > 0) {
+		if (m_suppressed > 0) {
+			for (const std::string &key : m_order) {
+				size_t seen = m_seen[key];
+				if (seen > m_limit) {
+					write(key + " (" + std::to_string(seen - m_limit)
+							+ " more)\n");
+				}
+			}
+		}
+		write(std::to_string(warnings) + " warnings, " + std::to_string(errors)
+				+ " errors\n");
+	}
+	Flush();
+}
+
+void Diagnostics::write(const std::string &text) {
+	if (m_stream == nullptr) {
+		return;
+	}
+	m_buffer += text;
+	if (m_buffer.size() >= kBufferSize) {
+		Flush();
+	}
+}
+
+} /* namespace gerbex */
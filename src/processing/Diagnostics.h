@@ -0,0 +1,96 @@
+/*
+ * Diagnostics.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIAGNOSTICS_H_
+#define DIAGNOSTICS_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gerbex {
+
+enum class Severity {
+	Warning, Error
+};
+
+struct Diagnostic {
+	Severity severity;
+	// Line of the command in the file, 0 when outside of a command
+	int line;
+	std::string code;
+	std::string message;
+};
+
+/*
+ * Collects the problems found while processing a file, so handlers report a
+ * recoverable problem and carry on rather than throw. Output is buffered and
+ * written a block at a time, and only the first few of each message are
+ * written, the rest being counted in a summary at the end. Not thread safe,
+ * each file keeps its own.
+ */
+class Diagnostics {
+public:
+	static constexpr size_t kDefaultLimit = 10;
+	static constexpr size_t kMaxKept = 1000;
+	static constexpr size_t kBufferSize = 16384;
+
+	Diagnostics();
+	virtual ~Diagnostics();
+	Diagnostics(const Diagnostics&) = delete;
+	Diagnostics& operator=(const Diagnostics&) = delete;
+	// Where diagnostics are written, std::cerr by default, or null for nowhere
+	void SetStream(std::ostream *stream);
+	// Times each message is written before it is only counted
+	void SetLimit(size_t limit);
+	// The command reported on until the next, its word copied, empty for none
+	void SetCommand(int line, const std::string &code, const std::string &word);
+	void Report(Severity severity, const std::string &message);
+	size_t GetCount(Severity severity) const;
+	// Reports counted but not written
+	size_t GetSuppressed() const;
+	// The first kMaxKept reports
+	const std::vector<Diagnostic>& GetDiagnostics() const;
+	// Writes what is buffered
+	void Flush();
+	// Writes the counts, and those of each message not written, then flushes
+	void WriteSummary();
+
+private:
+	void write(const std::string &text);
+	std::ostream *m_stream;
+	size_t m_limit;
+	int m_line;
+	std::string m_code;
+	std::string m_word;
+	size_t m_counts[2];
+	size_t m_suppressed;
+	std::vector<Diagnostic> m_diagnostics;
+	// Reports of each severity and message, in the order first seen
+	std::unordered_map<std::string, size_t> m_seen;
+	std::vector<std::string> m_order;
+	std::string m_buffer;
+};
+
+} /* namespace gerbex */
+
+#endif /* DIAGNOSTICS_H_ */
@@ -18,15 +18,16 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
 #include "CommandHandler.h"
 #include "DataTypeParser.h"
 #include "FileParser.h"
 #include "FileProcessor.h"
+#include "Instrument.h"
 
 namespace gerbex {
 
-FileProcessor::FileProcessor() {
+FileProcessor::FileProcessor() :
+		m_stats { nullptr } {
 	m_handlers = {
 		{"G04", CommandHandler::Comment},
 		{"MO", CommandHandler::Unit},
@@ -51,10 +52,10 @@ FileProcessor::FileProcessor() {
 		{"AB", CommandHandler::BlockAperture},
 		{"SR", CommandHandler::StepAndRepeat},
 		{"M02", CommandHandler::EndOfFile},
-		{"TF", CommandHandler::NotImplemented},
-		{"TA", CommandHandler::NotImplemented},
-		{"TO", CommandHandler::NotImplemented},
-		{"TD", CommandHandler::NotImplemented}
+		{"TF", CommandHandler::Attribute},
+		{"TA", CommandHandler::Attribute},
+		{"TO", CommandHandler::Attribute},
+		{"TD", CommandHandler::Attribute}
 	};
 }
 
@@ -64,33 +65,84 @@ FileProcessor::~FileProcessor() {
 
 void FileProcessor::Process(std::istream &stream) {
 	FileParser parser(stream);
+	Instrument::Scope scope(Instrument::Subsystem::Lex);
+	// Only read the clock when keeping stats
+	Stats::Clock::time_point mark;
+	if (m_stats) {
+		mark = Stats::Clock::now();
+	}
+	Diagnostics &diagnostics = m_processor.GetDiagnostics();
 	while (true) {
+		scope.Set(Instrument::Subsystem::Lex);
 		Fields words = parser.GetNextCommand();
+		if (m_stats) {
+			mark = m_stats->AddTime("lex", mark);
+		}
 
 		if (words.empty()) {
 			break;	// EOF
 		}
+		std::string code;
 		try {
-			std::string code = DataTypeParser::GetCommandCode(words.front());
+			code = DataTypeParser::GetCommandCode(words.front());
+			// Copied before dispatch, handlers consume the words
+			diagnostics.SetCommand(parser.GetCurrentLine(), code,
+					words.front());
 			auto handler = m_handlers.find(code);
+			if (m_stats) {
+				mark = m_stats->AddTime("dispatch", mark);
+			}
 			if (handler != m_handlers.end()) {
+				scope.Set(Instrument::Subsystem::Commands);
 				handler->second(m_processor, words);
+				if (m_stats) {
+					mark = m_stats->AddCommand(code, mark);
+				}
 			} else {
-				throw std::invalid_argument("unsupported command " + code);
+				diagnostics.Report(Severity::Warning,
+						"unsupported command " + code);
 			}
 		} catch (const std::invalid_argument &ex) {
-			std::cerr << "WARNING line " << parser.GetCurrentLine() << ": " << ex.what() << ": " << words.front() << std::endl;
+			if (code.empty()) {
+				diagnostics.SetCommand(parser.GetCurrentLine(), code,
+						words.front());
+			}
+			diagnostics.Report(Severity::Warning, ex.what());
+			if (m_stats) {
+				mark = Stats::Clock::now();
+			}
 			continue;
 		} catch (const std::logic_error &ex) {
-			std::cerr << "ERROR line " << parser.GetCurrentLine() << ": " << ex.what() << ": " << words.front() << std::endl;
+			if (code.empty()) {
+				diagnostics.SetCommand(parser.GetCurrentLine(), code,
+						words.front());
+			}
+			diagnostics.Report(Severity::Error, ex.what());
 			break;
 		}
 	}
+	diagnostics.SetCommand(0, "", "");
+	diagnostics.WriteSummary();
+	if (m_stats) {
+		if (diagnostics.GetCount(Severity::Warning) > 0) {
+			m_stats->Count("warnings", diagnostics.GetCount(Severity::Warning));
+		}
+		if (diagnostics.GetCount(Severity::Error) > 0) {
+			m_stats->Count("errors", diagnostics.GetCount(Severity::Error));
+		}
+		m_stats->Count("apertures", m_processor.GetApertureCount());
+		m_stats->Count("clones", m_processor.GetCloneCount());
+		m_stats->CountObjects(m_processor.GetObjects());
+	}
 }
 
 CommandsProcessor& FileProcessor::GetProcessor() {
 	return m_processor;
 }
 
+void FileProcessor::SetStats(Stats *stats) {
+	m_stats = stats;
+}
+
 } /* namespace gerbex */
 
@@ -22,6 +22,7 @@
 #define FILEPROCESSOR_H_
 
 #include "CommandsProcessor.h"
+#include "Stats.h"
 #include <memory>
 #include <unordered_map>
 #include "CommandHandler.h"
@@ -37,10 +38,13 @@ public:
 	virtual ~FileProcessor();
 	void Process(std::istream &stream);
 	CommandsProcessor& GetProcessor();
+	// Times and counts what Process does into stats, when not null
+	void SetStats(Stats *stats);
 
 private:
 	CommandsProcessor m_processor;
 	std::unordered_map<std::string, callHandler> m_handlers;
+	Stats *m_stats;
 };
 
 } /* namespace gerbex */
@@ -26,7 +26,7 @@ namespace gerbex {
 
 GraphicsState::GraphicsState() :
 		m_format { }, m_unit { }, m_currentPoint { }, m_currentAperture { }, m_plotState { }, m_transform { }, m_polarity {
-				Polarity::Dark } {
+				Polarity::Dark }, m_diagnostics { nullptr } {
 	// Empty
 }
 
@@ -141,16 +141,14 @@ Point GraphicsState::GetPoint(const CoordinateData &data) const {
 void GraphicsState::AssertPlotState() {
 	if (!m_plotState.has_value()) {
 		SetPlotState(gerbex::PlotState::Linear);
-		std::cerr << "WARNING plot state was not defined, assuming linear"
-				<< std::endl;
+		warn("plot state was not defined, assuming linear");
 	}
 }
 
 void GraphicsState::AssertArcMode() {
 	if (!m_arcMode.has_value()) {
 		SetArcMode(gerbex::ArcMode::MultiQuadrant);
-		std::cerr << "WARNING arc mode was not defined, assuming multi-quadrant"
-				<< std::endl;
+		warn("arc mode was not defined, assuming multi-quadrant");
 	}
 }
 
@@ -162,5 +160,16 @@ void GraphicsState::SetPolarity(Polarity polarity) {
 	m_polarity = polarity;
 }
 
-} /* namespace gerbex */
+void GraphicsState::SetDiagnostics(Diagnostics *diagnostics) {
+	m_diagnostics = diagnostics;
+}
 
+void GraphicsState::warn(const std::string &message) {
+	if (m_diagnostics) {
+		m_diagnostics->Report(Severity::Warning, message);
+	} else {
+		std::cerr << "WARNING " << message << "\n";
+	}
+}
+
+} /* namespace gerbex */
@@ -24,6 +24,7 @@
 #include "Aperture.h"
 #include "CoordinateData.h"
 #include "CoordinateFormat.h"
+#include "Diagnostics.h"
 #include "GraphicalObject.h"
 #include "Point.h"
 #include "Transform.h"
@@ -78,8 +79,11 @@ public:
 	void AssertArcMode();
 	Polarity GetPolarity() const;
 	void SetPolarity(Polarity polarity);
+	// Where assumed defaults are reported, standard error when null
+	void SetDiagnostics(Diagnostics *diagnostics);
 
 private:
+	void warn(const std::string &message);
 	std::optional<CoordinateFormat> m_format;
 	std::optional<Unit> m_unit;
 	std::optional<Point> m_currentPoint;
@@ -88,6 +92,7 @@ private:
 	std::optional<ArcMode> m_arcMode;
 	Transform m_transform;
 	Polarity m_polarity;
+	Diagnostics *m_diagnostics;
 };
 
 } /* namespace gerbex */
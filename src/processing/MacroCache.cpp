@@ -0,0 +1,53 @@
+/*
+ * MacroCache.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MacroCache.h"
+
+namespace gerbex {
+
+MacroCache::MacroCache() :
+		m_mutex { }, m_templates { } {
+}
+
+std::shared_ptr<MacroTemplate> MacroCache::Get(const Fields &body) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found = m_templates.find(body);
+		if (found != m_templates.end()) {
+			return found->second;
+		}
+	}
+	// Compiled unlocked, two threads may both compile a new body
+	std::shared_ptr<MacroTemplate> macro = std::make_shared<MacroTemplate>(
+			body);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// Files of generated macros would only fill the cache, so it stops growing
+	if (m_templates.size() < kMaxTemplates) {
+		return m_templates.emplace(body, macro).first->second;
+	}
+	return macro;
+}
+
+size_t MacroCache::GetSize() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_templates.size();
+}
+
+} /* namespace gerbex */
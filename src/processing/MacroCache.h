@@ -0,0 +1,56 @@
+/*
+ * MacroCache.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MACROCACHE_H_
+#define MACROCACHE_H_
+
+#include "DataTypeParser.h"
+#include "MacroTemplate.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace gerbex {
+
+/*
+ * Compiled macro templates shared by the files a process reads, keyed by
+ * the macro body, so a macro seen in an earlier file is not compiled again
+ * whatever it is named. Thread safe.
+ */
+class MacroCache {
+public:
+	static constexpr size_t kMaxTemplates = 1024;
+
+	MacroCache();
+	virtual ~MacroCache() = default;
+	MacroCache(const MacroCache&) = delete;
+	MacroCache& operator=(const MacroCache&) = delete;
+	std::shared_ptr<MacroTemplate> Get(const Fields &body);
+	size_t GetSize() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<Fields, std::shared_ptr<MacroTemplate>> m_templates;
+};
+
+} /* namespace gerbex */
+
+#endif /* MACROCACHE_H_ */
@@ -0,0 +1,149 @@
+/*
+ * NetIndex.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "NetIndex.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace gerbex {
+
+static const std::vector<ObjectRange> NO_RANGES;
+
+NetIndex::NetIndex() :
+		m_nets { }, m_components { }, m_last { }, m_lastRanges { }, m_next {
+				0 } {
+}
+
+void NetIndex::Add(size_t index,
+		const std::shared_ptr<const AttributeSet> &attributes) {
+	if (attributes == m_last && index == m_next) {
+		for (std::vector<ObjectRange> *ranges : m_lastRanges) {
+			ranges->back().end = index + 1;
+		}
+		m_next = index + 1;
+		return;
+	}
+
+	m_last = attributes;
+	m_lastRanges.clear();
+	m_next = index + 1;
+	if (attributes == nullptr) {
+		return;
+	}
+	// An object may join several nets, an empty name is on none
+	const AttributeSet::Attribute *nets = attributes->Find(".N");
+	if (nets != nullptr) {
+		for (const std::string *net : nets->values) {
+			if (!net->empty()) {
+				note(m_nets[*net], index);
+			}
+		}
+	}
+	std::string refdes = attributes->GetValue(".C");
+	if (!refdes.empty()) {
+		note(m_components[refdes], index);
+	}
+}
+
+const std::vector<ObjectRange>& NetIndex::GetNet(const std::string &name) const {
+	return find(m_nets, name);
+}
+
+const std::vector<ObjectRange>& NetIndex::GetComponent(
+		const std::string &refdes) const {
+	return find(m_components, refdes);
+}
+
+std::vector<std::string> NetIndex::GetNets() const {
+	return names(m_nets);
+}
+
+std::vector<std::string> NetIndex::GetComponents() const {
+	return names(m_components);
+}
+
+std::vector<ObjectRange> NetIndex::Intersect(const std::vector<ObjectRange> &a,
+		const std::vector<ObjectRange> &b) {
+	std::vector<ObjectRange> result;
+	size_t i = 0;
+	size_t j = 0;
+	while (i < a.size() && j < b.size()) {
+		size_t begin = std::max(a[i].begin, b[j].begin);
+		size_t end = std::min(a[i].end, b[j].end);
+		if (begin < end) {
+			result.push_back( { begin, end });
+		}
+		if (a[i].end < b[j].end) {
+			i++;
+		} else {
+			j++;
+		}
+	}
+	return result;
+}
+
+std::vector<std::shared_ptr<GraphicalObject>> NetIndex::Select(
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+		const std::vector<ObjectRange> &ranges) {
+	size_t count = 0;
+	for (const ObjectRange &range : ranges) {
+		count += range.end - range.begin;
+	}
+	std::vector<std::shared_ptr<GraphicalObject>> selected;
+	selected.reserve(count);
+	for (const ObjectRange &range : ranges) {
+		if (range.end > objects.size()) {
+			throw std::invalid_argument("object range outside of the layer");
+		}
+		selected.insert(selected.end(), objects.begin() + range.begin,
+				objects.begin() + range.end);
+	}
+	return selected;
+}
+
+void NetIndex::note(std::vector<ObjectRange> &ranges, size_t index) {
+	if (!ranges.empty() && ranges.back().end > index) {
+		// Named twice by the one object
+		return;
+	} else if (!ranges.empty() && ranges.back().end == index) {
+		ranges.back().end = index + 1;
+	} else {
+		ranges.push_back( { index, index + 1 });
+	}
+	m_lastRanges.push_back(&ranges);
+}
+
+const std::vector<ObjectRange>& NetIndex::find(const Ranges &ranges,
+		const std::string &name) {
+	auto found = ranges.find(name);
+	return found == ranges.end() ? NO_RANGES : found->second;
+}
+
+std::vector<std::string> NetIndex::names(const Ranges &ranges) {
+	std::vector<std::string> result;
+	result.reserve(ranges.size());
+	for (const auto &entry : ranges) {
+		result.push_back(entry.first);
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,83 @@
+/*
+ * NetIndex.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETINDEX_H_
+#define NETINDEX_H_
+
+#include "AttributeSet.h"
+#include "GraphicalObject.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gerbex {
+
+// Objects begin to end, not including end, of a layer's object list
+struct ObjectRange {
+	size_t begin;
+	size_t end;
+};
+
+/*
+ * The ranges of a layer's objects on each net, from the .N object
+ * attribute, and of each component, from .C. Built as objects are created,
+ * so a query needs no scan of the layer. Objects created together under
+ * the same attributes make one range.
+ */
+class NetIndex {
+public:
+	NetIndex();
+	virtual ~NetIndex() = default;
+	NetIndex(const NetIndex&) = delete;
+	NetIndex& operator=(const NetIndex&) = delete;
+	// Notes the object at index, objects being added in order
+	void Add(size_t index, const std::shared_ptr<const AttributeSet> &attributes);
+	// Ranges in order, empty when the name is not in the layer
+	const std::vector<ObjectRange>& GetNet(const std::string &name) const;
+	const std::vector<ObjectRange>& GetComponent(const std::string &refdes) const;
+	// Names in the layer, sorted
+	std::vector<std::string> GetNets() const;
+	std::vector<std::string> GetComponents() const;
+	// Objects in both lists of ranges
+	static std::vector<ObjectRange> Intersect(const std::vector<ObjectRange> &a,
+			const std::vector<ObjectRange> &b);
+	static std::vector<std::shared_ptr<GraphicalObject>> Select(
+			const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+			const std::vector<ObjectRange> &ranges);
+
+private:
+	typedef std::unordered_map<std::string, std::vector<ObjectRange>> Ranges;
+	void note(std::vector<ObjectRange> &ranges, size_t index);
+	static const std::vector<ObjectRange>& find(const Ranges &ranges,
+			const std::string &name);
+	static std::vector<std::string> names(const Ranges &ranges);
+	Ranges m_nets;
+	Ranges m_components;
+	// Ranges extended by the last object, while the next shares its set
+	std::shared_ptr<const AttributeSet> m_last;
+	std::vector<std::vector<ObjectRange>*> m_lastRanges;
+	size_t m_next;
+};
+
+} /* namespace gerbex */
+
+#endif /* NETINDEX_H_ */
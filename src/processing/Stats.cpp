@@ -0,0 +1,210 @@
+/*
+ * Stats.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Arc.h"
+#include "Draw.h"
+#include "Flash.h"
+#include "Region.h"
+#include "Stats.h"
+#include <algorithm>
+#include <iomanip>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace gerbex {
+
+static double millisecondsSince(Stats::Clock::time_point start,
+		Stats::Clock::time_point end) {
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static std::string objectType(const GraphicalObject &object) {
+	if (dynamic_cast<const Flash*>(&object)) {
+		return "Flash";
+	} else if (dynamic_cast<const Arc*>(&object)) {
+		return "Arc";
+	} else if (dynamic_cast<const Draw*>(&object)) {
+		return "Draw";
+	} else if (dynamic_cast<const Region*>(&object)) {
+		return "Region";
+	}
+	return "other";
+}
+
+// Names are ours or Gerber command codes, only quotes need escaping
+static std::string quoted(const std::string &name) {
+	std::string result = "\"";
+	for (char c : name) {
+		if (c == '"' || c == '\\') {
+			result += '\\';
+		}
+		result += c;
+	}
+	return result + "\"";
+}
+
+Stats::Stats() :
+		m_phases { }, m_commands { }, m_counts { } {
+}
+
+Stats::Clock::time_point Stats::AddTime(const std::string &phase,
+		Clock::time_point start) {
+	Clock::time_point now = Clock::now();
+	auto found = std::find_if(m_phases.begin(), m_phases.end(),
+			[&phase](const std::pair<std::string, double> &entry) {
+				return entry.first == phase;
+			});
+	if (found == m_phases.end()) {
+		m_phases.emplace_back(phase, millisecondsSince(start, now));
+	} else {
+		found->second += millisecondsSince(start, now);
+	}
+	return now;
+}
+
+Stats::Clock::time_point Stats::AddCommand(const std::string &code,
+		Clock::time_point start) {
+	Clock::time_point now = Clock::now();
+	Command &command = m_commands[code];
+	command.count++;
+	command.milliseconds += millisecondsSince(start, now);
+	return now;
+}
+
+void Stats::Count(const std::string &counter, uint64_t amount) {
+	m_counts[counter] += amount;
+}
+
+void Stats::CountObjects(
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects) {
+	for (const std::shared_ptr<GraphicalObject> &object : objects) {
+		Count("objects " + objectType(*object));
+	}
+}
+
+double Stats::GetMilliseconds(const std::string &phase) const {
+	for (const std::pair<std::string, double> &entry : m_phases) {
+		if (entry.first == phase) {
+			return entry.second;
+		}
+	}
+	return 0.0;
+}
+
+const std::map<std::string, Stats::Command>& Stats::GetCommands() const {
+	return m_commands;
+}
+
+uint64_t Stats::GetCount(const std::string &counter) const {
+	auto found = m_counts.find(counter);
+	return found == m_counts.end() ? 0 : found->second;
+}
+
+void Stats::WriteTable(std::ostream &stream) const {
+	std::ios::fmtflags flags = stream.flags();
+	stream << std::fixed << std::setprecision(3);
+	stream << std::left << std::setw(24) << "Phase" << std::right
+			<< std::setw(14) << "ms" << std::endl;
+	for (const std::pair<std::string, double> &entry : m_phases) {
+		stream << std::left << std::setw(24) << entry.first << std::right
+				<< std::setw(14) << entry.second << std::endl;
+	}
+
+	// Slowest commands first
+	std::vector<std::pair<std::string, Command>> commands(m_commands.begin(),
+			m_commands.end());
+	std::stable_sort(commands.begin(), commands.end(),
+			[](const std::pair<std::string, Command> &a,
+					const std::pair<std::string, Command> &b) {
+				return a.second.milliseconds > b.second.milliseconds;
+			});
+	stream << std::endl << std::left << std::setw(24) << "Command"
+			<< std::right << std::setw(14) << "count" << std::setw(14) << "ms"
+			<< std::endl;
+	for (const std::pair<std::string, Command> &entry : commands) {
+		stream << std::left << std::setw(24) << entry.first << std::right
+				<< std::setw(14) << entry.second.count << std::setw(14)
+				<< entry.second.milliseconds << std::endl;
+	}
+
+	// Instrumented builds add counters with longer names
+	int width = 24;
+	for (const std::pair<const std::string, uint64_t> &entry : m_counts) {
+		width = std::max(width, static_cast<int>(entry.first.size()) + 1);
+	}
+	stream << std::endl << std::left << std::setw(width) << "Counter"
+			<< std::right << std::setw(14) << "count" << std::endl;
+	for (const std::pair<const std::string, uint64_t> &entry : m_counts) {
+		stream << std::left << std::setw(width) << entry.first << std::right
+				<< std::setw(14) << entry.second << std::endl;
+	}
+	stream << std::left << std::setw(width) << "peak RSS bytes" << std::right
+			<< std::setw(14) << PeakResidentBytes() << std::endl;
+	stream.flags(flags);
+}
+
+void Stats::WriteJson(std::ostream &stream) const {
+	std::ios::fmtflags flags = stream.flags();
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\n  \"phases\": {";
+	const char *separator = "\n";
+	for (const std::pair<std::string, double> &entry : m_phases) {
+		stream << separator << "    " << quoted(entry.first) << ": "
+				<< entry.second;
+		separator = ",\n";
+	}
+	stream << "\n  },\n  \"commands\": {";
+	separator = "\n";
+	for (const std::pair<const std::string, Command> &entry : m_commands) {
+		stream << separator << "    " << quoted(entry.first)
+				<< ": { \"count\": " << entry.second.count << ", \"ms\": "
+				<< entry.second.milliseconds << " }";
+		separator = ",\n";
+	}
+	stream << "\n  },\n  \"counts\": {";
+	separator = "\n";
+	for (const std::pair<const std::string, uint64_t> &entry : m_counts) {
+		stream << separator << "    " << quoted(entry.first) << ": "
+				<< entry.second;
+		separator = ",\n";
+	}
+	stream << "\n  },\n  \"peakResidentBytes\": " << PeakResidentBytes()
+			<< "\n}" << std::endl;
+	stream.flags(flags);
+}
+
+uint64_t Stats::PeakResidentBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#if defined(__APPLE__)
+	return usage.ru_maxrss;
+#else
+	return (uint64_t) usage.ru_maxrss * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+} /* namespace gerbex */
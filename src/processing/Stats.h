@@ -0,0 +1,78 @@
+/*
+ * Stats.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATS_H_
+#define STATS_H_
+
+#include "GraphicalObject.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Wall time per phase and counts of what was done while converting one
+ * layer, to find where a slow layer spends its time. Phases are reported in
+ * the order first timed. Not thread safe, each layer keeps its own.
+ */
+class Stats {
+public:
+	typedef std::chrono::steady_clock Clock;
+	struct Command {
+		uint64_t count;
+		double milliseconds;
+	};
+
+	Stats();
+	virtual ~Stats() = default;
+	// Adds the time from start until now to the phase, returning now
+	Clock::time_point AddTime(const std::string &phase,
+			Clock::time_point start);
+	// Counts one command executed, adding the time from start until now
+	Clock::time_point AddCommand(const std::string &code,
+			Clock::time_point start);
+	void Count(const std::string &counter, uint64_t amount = 1);
+	// Counts the objects by type, as "objects <type>"
+	void CountObjects(
+			const std::vector<std::shared_ptr<GraphicalObject>> &objects);
+	double GetMilliseconds(const std::string &phase) const;
+	const std::map<std::string, Command>& GetCommands() const;
+	uint64_t GetCount(const std::string &counter) const;
+	void WriteTable(std::ostream &stream) const;
+	void WriteJson(std::ostream &stream) const;
+	// Highest resident set size of the whole process so far, in bytes, or 0
+	// where the platform does not tell
+	static uint64_t PeakResidentBytes();
+
+private:
+	std::vector<std::pair<std::string, double>> m_phases;
+	std::map<std::string, Command> m_commands;
+	std::map<std::string, uint64_t> m_counts;
+};
+
+} /* namespace gerbex */
+
+#endif /* STATS_H_ */
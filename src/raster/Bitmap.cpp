@@ -0,0 +1,423 @@
+/*
+ * Bitmap.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Bitmap.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace gerbex {
+
+const int WORD_BITS = 64;
+
+const uint64_t ALL_BITS = ~uint64_t { 0 };
+
+const double TWO_PI = 2.0 * M_PI;
+
+// Word holding pixel x, rounding towards negative infinity
+static int wordOf(int x) {
+	return x >= 0 ? x / WORD_BITS : -((WORD_BITS - 1 - x) / WORD_BITS);
+}
+
+static uint64_t bitOf(int x) {
+	return uint64_t { 1 } << (WORD_BITS - 1 - (x - wordOf(x) * WORD_BITS));
+}
+
+// Angle past start in [0, 2 pi)
+static double angleFrom(double angle, double start) {
+	double delta = std::fmod(angle - start, TWO_PI);
+	return delta < 0.0 ? delta + TWO_PI : delta;
+}
+
+// Narrows [lo, hi] to where lo <= slope * x + offset <= hi holds
+static void constrain(double slope, double offset, double lo, double hi,
+		double &left, double &right) {
+	if (slope == 0.0) {
+		if (offset < lo || offset > hi) {
+			right = left - 1.0;
+		}
+		return;
+	}
+	double a = (lo - offset) / slope;
+	double b = (hi - offset) / slope;
+	left = std::max(left, std::min(a, b));
+	right = std::min(right, std::max(a, b));
+}
+
+Bitmap::Bitmap(const PixelRect &rect) :
+		m_rect { rect }, m_firstWord { 0 }, m_wordsPerRow { 0 }, m_words { } {
+	if (rect.width < 0 || rect.height < 0) {
+		throw std::invalid_argument("bitmap size must not be negative");
+	}
+	if (rect.width > 0) {
+		m_firstWord = wordOf(rect.left);
+		m_wordsPerRow = wordOf(rect.left + rect.width - 1) - m_firstWord + 1;
+	}
+	m_words.resize(m_wordsPerRow * rect.height, 0);
+}
+
+const PixelRect& Bitmap::GetRect() const {
+	return m_rect;
+}
+
+void Bitmap::AddRing(const std::vector<Point> &ring) {
+	struct Edge {
+		double top;
+		double bottom;
+		double x;
+		double dxdy;
+		int winding;
+	};
+	std::vector<Edge> edges;
+	edges.reserve(ring.size());
+	for (size_t i = 0; i < ring.size(); i++) {
+		const Point &a = ring[i];
+		const Point &b = ring[(i + 1) % ring.size()];
+		if (a.GetY() == b.GetY()) {
+			continue;
+		}
+		const Point &upper = a.GetY() < b.GetY() ? a : b;
+		const Point &lower = a.GetY() < b.GetY() ? b : a;
+		double dxdy = (lower.GetX() - upper.GetX())
+				/ (lower.GetY() - upper.GetY());
+		edges.push_back( { upper.GetY(), lower.GetY(), upper.GetX(), dxdy,
+				a.GetY() < b.GetY() ? 1 : -1 });
+	}
+	std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+		return a.top < b.top;
+	});
+
+	// Active edges cross the current row centre, each crossing covering the
+	// half open range top <= y < bottom so shared vertices count once
+	std::vector<const Edge*> active;
+	std::vector<std::pair<double, int>> crossings;
+	size_t next = 0;
+	for (int y = m_rect.top; y < m_rect.top + m_rect.height; y++) {
+		double center = y + 0.5;
+		while (next < edges.size() && edges[next].top <= center) {
+			active.push_back(&edges[next++]);
+		}
+		active.erase(
+				std::remove_if(active.begin(), active.end(),
+						[center](const Edge *edge) {
+							return edge->bottom <= center;
+						}), active.end());
+		if (active.empty()) {
+			if (next == edges.size()) {
+				break;
+			}
+			continue;
+		}
+		crossings.clear();
+		for (const Edge *edge : active) {
+			crossings.emplace_back(
+					edge->x + (center - edge->top) * edge->dxdy,
+					edge->winding);
+		}
+		std::sort(crossings.begin(), crossings.end());
+		int winding = 0;
+		for (size_t i = 0; i + 1 < crossings.size(); i++) {
+			winding += crossings[i].second;
+			if (winding != 0) {
+				fillSpan(y, crossings[i].first, crossings[i + 1].first);
+			}
+		}
+	}
+}
+
+void Bitmap::AddDisc(const Point &center, double radius) {
+	int top = std::max((double) m_rect.top,
+			std::floor(center.GetY() - radius));
+	int bottom = std::min((double) m_rect.top + m_rect.height,
+			std::ceil(center.GetY() + radius));
+	for (int y = top; y < bottom; y++) {
+		double dy = y + 0.5 - center.GetY();
+		double half2 = radius * radius - dy * dy;
+		if (half2 > 0.0) {
+			double half = std::sqrt(half2);
+			fillSpan(y, center.GetX() - half, center.GetX() + half);
+		}
+	}
+}
+
+void Bitmap::AddStroke(const Point &start, const Point &end, double width) {
+	double halfWidth = 0.5 * width;
+	double dx = end.GetX() - start.GetX();
+	double dy = end.GetY() - start.GetY();
+	double length = std::sqrt(dx * dx + dy * dy);
+	int top = std::max((double) m_rect.top,
+			std::floor(std::min(start.GetY(), end.GetY()) - halfWidth));
+	int bottom = std::min((double) m_rect.top + m_rect.height,
+			std::ceil(std::max(start.GetY(), end.GetY()) + halfWidth));
+	for (int y = top; y < bottom; y++) {
+		// The stroke is convex, so each row crosses it in one span, the hull
+		// of its spans through either cap and the body between them
+		double center = y + 0.5;
+		double left = INFINITY;
+		double right = -INFINITY;
+		for (const Point *cap : { &start, &end }) {
+			double offset = center - cap->GetY();
+			double half2 = halfWidth * halfWidth - offset * offset;
+			if (half2 > 0.0) {
+				double half = std::sqrt(half2);
+				left = std::min(left, cap->GetX() - half);
+				right = std::max(right, cap->GetX() + half);
+			}
+		}
+		if (length > 0.0) {
+			double ux = dx / length;
+			double uy = dy / length;
+			double offset = center - start.GetY();
+			double bodyLeft = -INFINITY;
+			double bodyRight = INFINITY;
+			// Along the segment, then across it, relative to the start
+			constrain(ux, offset * uy, 0.0, length, bodyLeft, bodyRight);
+			constrain(-uy, offset * ux, -halfWidth, halfWidth, bodyLeft,
+					bodyRight);
+			if (bodyLeft <= bodyRight) {
+				left = std::min(left, start.GetX() + bodyLeft);
+				right = std::max(right, start.GetX() + bodyRight);
+			}
+		}
+		if (left < right) {
+			fillSpan(y, left, right);
+		}
+	}
+}
+
+void Bitmap::AddArcStroke(const Point &center, double radius,
+		double startAngle, double sweep, double width) {
+	double halfWidth = 0.5 * width;
+	bool full = std::fabs(sweep) >= TWO_PI;
+	if (sweep < 0.0) {
+		startAngle += sweep;
+		sweep = -sweep;
+	}
+	if (!full) {
+		AddDisc(center + Point(std::cos(startAngle), std::sin(startAngle))
+						* radius, halfWidth);
+		AddDisc(center + Point(std::cos(startAngle + sweep),
+				std::sin(startAngle + sweep)) * radius, halfWidth);
+	}
+
+	double outer = radius + halfWidth;
+	double inner = std::max(0.0, radius - halfWidth);
+	int top = std::max((double) m_rect.top, std::floor(center.GetY() - outer));
+	int bottom = std::min((double) m_rect.top + m_rect.height,
+			std::ceil(center.GetY() + outer));
+	for (int y = top; y < bottom; y++) {
+		double dy = y + 0.5 - center.GetY();
+		double outer2 = outer * outer - dy * dy;
+		if (outer2 <= 0.0) {
+			continue;
+		}
+		double outerHalf = std::sqrt(outer2);
+		double inner2 = inner * inner - dy * dy;
+		double innerHalf = inner2 > 0.0 ? std::sqrt(inner2) : 0.0;
+		// The ring crosses this row on either side of the centre
+		std::pair<double, double> spans[] = { { center.GetX() - outerHalf,
+				center.GetX() - innerHalf }, { center.GetX() + innerHalf,
+				center.GetX() + outerHalf } };
+		for (const std::pair<double, double> &span : spans) {
+			if (full) {
+				fillSpan(y, span.first, span.second);
+				continue;
+			}
+			int x0 = std::max((double) m_rect.left,
+					std::ceil(span.first - 0.5));
+			int x1 = std::min((double) m_rect.left + m_rect.width,
+					std::ceil(span.second - 0.5));
+			for (int x = x0; x < x1; x++) {
+				double angle = std::atan2(dy, x + 0.5 - center.GetX());
+				if (angleFrom(angle, startAngle) <= sweep) {
+					setPixel(x, y);
+				}
+			}
+		}
+	}
+}
+
+void Bitmap::FillSpan(int y, int x0, int x1) {
+	if (y < m_rect.top || y >= m_rect.top + m_rect.height) {
+		return;
+	}
+	x0 = std::max(x0, m_rect.left);
+	x1 = std::min(x1, m_rect.left + m_rect.width);
+	if (x0 >= x1) {
+		return;
+	}
+	uint64_t *words = row(y);
+	int first = wordOf(x0) - m_firstWord;
+	int last = wordOf(x1 - 1) - m_firstWord;
+	uint64_t head = ALL_BITS >> (x0 - wordOf(x0) * WORD_BITS);
+	uint64_t tail = ALL_BITS << (WORD_BITS - 1 - (x1 - 1 - wordOf(x1 - 1)
+			* WORD_BITS));
+	if (first == last) {
+		words[first] |= head & tail;
+		return;
+	}
+	words[first] |= head;
+	// Whole words between, which the compiler turns into vector stores
+	std::fill(words + first + 1, words + last, ALL_BITS);
+	words[last] |= tail;
+}
+
+bool Bitmap::Get(int x, int y) const {
+	return row(y)[wordOf(x) - m_firstWord] & bitOf(x);
+}
+
+void Bitmap::Paint(const Bitmap &shape, const Bitmap *mask, bool dark) {
+	const PixelRect &rect = shape.m_rect;
+	if (mask) {
+		shape.checkRect(*mask);
+	}
+	int top = std::max(rect.top, m_rect.top);
+	int bottom = std::min(rect.top + rect.height, m_rect.top + m_rect.height);
+	int firstWord = std::max(shape.m_firstWord, m_firstWord);
+	int lastWord = std::min(shape.m_firstWord + (int) shape.m_wordsPerRow,
+			m_firstWord + (int) m_wordsPerRow);
+	for (int y = top; y < bottom; y++) {
+		uint64_t *out = row(y) + (firstWord - m_firstWord);
+		const uint64_t *in = shape.row(y) + (firstWord - shape.m_firstWord);
+		const uint64_t *cut =
+				mask ? mask->row(y) + (firstWord - shape.m_firstWord) : nullptr;
+		int count = lastWord - firstWord;
+		// Plain word loops, left for the compiler to vectorize
+		if (dark && cut) {
+			for (int i = 0; i < count; i++) {
+				out[i] |= in[i] & ~cut[i];
+			}
+		} else if (dark) {
+			for (int i = 0; i < count; i++) {
+				out[i] |= in[i];
+			}
+		} else if (cut) {
+			for (int i = 0; i < count; i++) {
+				out[i] &= ~(in[i] & ~cut[i]);
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				out[i] &= ~in[i];
+			}
+		}
+	}
+}
+
+void Bitmap::Xor(const Bitmap &other) {
+	checkRect(other);
+	// Pixels outside the rectangle are clear in both, so whole words will do
+	for (size_t i = 0; i < m_words.size(); i++) {
+		m_words[i] ^= other.m_words[i];
+	}
+}
+
+uint64_t Bitmap::Count() const {
+	uint64_t total = 0;
+	for (uint64_t word : m_words) {
+		total += __builtin_popcountll(word);
+	}
+	return total;
+}
+
+bool Bitmap::FindSpan(int y, int x0, int x1, int &left, int &right) const {
+	x0 = std::max(x0, m_rect.left);
+	x1 = std::min(x1, m_rect.left + m_rect.width);
+	if (y < m_rect.top || y >= m_rect.top + m_rect.height || x0 >= x1) {
+		return false;
+	}
+	const uint64_t *words = row(y);
+	int first = wordOf(x0);
+	int last = wordOf(x1 - 1);
+	uint64_t head = ALL_BITS >> (x0 - first * WORD_BITS);
+	uint64_t tail = ALL_BITS << (WORD_BITS - 1 - (x1 - 1 - last * WORD_BITS));
+	auto bits = [&](int word) {
+		uint64_t value = words[word - m_firstWord];
+		if (word == first) {
+			value &= head;
+		}
+		if (word == last) {
+			value &= tail;
+		}
+		return value;
+	};
+	int word = first;
+	while (word <= last && bits(word) == 0) {
+		word++;
+	}
+	if (word > last) {
+		return false;
+	}
+	left = word * WORD_BITS + __builtin_clzll(bits(word));
+	word = last;
+	while (bits(word) == 0) {
+		word--;
+	}
+	right = (word + 1) * WORD_BITS - __builtin_ctzll(bits(word));
+	return true;
+}
+
+void Bitmap::PackRow(int y, uint8_t *bytes) const {
+	size_t numBytes = (m_rect.width + 7) / 8;
+	const uint64_t *words = row(y);
+	if (m_rect.left % WORD_BITS == 0) {
+		for (size_t i = 0; i < numBytes; i++) {
+			bytes[i] = words[i / 8] >> (56 - 8 * (i % 8));
+		}
+		return;
+	}
+	std::fill_n(bytes, numBytes, 0);
+	for (int x = 0; x < m_rect.width; x++) {
+		if (Get(m_rect.left + x, y)) {
+			bytes[x / 8] |= 0x80 >> (x % 8);
+		}
+	}
+}
+
+void Bitmap::checkRect(const Bitmap &other) const {
+	if (other.m_rect.left != m_rect.left || other.m_rect.top != m_rect.top
+			|| other.m_rect.width != m_rect.width
+			|| other.m_rect.height != m_rect.height) {
+		throw std::invalid_argument("bitmaps must cover the same rectangle");
+	}
+}
+
+void Bitmap::fillSpan(int y, double left, double right) {
+	// Pixels whose centre lies in [left, right), bounded before converting
+	double lo = m_rect.left - 1.0;
+	double hi = m_rect.left + m_rect.width + 1.0;
+	int x0 = std::ceil(std::clamp(left, lo, hi) - 0.5);
+	int x1 = std::ceil(std::clamp(right, lo, hi) - 0.5);
+	FillSpan(y, x0, x1);
+}
+
+void Bitmap::setPixel(int x, int y) {
+	row(y)[wordOf(x) - m_firstWord] |= bitOf(x);
+}
+
+uint64_t* Bitmap::row(int y) {
+	return &m_words[(y - m_rect.top) * m_wordsPerRow];
+}
+
+const uint64_t* Bitmap::row(int y) const {
+	return &m_words[(y - m_rect.top) * m_wordsPerRow];
+}
+
+} /* namespace gerbex */
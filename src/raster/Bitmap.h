@@ -0,0 +1,85 @@
+/*
+ * Bitmap.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITMAP_H_
+#define BITMAP_H_
+
+#include "Coverage.h"
+#include "Point.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * One bit per pixel over a rectangle of pixels, set where the pixel centre
+ * lies inside any shape added. Shapes take the same pixel coordinates as
+ * Coverage, but are filled as horizontal spans rather than anti-aliased.
+ *
+ * Rows are packed 64 pixels to a word, the leftmost pixel in the most
+ * significant bit. Words are aligned to multiples of 64 pixels from x = 0,
+ * so any two bitmaps combine word by word.
+ */
+class Bitmap {
+public:
+	Bitmap(const PixelRect &rect);
+	virtual ~Bitmap() = default;
+	const PixelRect& GetRect() const;
+	// Either orientation, overlapping rings are united
+	void AddRing(const std::vector<Point> &ring);
+	void AddDisc(const Point &center, double radius);
+	// Round capped
+	void AddStroke(const Point &start, const Point &end, double width);
+	// Sweep in radians, positive towards +y, a full turn or more is a ring
+	void AddArcStroke(const Point &center, double radius, double startAngle,
+			double sweep, double width);
+	// Sets pixels x0 up to but excluding x1 on row y, clipped to the rectangle
+	void FillSpan(int y, int x0, int x1);
+	bool Get(int x, int y) const;
+	// Sets the shape less its mask where dark, or clears it otherwise. The
+	// mask, when given, must cover the same rectangle as the shape.
+	void Paint(const Bitmap &shape, const Bitmap *mask, bool dark);
+	// Keeps only the pixels set in one bitmap or the other, but not both. The
+	// other bitmap must cover the same rectangle.
+	void Xor(const Bitmap &other);
+	// Number of pixels set
+	uint64_t Count() const;
+	// Bounds of the pixels set on row y from x0 up to but excluding x1, as
+	// left up to but excluding right, false when there are none
+	bool FindSpan(int y, int x0, int x1, int &left, int &right) const;
+	// Row y as bytes, leftmost pixel in the high bit, padded to whole bytes
+	void PackRow(int y, uint8_t *bytes) const;
+
+private:
+	void checkRect(const Bitmap &other) const;
+	void fillSpan(int y, double left, double right);
+	void setPixel(int x, int y);
+	uint64_t* row(int y);
+	const uint64_t* row(int y) const;
+	PixelRect m_rect;
+	int m_firstWord;
+	size_t m_wordsPerRow;
+	std::vector<uint64_t> m_words;
+};
+
+} /* namespace gerbex */
+
+#endif /* BITMAP_H_ */
@@ -0,0 +1,327 @@
+/*
+ * Coverage.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Coverage.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace gerbex {
+
+const double TWO_PI = 2.0 * M_PI;
+
+// Overlap of a one pixel wide box filter at distance from the centre line of
+// a band halfWidth either side, which is exact across straight edges
+static double bandCoverage(double distance, double halfWidth) {
+	double overlap = std::min(distance + 0.5, halfWidth)
+			- std::max(distance - 0.5, -halfWidth);
+	return std::clamp(overlap, 0.0, 1.0);
+}
+
+// Plain square root, std::hypot guards against overflow at many times the cost
+static double length(double dx, double dy) {
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+static double distanceToSegment(double x, double y, const Point &start,
+		const Point &end) {
+	double dx = end.GetX() - start.GetX();
+	double dy = end.GetY() - start.GetY();
+	double length2 = dx * dx + dy * dy;
+	double t = 0.0;
+	if (length2 > 0.0) {
+		t = ((x - start.GetX()) * dx + (y - start.GetY()) * dy) / length2;
+		t = std::clamp(t, 0.0, 1.0);
+	}
+	return length(x - start.GetX() - t * dx, y - start.GetY() - t * dy);
+}
+
+// Angle past start in [0, 2 pi)
+static double angleFrom(double angle, double start) {
+	double delta = std::fmod(angle - start, TWO_PI);
+	return delta < 0.0 ? delta + TWO_PI : delta;
+}
+
+Coverage::Coverage(const PixelRect &rect) :
+		m_rect { rect }, m_stride { 0 }, m_area { }, m_coverage { } {
+	if (rect.width < 0 || rect.height < 0) {
+		throw std::invalid_argument("coverage size must not be negative");
+	}
+	// The accumulated area spills up to two columns past the right side, it
+	// is only allocated once a ring is added
+	m_stride = rect.width + 2;
+	m_coverage.resize((size_t) rect.width * rect.height, 0.0f);
+}
+
+const PixelRect& Coverage::GetRect() const {
+	return m_rect;
+}
+
+void Coverage::AddRing(const std::vector<Point> &ring) {
+	if (m_area.empty()) {
+		m_area.resize(m_stride * m_rect.height, 0.0f);
+	}
+	Point origin(m_rect.left, m_rect.top);
+	for (size_t i = 0; i < ring.size(); i++) {
+		addLine(ring[i] - origin, ring[(i + 1) % ring.size()] - origin);
+	}
+}
+
+void Coverage::AddDisc(const Point &center, double radius) {
+	PixelRect rect = clip(center.GetX() - radius, center.GetY() - radius,
+			center.GetX() + radius, center.GetY() + radius);
+	// Discs smaller than a pixel also shrink across the band
+	double scale = std::min(1.0, 2.0 * radius);
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		float *row = &m_coverage[(y - m_rect.top) * m_rect.width];
+		for (int x = rect.left; x < rect.left + rect.width; x++) {
+			double distance = length(x + 0.5 - center.GetX(),
+					y + 0.5 - center.GetY());
+			float value = scale * bandCoverage(distance, radius);
+			float &pixel = row[x - m_rect.left];
+			pixel = std::max(pixel, value);
+		}
+	}
+}
+
+void Coverage::AddStroke(const Point &start, const Point &end, double width) {
+	double halfWidth = 0.5 * width;
+	PixelRect rect = clip(std::min(start.GetX(), end.GetX()) - halfWidth,
+			std::min(start.GetY(), end.GetY()) - halfWidth,
+			std::max(start.GetX(), end.GetX()) + halfWidth,
+			std::max(start.GetY(), end.GetY()) + halfWidth);
+	// Pixel centres further than this from the segment are not covered
+	double reach = halfWidth + 0.5;
+	double dx = end.GetX() - start.GetX();
+	double dy = end.GetY() - start.GetY();
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		// Only the part of the segment within reach of this row matters,
+		// which keeps diagonal strokes from visiting their whole box
+		double t0 = 0.0;
+		double t1 = 1.0;
+		if (dy != 0.0) {
+			double ta = (y + 0.5 - reach - start.GetY()) / dy;
+			double tb = (y + 0.5 + reach - start.GetY()) / dy;
+			t0 = std::max(0.0, std::min(ta, tb));
+			t1 = std::min(1.0, std::max(ta, tb));
+			if (t0 > t1) {
+				continue;
+			}
+		}
+		double xa = start.GetX() + t0 * dx;
+		double xb = start.GetX() + t1 * dx;
+		int left = std::max((double) rect.left,
+				std::floor(std::min(xa, xb) - reach));
+		int right = std::min((double) rect.left + rect.width,
+				std::ceil(std::max(xa, xb) + reach));
+		float *row = &m_coverage[(y - m_rect.top) * m_rect.width];
+		for (int x = left; x < right; x++) {
+			double distance = distanceToSegment(x + 0.5, y + 0.5, start, end);
+			float value = bandCoverage(distance, halfWidth);
+			float &pixel = row[x - m_rect.left];
+			pixel = std::max(pixel, value);
+		}
+	}
+}
+
+void Coverage::AddArcStroke(const Point &center, double radius,
+		double startAngle, double sweep, double width) {
+	double halfWidth = 0.5 * width;
+	bool full = std::fabs(sweep) >= TWO_PI;
+	if (sweep < 0.0) {
+		startAngle += sweep;
+		sweep = -sweep;
+	}
+	Point start = center
+			+ Point(std::cos(startAngle), std::sin(startAngle)) * radius;
+	Point end = center
+			+ Point(std::cos(startAngle + sweep), std::sin(startAngle + sweep))
+					* radius;
+
+	// Bound the end points and whichever axis extremes the arc passes
+	double left = std::min(start.GetX(), end.GetX());
+	double right = std::max(start.GetX(), end.GetX());
+	double top = std::min(start.GetY(), end.GetY());
+	double bottom = std::max(start.GetY(), end.GetY());
+	for (int quadrant = 0; quadrant < 4; quadrant++) {
+		double angle = quadrant * 0.5 * M_PI;
+		if (!full && angleFrom(angle, startAngle) > sweep) {
+			continue;
+		}
+		Point extreme = center
+				+ Point(std::cos(angle), std::sin(angle)) * radius;
+		left = std::min(left, extreme.GetX());
+		right = std::max(right, extreme.GetX());
+		top = std::min(top, extreme.GetY());
+		bottom = std::max(bottom, extreme.GetY());
+	}
+	PixelRect rect = clip(left - halfWidth, top - halfWidth, right + halfWidth,
+			bottom + halfWidth);
+
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		float *row = &m_coverage[(y - m_rect.top) * m_rect.width];
+		double dy = y + 0.5 - center.GetY();
+		for (int x = rect.left; x < rect.left + rect.width; x++) {
+			double dx = x + 0.5 - center.GetX();
+			double distance;
+			if (full || angleFrom(std::atan2(dy, dx), startAngle) <= sweep) {
+				distance = std::fabs(length(dx, dy) - radius);
+			} else {
+				distance = std::min(
+						length(x + 0.5 - start.GetX(),
+								y + 0.5 - start.GetY()),
+						length(x + 0.5 - end.GetX(), y + 0.5 - end.GetY()));
+			}
+			float value = bandCoverage(distance, halfWidth);
+			float &pixel = row[x - m_rect.left];
+			pixel = std::max(pixel, value);
+		}
+	}
+}
+
+void Coverage::Resolve() {
+	if (m_area.empty()) {
+		return;
+	}
+	for (int y = 0; y < m_rect.height; y++) {
+		float *area = &m_area[y * m_stride];
+		float *row = &m_coverage[y * m_rect.width];
+		float sum = 0.0f;
+		for (int x = 0; x < m_rect.width; x++) {
+			sum += area[x];
+			row[x] = std::max(row[x], std::min(1.0f, std::fabs(sum)));
+			area[x] = 0.0f;
+		}
+		area[m_rect.width] = 0.0f;
+		area[m_rect.width + 1] = 0.0f;
+	}
+}
+
+float Coverage::Get(int x, int y) const {
+	return GetRow(y)[x - m_rect.left];
+}
+
+const float* Coverage::GetRow(int y) const {
+	return &m_coverage[(y - m_rect.top) * m_rect.width];
+}
+
+void Coverage::addLine(const Point &start, const Point &end) {
+	if (start.GetY() == end.GetY()) {
+		return;
+	}
+	// Split where the line leaves the columns. Pieces outside are moved onto
+	// the nearest side, which keeps the area to their right within the
+	// rectangle unchanged.
+	double width = m_rect.width;
+	std::array<double, 4> splits { 0.0, 0.0, 0.0, 1.0 };
+	size_t numSplits = 1;
+	double dx = end.GetX() - start.GetX();
+	for (double side : { 0.0, width }) {
+		if (dx != 0.0) {
+			double t = (side - start.GetX()) / dx;
+			if (t > 0.0 && t < 1.0) {
+				splits[numSplits++] = t;
+			}
+		}
+	}
+	if (numSplits == 3 && splits[2] < splits[1]) {
+		std::swap(splits[1], splits[2]);
+	}
+	splits[numSplits] = 1.0;
+
+	Point delta = end - start;
+	for (size_t i = 0; i < numSplits; i++) {
+		Point a = start + delta * splits[i];
+		Point b = start + delta * splits[i + 1];
+		accumulate(std::clamp(a.GetX(), 0.0, width), a.GetY(),
+				std::clamp(b.GetX(), 0.0, width), b.GetY());
+	}
+}
+
+void Coverage::accumulate(double x0, double y0, double x1, double y1) {
+	double direction = 1.0;
+	if (y0 > y1) {
+		std::swap(x0, x1);
+		std::swap(y0, y1);
+		direction = -1.0;
+	}
+	if (y0 == y1 || y1 <= 0.0 || y0 >= m_rect.height) {
+		return;
+	}
+	double dxdy = (x1 - x0) / (y1 - y0);
+	double x = x0;
+	if (y0 < 0.0) {
+		x = std::clamp(x - y0 * dxdy, 0.0, (double) m_rect.width);
+		y0 = 0.0;
+	}
+	int rowEnd = std::min((double) m_rect.height, std::ceil(y1));
+	for (int y = (int) y0; y < rowEnd; y++) {
+		float *area = &m_area[y * m_stride];
+		double dy = std::min(y + 1.0, y1) - std::max((double) y, y0);
+		double xNext = std::clamp(x + dxdy * dy, 0.0, (double) m_rect.width);
+		double d = dy * direction;
+		double xa = std::min(x, xNext);
+		double xb = std::max(x, xNext);
+		double xaFloor = std::floor(xa);
+		int xai = (int) xaFloor;
+		double xbCeil = std::ceil(xb);
+		int xbi = (int) xbCeil;
+		if (xbi <= xai + 1) {
+			// Within one column, split by the mean position
+			double xm = 0.5 * (x + xNext) - xaFloor;
+			area[xai] += d - d * xm;
+			area[xai + 1] += d * xm;
+		} else {
+			// Across columns, the covered area grows quadratically at
+			// either end and linearly in between
+			double s = 1.0 / (xb - xa);
+			double xaFrac = xa - xaFloor;
+			double a0 = 0.5 * s * (1.0 - xaFrac) * (1.0 - xaFrac);
+			double xbFrac = xb - xbCeil + 1.0;
+			double am = 0.5 * s * xbFrac * xbFrac;
+			area[xai] += d * a0;
+			if (xbi == xai + 2) {
+				area[xai + 1] += d * (1.0 - a0 - am);
+			} else {
+				double a1 = s * (1.5 - xaFrac);
+				area[xai + 1] += d * (a1 - a0);
+				for (int xi = xai + 2; xi < xbi - 1; xi++) {
+					area[xi] += d * s;
+				}
+				double a2 = a1 + (xbi - xai - 3) * s;
+				area[xbi - 1] += d * (1.0 - a2 - am);
+			}
+			area[xbi] += d * am;
+		}
+		x = xNext;
+	}
+}
+
+PixelRect Coverage::clip(double left, double top, double right,
+		double bottom) const {
+	int x0 = std::max((double) m_rect.left, std::floor(left));
+	int y0 = std::max((double) m_rect.top, std::floor(top));
+	int x1 = std::min((double) m_rect.left + m_rect.width, std::ceil(right));
+	int y1 = std::min((double) m_rect.top + m_rect.height, std::ceil(bottom));
+	return {x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,81 @@
+/*
+ * Coverage.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef COVERAGE_H_
+#define COVERAGE_H_
+
+#include "Point.h"
+#include <vector>
+
+namespace gerbex {
+
+// A rectangle of whole pixels, x to the right and y down
+struct PixelRect {
+	int left;
+	int top;
+	int width;
+	int height;
+};
+
+/*
+ * Anti-aliased coverage of a rectangle of pixels, from 0 to 1, for the
+ * union of all shapes added. Coordinates are in pixels, with pixel (x, y)
+ * spanning [x, x + 1) x [y, y + 1); shapes may extend past the rectangle.
+ *
+ * Rings are filled on scanlines by accumulating the exact signed area each
+ * edge covers to its right, so one prefix sum per row gives the winding
+ * integrated over every pixel. Circles and strokes are evaluated directly
+ * from their distance to each pixel centre, which keeps round caps and
+ * thin lines smooth without tessellating them.
+ */
+class Coverage {
+public:
+	Coverage(const PixelRect &rect);
+	virtual ~Coverage() = default;
+	const PixelRect& GetRect() const;
+	// Either orientation, overlapping rings are united
+	void AddRing(const std::vector<Point> &ring);
+	void AddDisc(const Point &center, double radius);
+	// Round capped
+	void AddStroke(const Point &start, const Point &end, double width);
+	// Sweep in radians, positive towards +y, a full turn or more is a ring
+	void AddArcStroke(const Point &center, double radius, double startAngle,
+			double sweep, double width);
+	// Folds the filled rings into the coverage, call once all shapes are added
+	void Resolve();
+	// Absolute pixel coordinates, after Resolve
+	float Get(int x, int y) const;
+	// One row of the rectangle, after Resolve
+	const float* GetRow(int y) const;
+
+private:
+	void addLine(const Point &start, const Point &end);
+	void accumulate(double x0, double y0, double x1, double y1);
+	PixelRect clip(double left, double top, double right,
+			double bottom) const;
+	PixelRect m_rect;
+	size_t m_stride;
+	std::vector<float> m_area;
+	std::vector<float> m_coverage;
+};
+
+} /* namespace gerbex */
+
+#endif /* COVERAGE_H_ */
@@ -0,0 +1,239 @@
+/*
+ * ImageWriter.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ImageWriter.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <filesystem>
+#include <stdexcept>
+
+namespace gerbex {
+
+// Largest stored deflate block
+const size_t MAX_BLOCK_SIZE = 65535;
+
+const uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+// Colour type 0 is greyscale
+const uint8_t PNG_GREYSCALE = 0;
+
+// Deflate, 32K window, no preset dictionary, fastest level
+const uint8_t ZLIB_HEADER[] = { 0x78, 0x01 };
+
+static void appendBigEndian(std::vector<uint8_t> &data, uint32_t value) {
+	data.push_back(value >> 24);
+	data.push_back(value >> 16);
+	data.push_back(value >> 8);
+	data.push_back(value);
+}
+
+ImageWriter::ImageWriter(std::ostream &stream, ImageFormat format) :
+		m_stream { stream }, m_format { format }, m_width { 0 }, m_height { 0 }, m_rows {
+				0 }, m_adler { 1 }, m_pending { }, m_streamStarted { false } {
+}
+
+ImageFormat ImageWriter::FormatFromPath(const std::string &path) {
+	return FormatFromExtension(std::filesystem::path(path).extension().string());
+}
+
+ImageFormat ImageWriter::FormatFromExtension(const std::string &extension) {
+	std::string ext = extension;
+	std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
+		return std::tolower(c);
+	});
+	if (ext == ".png") {
+		return ImageFormat::Png;
+	} else if (ext == ".pgm") {
+		return ImageFormat::Pgm;
+	} else if (ext == ".pbm") {
+		return ImageFormat::Pbm;
+	}
+	throw std::invalid_argument("unsupported image file type: " + ext);
+}
+
+void ImageWriter::Begin(int width, int height) {
+	if (width <= 0 || height <= 0) {
+		throw std::invalid_argument("image must not be empty");
+	}
+	m_width = width;
+	m_height = height;
+	m_rows = 0;
+	switch (m_format) {
+	case ImageFormat::Pbm:
+		m_stream << "P4\n" << width << " " << height << "\n";
+		break;
+	case ImageFormat::Pgm:
+		m_stream << "P5\n" << width << " " << height << "\n255\n";
+		break;
+	case ImageFormat::Png: {
+		m_stream.write(reinterpret_cast<const char*>(PNG_SIGNATURE),
+				sizeof(PNG_SIGNATURE));
+		std::vector<uint8_t> header;
+		appendBigEndian(header, width);
+		appendBigEndian(header, height);
+		// Bit depth, colour type, compression, filter and interlace
+		header.insert(header.end(), { 8, PNG_GREYSCALE, 0, 0, 0 });
+		writeChunk("IHDR", header);
+		m_adler = 1;
+		m_pending.clear();
+		m_streamStarted = false;
+		break;
+	}
+	}
+}
+
+void ImageWriter::WriteRows(const uint8_t *pixels, int rows) {
+	if (rows < 0 || m_rows + rows > m_height) {
+		throw std::invalid_argument("more rows than the image height");
+	}
+	if (m_format == ImageFormat::Pbm) {
+		// Packed a row at a time, PBM marks dark pixels with a set bit
+		std::vector<uint8_t> bits((m_width + 7) / 8);
+		for (int row = 0; row < rows; row++) {
+			const uint8_t *line = pixels + (size_t) row * m_width;
+			std::fill(bits.begin(), bits.end(), 0);
+			for (int x = 0; x < m_width; x++) {
+				if (line[x] >= 128) {
+					bits[x / 8] |= 0x80 >> (x % 8);
+				}
+			}
+			WritePackedRows(bits.data(), 1);
+		}
+		return;
+	}
+	m_rows += rows;
+	if (m_format == ImageFormat::Pgm) {
+		m_stream.write(reinterpret_cast<const char*>(pixels),
+				(std::streamsize) m_width * rows);
+		return;
+	}
+	for (int row = 0; row < rows; row++) {
+		// Each scanline starts with its filter type, 0 for none
+		const uint8_t *line = pixels + (size_t) row * m_width;
+		uint8_t filter = 0;
+		m_adler = Adler32(&filter, 1, m_adler);
+		m_adler = Adler32(line, m_width, m_adler);
+		m_pending.push_back(filter);
+		m_pending.insert(m_pending.end(), line, line + m_width);
+		while (m_pending.size() > MAX_BLOCK_SIZE) {
+			writeBlock(false);
+		}
+	}
+}
+
+void ImageWriter::WritePackedRows(const uint8_t *bits, int rows) {
+	if (m_format != ImageFormat::Pbm) {
+		throw std::logic_error("packed rows are only written to PBM");
+	}
+	if (rows < 0 || m_rows + rows > m_height) {
+		throw std::invalid_argument("more rows than the image height");
+	}
+	m_rows += rows;
+	m_stream.write(reinterpret_cast<const char*>(bits),
+			(std::streamsize) ((m_width + 7) / 8) * rows);
+}
+
+void ImageWriter::End() {
+	if (m_rows != m_height) {
+		throw std::logic_error("image ended before all rows were written");
+	}
+	if (m_format == ImageFormat::Png) {
+		writeBlock(true);
+		writeChunk("IEND", { });
+	}
+	m_stream.flush();
+}
+
+uint32_t ImageWriter::Crc32(const uint8_t *data, size_t size, uint32_t crc) {
+	static const std::array<uint32_t, 256> table = [] {
+		std::array<uint32_t, 256> entries;
+		for (uint32_t n = 0; n < 256; n++) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			}
+			entries[n] = c;
+		}
+		return entries;
+	}();
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++) {
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+uint32_t ImageWriter::Adler32(const uint8_t *data, size_t size,
+		uint32_t adler) {
+	const uint32_t modulus = 65521;
+	// Largest run that cannot overflow before reducing
+	const size_t run = 5552;
+	uint32_t a = adler & 0xffff;
+	uint32_t b = adler >> 16;
+	while (size > 0) {
+		size_t count = std::min(size, run);
+		size -= count;
+		while (count-- > 0) {
+			a += *data++;
+			b += a;
+		}
+		a %= modulus;
+		b %= modulus;
+	}
+	return (b << 16) | a;
+}
+
+void ImageWriter::writeChunk(const char *type,
+		const std::vector<uint8_t> &data) {
+	std::vector<uint8_t> chunk;
+	chunk.reserve(data.size() + 12);
+	appendBigEndian(chunk, data.size());
+	chunk.insert(chunk.end(), type, type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+	appendBigEndian(chunk,
+			Crc32(chunk.data() + 4, chunk.size() - 4));
+	m_stream.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+void ImageWriter::writeBlock(bool final) {
+	// Each stored block goes out as its own IDAT chunk, the zlib header
+	// leading the first and the checksum trailing the last
+	size_t size = std::min(m_pending.size(), MAX_BLOCK_SIZE);
+	std::vector<uint8_t> data;
+	data.reserve(size + 16);
+	if (!m_streamStarted) {
+		data.insert(data.end(), ZLIB_HEADER, ZLIB_HEADER + sizeof(ZLIB_HEADER));
+		m_streamStarted = true;
+	}
+	data.push_back(final ? 1 : 0);
+	data.push_back(size & 0xff);
+	data.push_back(size >> 8);
+	data.push_back(~size & 0xff);
+	data.push_back((~size >> 8) & 0xff);
+	data.insert(data.end(), m_pending.begin(), m_pending.begin() + size);
+	m_pending.erase(m_pending.begin(), m_pending.begin() + size);
+	if (final) {
+		appendBigEndian(data, m_adler);
+	}
+	writeChunk("IDAT", data);
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,75 @@
+/*
+ * ImageWriter.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGEWRITER_H_
+#define IMAGEWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+enum class ImageFormat {
+	Pbm, Pgm, Png
+};
+
+/*
+ * Streams an 8 bit greyscale image to binary PGM or PNG, or a 1 bit image
+ * to binary PBM, a band of rows at a time. PNG data is stored without
+ * compression, so no library is needed and memory stays bounded by one
+ * deflate block.
+ */
+class ImageWriter {
+public:
+	ImageWriter(std::ostream &stream, ImageFormat format);
+	virtual ~ImageWriter() = default;
+	static ImageFormat FormatFromPath(const std::string &path);
+	// Extension with its dot, in any case
+	static ImageFormat FormatFromExtension(const std::string &extension);
+	void Begin(int width, int height);
+	// Rows top down, width bytes each, PBM sets pixels of 128 and up
+	void WriteRows(const uint8_t *pixels, int rows);
+	// PBM only, rows packed 8 pixels to a byte, high bit first
+	void WritePackedRows(const uint8_t *bits, int rows);
+	void End();
+	static uint32_t Crc32(const uint8_t *data, size_t size,
+			uint32_t crc = 0);
+	static uint32_t Adler32(const uint8_t *data, size_t size,
+			uint32_t adler = 1);
+
+private:
+	void writeChunk(const char *type, const std::vector<uint8_t> &data);
+	void writeBlock(bool final);
+	std::ostream &m_stream;
+	ImageFormat m_format;
+	int m_width;
+	int m_height;
+	int m_rows;
+	uint32_t m_adler;
+	std::vector<uint8_t> m_pending;
+	bool m_streamStarted;
+};
+
+} /* namespace gerbex */
+
+#endif /* IMAGEWRITER_H_ */
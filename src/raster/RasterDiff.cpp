@@ -0,0 +1,196 @@
+/*
+ * RasterDiff.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RasterDiff.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <stdexcept>
+
+namespace gerbex {
+
+RasterDiff::RasterDiff(const RasterSerializer &before,
+		const RasterSerializer &after, unsigned int threads) :
+		m_before { before }, m_after { after }, m_threads { threads }, m_width {
+				before.GetWidth() }, m_height { before.GetHeight() }, m_columns {
+				(m_width + kCellSize - 1) / kCellSize }, m_rows { (m_height
+				+ kCellSize - 1) / kCellSize }, m_changed { 0 }, m_cells { }, m_regions {
+				} {
+	if (after.GetWidth() != m_width || after.GetHeight() != m_height) {
+		throw std::invalid_argument("images must be the same size");
+	}
+}
+
+void RasterDiff::Compare(
+		const std::function<void(const uint8_t *pixels, int rows)> &write) {
+	m_changed = 0;
+	m_cells.assign((size_t) m_columns * m_rows, { 0, 0, 0, 0, false });
+	m_regions.clear();
+
+	struct Strip {
+		std::vector<uint8_t> pixels;
+		int rows;
+		std::future<uint64_t> changed;
+	};
+	// Declared ahead of the pool, which waits on its tasks when destroyed
+	std::deque<Strip> strips;
+	// Binned once, each strip paints only the targets that touch it
+	std::vector<RasterSerializer::Bin> beforeBins = m_before.BinStrips(
+			kStripRows);
+	std::vector<RasterSerializer::Bin> afterBins = m_after.BinStrips(
+			kStripRows);
+	ThreadPool pool(m_threads);
+	size_t stripsInFlight = pool.GetThreadCount() + 1;
+	int numStrips = (m_height + kStripRows - 1) / kStripRows;
+	int next = 0;
+	auto submit = [&]() {
+		Strip strip;
+		PixelRect rect { 0, next * kStripRows, m_width, std::min(kStripRows,
+				m_height - next * kStripRows) };
+		strip.rows = rect.height;
+		if (write) {
+			strip.pixels.resize((size_t) m_width * rect.height);
+		}
+		uint8_t *pixels = write ? strip.pixels.data() : nullptr;
+		const RasterSerializer::Bin *before = &beforeBins[next];
+		const RasterSerializer::Bin *after = &afterBins[next];
+		strip.changed = pool.Submit([this, rect, pixels, before, after]() {
+			return compareStrip(rect, pixels, *before, *after);
+		});
+		strips.push_back(std::move(strip));
+		next++;
+	};
+
+	while (next < numStrips && strips.size() < stripsInFlight) {
+		submit();
+	}
+	while (!strips.empty()) {
+		Strip &strip = strips.front();
+		m_changed += strip.changed.get();
+		if (write) {
+			write(strip.pixels.data(), strip.rows);
+		}
+		strips.pop_front();
+		if (next < numStrips) {
+			submit();
+		}
+	}
+	findRegions();
+}
+
+uint64_t RasterDiff::GetChangedPixels() const {
+	return m_changed;
+}
+
+const std::vector<PixelRect>& RasterDiff::GetRegions() const {
+	return m_regions;
+}
+
+uint64_t RasterDiff::compareStrip(const PixelRect &rect, uint8_t *pixels,
+		const RasterSerializer::Bin &beforeItems,
+		const RasterSerializer::Bin &afterItems) {
+	Bitmap before(rect);
+	Bitmap after(rect);
+	m_before.Render(beforeItems, before);
+	m_after.Render(afterItems, after);
+
+	if (pixels) {
+		size_t rowBytes = (rect.width + 7) / 8;
+		std::vector<uint8_t> beforeRow(rowBytes);
+		std::vector<uint8_t> afterRow(rowBytes);
+		for (int y = 0; y < rect.height; y++) {
+			before.PackRow(rect.top + y, beforeRow.data());
+			after.PackRow(rect.top + y, afterRow.data());
+			uint8_t *out = pixels + (size_t) y * rect.width;
+			for (int x = 0; x < rect.width; x++) {
+				uint8_t bit = 0x80 >> (x % 8);
+				bool wasDark = beforeRow[x / 8] & bit;
+				bool isDark = afterRow[x / 8] & bit;
+				out[x] = wasDark ? (isDark ? kUnchanged : kRemoved) :
+						(isDark ? kAdded : 0);
+			}
+		}
+	}
+
+	before.Xor(after);
+	// Strips hold whole rows of cells, so no other task touches these
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		for (int column = 0; column < m_columns; column++) {
+			int left;
+			int right;
+			if (!before.FindSpan(y, column * kCellSize,
+					(column + 1) * kCellSize, left, right)) {
+				continue;
+			}
+			Cell &cell = m_cells[(size_t) (y / kCellSize) * m_columns + column];
+			if (!cell.changed) {
+				cell = { left, y, right, y + 1, true };
+			} else {
+				cell.left = std::min(cell.left, left);
+				cell.right = std::max(cell.right, right);
+				cell.bottom = y + 1;
+			}
+		}
+	}
+	return before.Count();
+}
+
+void RasterDiff::findRegions() {
+	std::vector<bool> visited(m_cells.size(), false);
+	std::vector<int> stack;
+	for (size_t start = 0; start < m_cells.size(); start++) {
+		if (!m_cells[start].changed || visited[start]) {
+			continue;
+		}
+		Cell region = m_cells[start];
+		visited[start] = true;
+		stack.push_back(start);
+		while (!stack.empty()) {
+			int index = stack.back();
+			stack.pop_back();
+			const Cell &cell = m_cells[index];
+			region.left = std::min(region.left, cell.left);
+			region.top = std::min(region.top, cell.top);
+			region.right = std::max(region.right, cell.right);
+			region.bottom = std::max(region.bottom, cell.bottom);
+			int column = index % m_columns;
+			int row = index / m_columns;
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					int c = column + dx;
+					int r = row + dy;
+					if (c < 0 || c >= m_columns || r < 0 || r >= m_rows) {
+						continue;
+					}
+					int neighbour = r * m_columns + c;
+					if (m_cells[neighbour].changed && !visited[neighbour]) {
+						visited[neighbour] = true;
+						stack.push_back(neighbour);
+					}
+				}
+			}
+		}
+		m_regions.push_back( { region.left, region.top, region.right
+				- region.left, region.bottom - region.top });
+	}
+}
+
+} /* namespace gerbex */
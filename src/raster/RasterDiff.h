@@ -0,0 +1,89 @@
+/*
+ * RasterDiff.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RASTERDIFF_H_
+#define RASTERDIFF_H_
+
+#include "Bitmap.h"
+#include "Coverage.h"
+#include "RasterSerializer.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Compares two images rendered on the same grid at 1 bit per pixel. Strips
+ * of both are filled in parallel and exclusive-ored a word at a time, so
+ * neither image is ever held whole.
+ *
+ * Changed pixels are grouped into regions by the square cells they fall in,
+ * cells touching on a side or corner joining the same region, so changes
+ * closer than a cell apart are reported together.
+ */
+class RasterDiff {
+public:
+	// Both must be the same size, on a pool of threads, 0 for all cores
+	RasterDiff(const RasterSerializer &before, const RasterSerializer &after,
+			unsigned int threads = 0);
+	virtual ~RasterDiff() = default;
+	// Hands over a highlight image of each strip of rows top down, if given
+	void Compare(
+			const std::function<void(const uint8_t *pixels, int rows)> &write =
+					nullptr);
+	uint64_t GetChangedPixels() const;
+	// Bounds of each region of changed pixels, in scan order
+	const std::vector<PixelRect>& GetRegions() const;
+	static constexpr int kCellSize = 64;
+	// A whole number of cells, so strips never share one
+	static constexpr int kStripRows = 4 * kCellSize;
+	// Highlight pixel values, 0 where clear in both
+	static constexpr uint8_t kUnchanged = 64;
+	static constexpr uint8_t kRemoved = 128;
+	static constexpr uint8_t kAdded = 255;
+
+private:
+	struct Cell {
+		int left;
+		int top;
+		int right;
+		int bottom;
+		bool changed;
+	};
+	uint64_t compareStrip(const PixelRect &rect, uint8_t *pixels,
+			const RasterSerializer::Bin &beforeItems,
+			const RasterSerializer::Bin &afterItems);
+	void findRegions();
+	const RasterSerializer &m_before;
+	const RasterSerializer &m_after;
+	unsigned int m_threads;
+	int m_width;
+	int m_height;
+	int m_columns;
+	int m_rows;
+	uint64_t m_changed;
+	std::vector<Cell> m_cells;
+	std::vector<PixelRect> m_regions;
+};
+
+} /* namespace gerbex */
+
+#endif /* RASTERDIFF_H_ */
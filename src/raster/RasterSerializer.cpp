@@ -0,0 +1,516 @@
+/*
+ * RasterSerializer.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ArcSegment.h"
+#include "Contour.h"
+#include "ImageWriter.h"
+#include "RasterSerializer.h"
+#include "Segment.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <future>
+#include <stdexcept>
+
+namespace gerbex {
+
+// Contours are flattened to a fraction of a pixel, below what anti-aliasing
+// can show
+const double CONTOUR_TOLERANCE = 0.1;
+
+// Boxes in pixel coordinates have y down, so their bottom is the top row
+static PixelRect clipBox(const Box &box, const PixelRect &region) {
+	int x0 = std::max((double) region.left, std::floor(box.GetLeft()));
+	int y0 = std::max((double) region.top, std::floor(box.GetBottom()));
+	int x1 = std::min((double) region.left + region.width,
+			std::ceil(box.GetRight()));
+	int y1 = std::min((double) region.top + region.height,
+			std::ceil(box.GetTop()));
+	return {x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+}
+
+static Box rectBox(const PixelRect &rect) {
+	return Box(rect.width, rect.height, rect.left, rect.top);
+}
+
+static double sweepAngle(const ArcSegment &segment, double startAngle,
+		double endAngle) {
+	double sweep = std::fmod(endAngle - startAngle, 2.0 * M_PI);
+	if (segment.GetDirection() == ArcDirection::CounterClockwise) {
+		if (sweep <= 0.0) {
+			sweep += 2.0 * M_PI;
+		}
+	} else if (sweep >= 0.0) {
+		sweep -= 2.0 * M_PI;
+	}
+	return segment.IsCircle() ? std::copysign(2.0 * M_PI, sweep) : sweep;
+}
+
+void RasterItem::Add(const Ring &ring) {
+	m_rings.push_back(ring);
+	extend(ring.box);
+}
+
+void RasterItem::Add(const Disc &disc) {
+	m_discs.push_back(disc);
+	extend(discBox(disc));
+}
+
+void RasterItem::Add(const Stroke &stroke) {
+	m_strokes.push_back(stroke);
+	extend(strokeBox(stroke));
+}
+
+void RasterItem::Add(const ArcStroke &arc) {
+	m_arcs.push_back(arc);
+	extend(arcBox(arc));
+}
+
+template<typename Canvas>
+void RasterItem::Draw(Canvas &canvas) const {
+	Box bounds = rectBox(canvas.GetRect());
+	for (const Ring &ring : m_rings) {
+		if (ring.box.Overlaps(bounds)) {
+			canvas.AddRing(ring.points);
+		}
+	}
+	for (const Disc &disc : m_discs) {
+		if (discBox(disc).Overlaps(bounds)) {
+			canvas.AddDisc(disc.center, disc.radius);
+		}
+	}
+	for (const Stroke &stroke : m_strokes) {
+		if (strokeBox(stroke).Overlaps(bounds)) {
+			canvas.AddStroke(stroke.start, stroke.end, stroke.width);
+		}
+	}
+	for (const ArcStroke &arc : m_arcs) {
+		if (arcBox(arc).Overlaps(bounds)) {
+			canvas.AddArcStroke(arc.center, arc.radius, arc.startAngle,
+					arc.sweep, arc.width);
+		}
+	}
+}
+
+template void RasterItem::Draw<Coverage>(Coverage &canvas) const;
+template void RasterItem::Draw<Bitmap>(Bitmap &canvas) const;
+
+Box RasterItem::discBox(const Disc &disc) {
+	return Box(2.0 * disc.radius, disc.center);
+}
+
+Box RasterItem::strokeBox(const Stroke &stroke) {
+	return Box( { stroke.start, stroke.end }).Pad(0.5 * stroke.width);
+}
+
+// The whole circle, which is cheaper than the extent of the sweep
+Box RasterItem::arcBox(const ArcStroke &arc) {
+	return Box(2.0 * arc.radius, arc.center).Pad(0.5 * arc.width);
+}
+
+void RasterItem::extend(const Box &box) {
+	m_box = m_empty ? box : m_box.Extend(box);
+	m_empty = false;
+}
+
+RasterSerializer::RasterSerializer(const Box &viewBox, double pixelSize) :
+		m_viewBox { viewBox }, m_pixelSize { pixelSize }, m_width { 0 }, m_height {
+				0 }, m_tileSize { kDefaultTileSize }, m_threads { 0 }, m_stripHeight {
+				kDefaultStripHeight }, m_tessellator { }, m_items { } {
+	if (pixelSize <= 0.0) {
+		throw std::invalid_argument("pixel size must be positive");
+	}
+	m_width = std::max(1.0, std::ceil(viewBox.GetWidth() / pixelSize));
+	m_height = std::max(1.0, std::ceil(viewBox.GetHeight() / pixelSize));
+	m_tessellator.SetTolerance(CONTOUR_TOLERANCE * pixelSize);
+}
+
+pSerialItem RasterSerializer::NewMask(const Box &box) {
+	(void) box;
+	return std::make_shared<RasterItem>(Polarity::Clear);
+}
+
+void RasterSerializer::AddDraw(pSerialItem target, double width,
+		const Segment &segment) {
+	RasterItem::Get(target)->Add(
+			RasterItem::Stroke { toPixels(segment.GetStart()), toPixels(
+					segment.GetEnd()), width / m_pixelSize });
+}
+
+void RasterSerializer::AddPolygon(pSerialItem target,
+		const std::vector<Point> &points) {
+	if (points.size() < 3) {
+		throw std::invalid_argument("invalid polygon");
+	}
+	addRing(*RasterItem::Get(target), points);
+}
+
+pSerialItem RasterSerializer::NewGroup(pSerialItem parent) {
+	std::shared_ptr<RasterItem> item = std::make_shared<RasterItem>(
+			RasterItem::Get(parent)->GetPolarity());
+	m_items.push_back(item);
+	return item;
+}
+
+pSerialItem RasterSerializer::GetTarget(Polarity polarity) {
+	std::shared_ptr<RasterItem> item = std::make_shared<RasterItem>(polarity);
+	m_items.push_back(item);
+	return item;
+}
+
+void RasterSerializer::AddArc(pSerialItem target, double width,
+		const ArcSegment &segment) {
+	Point center = segment.GetCenter();
+	Point start = segment.GetStart() - center;
+	Point end = segment.GetEnd() - center;
+	double startAngle = std::atan2(start.GetY(), start.GetX());
+	double sweep = sweepAngle(segment, startAngle,
+			std::atan2(end.GetY(), end.GetX()));
+	// Pixel rows run down, which mirrors every angle
+	RasterItem::Get(target)->Add(
+			RasterItem::ArcStroke { toPixels(center), segment.GetRadius()
+					/ m_pixelSize, -startAngle, -sweep, width / m_pixelSize });
+}
+
+void RasterSerializer::SetMask(pSerialItem target, pSerialItem mask) {
+	RasterItem::Get(target)->SetMask(RasterItem::Get(mask));
+}
+
+void RasterSerializer::AddCircle(pSerialItem target, double radius,
+		const Point &center) {
+	RasterItem::Get(target)->Add(
+			RasterItem::Disc { toPixels(center), radius / m_pixelSize });
+}
+
+void RasterSerializer::AddContour(pSerialItem target,
+		const Contour &contour) {
+	std::vector<Point> points = m_tessellator.MakeContour(contour);
+	if (points.size() >= 3) {
+		addRing(*RasterItem::Get(target), points);
+	}
+}
+
+void RasterSerializer::Save(std::ostream &stream,
+		const std::string &extension) {
+	ImageFormat format = ImageWriter::FormatFromExtension(extension);
+	ImageWriter writer(stream, format);
+	writer.Begin(m_width, m_height);
+	if (format == ImageFormat::Pbm) {
+		RenderBitStrips([&writer](const uint8_t *bits, int rows) {
+			writer.WritePackedRows(bits, rows);
+		});
+	} else {
+		RenderStrips([&writer](const uint8_t *pixels, int rows) {
+			writer.WriteRows(pixels, rows);
+		});
+	}
+	writer.End();
+}
+
+int RasterSerializer::GetWidth() const {
+	return m_width;
+}
+
+int RasterSerializer::GetHeight() const {
+	return m_height;
+}
+
+void RasterSerializer::SetTiling(unsigned int tileSize, unsigned int threads) {
+	if (tileSize == 0) {
+		throw std::invalid_argument("tile size must be positive");
+	}
+	m_tileSize = tileSize;
+	m_threads = threads;
+}
+
+std::vector<uint8_t> RasterSerializer::Render() const {
+	std::vector<uint8_t> image;
+	image.reserve((size_t) m_width * m_height);
+	RenderStrips([&image, this](const uint8_t *pixels, int rows) {
+		image.insert(image.end(), pixels, pixels + (size_t) m_width * rows);
+	});
+	return image;
+}
+
+void RasterSerializer::Render(const PixelRect &region, uint8_t *pixels,
+		size_t stride) const {
+	Bin items;
+	for (const std::shared_ptr<RasterItem> &item : m_items) {
+		items.push_back(item.get());
+	}
+	render(items, region, pixels, stride);
+}
+
+std::vector<RasterSerializer::Bin> RasterSerializer::BinStrips(
+		int stripRows) const {
+	if (stripRows <= 0) {
+		throw std::invalid_argument("strip height must be positive");
+	}
+	return binItems(m_width, stripRows, 1,
+			(m_height + stripRows - 1) / stripRows);
+}
+
+void RasterSerializer::Render(const Bin &items, Bitmap &bitmap) const {
+	for (const RasterItem *item : items) {
+		paint(*item, bitmap);
+	}
+}
+
+void RasterSerializer::RenderStrips(
+		const std::function<void(const uint8_t *pixels, int rows)> &write) const {
+	int tileSize = std::min<unsigned int>(m_tileSize,
+			std::max(m_width, m_height));
+	int columns = (m_width + tileSize - 1) / tileSize;
+	int rows = (m_height + tileSize - 1) / tileSize;
+	std::vector<Bin> bins = binItems(tileSize, tileSize, columns, rows);
+
+	struct Strip {
+		std::vector<uint8_t> pixels;
+		int rows;
+		std::vector<std::future<void>> tiles;
+	};
+	// Declared ahead of the pool, which waits on its tasks when destroyed
+	std::deque<Strip> strips;
+	ThreadPool pool(m_threads);
+	// Enough strips queued to keep every thread busy while one is written
+	size_t stripsInFlight = 1 + (pool.GetThreadCount() + columns - 1) / columns;
+	int next = 0;
+	auto submit = [&]() {
+		Strip strip;
+		int top = next * tileSize;
+		strip.rows = std::min(tileSize, m_height - top);
+		strip.pixels.resize((size_t) m_width * strip.rows);
+		for (int column = 0; column < columns; column++) {
+			PixelRect tile { column * tileSize, top, std::min(tileSize, m_width
+					- column * tileSize), strip.rows };
+			const Bin *bin = &bins[next * columns + column];
+			uint8_t *pixels = strip.pixels.data() + tile.left;
+			strip.tiles.push_back(pool.Submit([this, bin, tile, pixels]() {
+				render(*bin, tile, pixels, m_width);
+			}));
+		}
+		strips.push_back(std::move(strip));
+		next++;
+	};
+
+	while (next < rows && strips.size() < stripsInFlight) {
+		submit();
+	}
+	while (!strips.empty()) {
+		Strip &strip = strips.front();
+		for (std::future<void> &tile : strip.tiles) {
+			tile.get();
+		}
+		write(strip.pixels.data(), strip.rows);
+		strips.pop_front();
+		if (next < rows) {
+			submit();
+		}
+	}
+}
+
+void RasterSerializer::SetStripHeight(unsigned int rows) {
+	if (rows == 0) {
+		throw std::invalid_argument("strip height must be positive");
+	}
+	m_stripHeight = rows;
+}
+
+void RasterSerializer::RenderBitStrips(
+		const std::function<void(const uint8_t *bits, int rows)> &write) const {
+	int stripHeight = std::min<unsigned int>(m_stripHeight, m_height);
+	int rows = (m_height + stripHeight - 1) / stripHeight;
+	std::vector<Bin> bins = BinStrips(stripHeight);
+	size_t rowBytes = (m_width + 7) / 8;
+
+	struct Strip {
+		std::vector<uint8_t> bits;
+		int rows;
+		std::future<void> done;
+	};
+	// Declared ahead of the pool, which waits on its tasks when destroyed
+	std::deque<Strip> strips;
+	ThreadPool pool(m_threads);
+	size_t stripsInFlight = pool.GetThreadCount() + 1;
+	int next = 0;
+	auto submit = [&]() {
+		Strip strip;
+		PixelRect rect { 0, next * stripHeight, m_width, std::min(stripHeight,
+				m_height - next * stripHeight) };
+		strip.rows = rect.height;
+		strip.bits.resize(rowBytes * rect.height);
+		const Bin *bin = &bins[next];
+		uint8_t *bits = strip.bits.data();
+		strip.done = pool.Submit([this, bin, rect, bits, rowBytes]() {
+			Bitmap bitmap(rect);
+			Render(*bin, bitmap);
+			for (int y = 0; y < rect.height; y++) {
+				bitmap.PackRow(rect.top + y, bits + y * rowBytes);
+			}
+		});
+		strips.push_back(std::move(strip));
+		next++;
+	};
+
+	while (next < rows && strips.size() < stripsInFlight) {
+		submit();
+	}
+	while (!strips.empty()) {
+		Strip &strip = strips.front();
+		strip.done.get();
+		write(strip.bits.data(), strip.rows);
+		strips.pop_front();
+		if (next < rows) {
+			submit();
+		}
+	}
+}
+
+std::vector<RasterSerializer::Bin> RasterSerializer::binItems(int tileWidth,
+		int tileHeight, int columns, int rows) const {
+	std::vector<Bin> bins((size_t) columns * rows);
+	PixelRect image { 0, 0, m_width, m_height };
+	for (const std::shared_ptr<RasterItem> &item : m_items) {
+		if (item->IsEmpty()) {
+			continue;
+		}
+		PixelRect area = clipBox(item->GetBox(), image);
+		if (area.width == 0 || area.height == 0) {
+			continue;
+		}
+		// Appended in paint order, so each bin keeps it
+		for (int row = area.top / tileHeight;
+				row <= (area.top + area.height - 1) / tileHeight; row++) {
+			for (int column = area.left / tileWidth;
+					column <= (area.left + area.width - 1) / tileWidth;
+					column++) {
+				bins[row * columns + column].push_back(item.get());
+			}
+		}
+	}
+	return bins;
+}
+
+void RasterSerializer::render(const Bin &items, const PixelRect &region,
+		uint8_t *pixels, size_t stride) const {
+	for (int y = 0; y < region.height; y++) {
+		std::fill_n(pixels + y * stride, region.width, 0);
+	}
+	for (const RasterItem *item : items) {
+		if (!item->IsEmpty()) {
+			composite(*item, region, pixels, stride);
+		}
+	}
+}
+
+void RasterSerializer::composite(const RasterItem &item,
+		const PixelRect &region, uint8_t *pixels, size_t stride) const {
+	PixelRect area = clipBox(item.GetBox(), region);
+	const RasterItem *mask = item.GetMask().get();
+	if (mask && mask->IsEmpty()) {
+		mask = nullptr;
+	}
+	bool dark = item.GetPolarity() == Polarity::Dark;
+
+	// Large targets, such as planes, are covered a band at a time
+	for (int top = area.top; top < area.top + area.height; top += kBandRows) {
+		PixelRect band { area.left, top, area.width, std::min(kBandRows,
+				area.top + area.height - top) };
+		Coverage coverage(band);
+		item.Draw(coverage);
+		coverage.Resolve();
+		std::unique_ptr<Coverage> maskCoverage;
+		if (mask && mask->GetBox().Overlaps(rectBox(band))) {
+			maskCoverage = std::make_unique<Coverage>(band);
+			mask->Draw(*maskCoverage);
+			maskCoverage->Resolve();
+		}
+
+		for (int y = band.top; y < band.top + band.height; y++) {
+			const float *row = coverage.GetRow(y);
+			const float *maskRow = maskCoverage ? maskCoverage->GetRow(y) : nullptr;
+			uint8_t *out = pixels + (y - region.top) * stride
+					+ (band.left - region.left);
+			for (int x = 0; x < band.width; x++) {
+				float alpha = row[x];
+				if (maskRow) {
+					alpha *= 1.0f - maskRow[x];
+				}
+				if (alpha <= 0.0f) {
+					continue;
+				}
+				float value = out[x];
+				value = dark ? value + (255.0f - value) * alpha :
+								value * (1.0f - alpha);
+				out[x] = (uint8_t) (value + 0.5f);
+			}
+		}
+	}
+}
+
+void RasterSerializer::addRing(RasterItem &item,
+		const std::vector<Point> &points) const {
+	// Rings of one target are united, which needs them all turning the same
+	// way, or one overlapping another would cancel it out
+	std::vector<Point> ring = toPixels(points);
+	double area = 0.0;
+	for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+		area += ring[j].GetX() * ring[i].GetY()
+				- ring[i].GetX() * ring[j].GetY();
+	}
+	if (area < 0.0) {
+		std::reverse(ring.begin(), ring.end());
+	}
+	Box box(ring);
+	item.Add(RasterItem::Ring { std::move(ring), box });
+}
+
+void RasterSerializer::paint(const RasterItem &item, Bitmap &strip) const {
+	PixelRect area = clipBox(item.GetBox(), strip.GetRect());
+	if (area.width == 0 || area.height == 0) {
+		return;
+	}
+	Bitmap shape(area);
+	item.Draw(shape);
+	std::unique_ptr<Bitmap> mask;
+	if (item.GetMask() && !item.GetMask()->IsEmpty()) {
+		mask = std::make_unique<Bitmap>(area);
+		item.GetMask()->Draw(*mask);
+	}
+	strip.Paint(shape, mask.get(), item.GetPolarity() == Polarity::Dark);
+}
+
+Point RasterSerializer::toPixels(const Point &point) const {
+	return Point((point.GetX() - m_viewBox.GetLeft()) / m_pixelSize,
+			(m_viewBox.GetTop() - point.GetY()) / m_pixelSize);
+}
+
+std::vector<Point> RasterSerializer::toPixels(
+		const std::vector<Point> &points) const {
+	std::vector<Point> pixels;
+	pixels.reserve(points.size());
+	for (const Point &point : points) {
+		pixels.push_back(toPixels(point));
+	}
+	return pixels;
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,213 @@
+/*
+ * RasterSerializer.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RASTERSERIALIZER_H_
+#define RASTERSERIALIZER_H_
+
+#include "Bitmap.h"
+#include "Box.h"
+#include "Coverage.h"
+#include "Instrument.h"
+#include "Point.h"
+#include "Serializer.h"
+#include "Tessellator.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * The shapes of one target, in pixel coordinates, painted together as
+ * their union.
+ */
+class RasterItem: public SerialItem {
+public:
+	struct Ring {
+		std::vector<Point> points;
+		Box box;
+	};
+	struct Disc {
+		Point center;
+		double radius;
+	};
+	struct Stroke {
+		Point start;
+		Point end;
+		double width;
+	};
+	struct ArcStroke {
+		Point center;
+		double radius;
+		double startAngle;
+		double sweep;
+		double width;
+	};
+
+	RasterItem(Polarity polarity) :
+			m_polarity { polarity }, m_rings { }, m_discs { }, m_strokes { }, m_arcs {
+					}, m_box { }, m_empty { true }, m_mask { } {
+	}
+	virtual ~RasterItem() = default;
+	static std::shared_ptr<RasterItem> Get(pSerialItem item) {
+		Instrument::Count("cast", "RasterItem::Get");
+		std::shared_ptr<RasterItem> raster = std::dynamic_pointer_cast<
+				RasterItem>(item);
+		if (!raster) {
+			throw std::invalid_argument("Raster received non-Raster item");
+		}
+		return raster;
+	}
+
+	void Add(const Ring &ring);
+	void Add(const Disc &disc);
+	void Add(const Stroke &stroke);
+	void Add(const ArcStroke &arc);
+	// Adds the shapes that may reach the canvas, a Coverage or a Bitmap
+	template<typename Canvas>
+	void Draw(Canvas &canvas) const;
+
+	bool IsEmpty() const {
+		return m_empty;
+	}
+
+	// Pixel bounds of all shapes, valid when not empty
+	const Box& GetBox() const {
+		return m_box;
+	}
+
+	void SetMask(const std::shared_ptr<RasterItem> &mask) {
+		m_mask = mask;
+	}
+
+	const std::shared_ptr<RasterItem>& GetMask() const {
+		return m_mask;
+	}
+
+	Polarity GetPolarity() const {
+		return m_polarity;
+	}
+
+private:
+	static Box discBox(const Disc &disc);
+	static Box strokeBox(const Stroke &stroke);
+	static Box arcBox(const ArcStroke &arc);
+	void extend(const Box &box);
+	Polarity m_polarity;
+	std::vector<Ring> m_rings;
+	std::vector<Disc> m_discs;
+	std::vector<Stroke> m_strokes;
+	std::vector<ArcStroke> m_arcs;
+	Box m_box;
+	bool m_empty;
+	std::shared_ptr<RasterItem> m_mask;
+};
+
+/*
+ * Renders to an anti-aliased 8 bit greyscale image, 0 where clear and 255
+ * where dark. Targets are kept as a display list and composited in the
+ * order they were created, dark ones over and clear ones out of what is
+ * below them. Row 0 is the top of the view box.
+ *
+ * The image is split into square tiles, each target binned to the tiles
+ * its box touches, keeping paint order within every tile. Tiles render in
+ * parallel and are handed on a strip, one row of tiles, at a time, so only
+ * a few strips are ever held in memory.
+ *
+ * For 1 bit output, such as direct imaging, the same display list is filled
+ * into bit packed strips instead. A pixel is dark when its centre is, and
+ * memory is bounded by the strip height rather than the tile size.
+ */
+class RasterSerializer: public Serializer {
+public:
+	// Pixel size in layer units, the image covers the whole view box
+	RasterSerializer(const Box &viewBox, double pixelSize);
+	virtual ~RasterSerializer() = default;
+	pSerialItem NewMask(const Box &box) override;
+	void AddDraw(pSerialItem target, double width, const Segment &segment)
+			override;
+	void AddPolygon(pSerialItem target, const std::vector<Point> &points)
+			override;
+	pSerialItem NewGroup(pSerialItem parent) override;
+	pSerialItem GetTarget(Polarity polarity) override;
+	void AddArc(pSerialItem target, double width, const ArcSegment &segment)
+			override;
+	void SetMask(pSerialItem target, pSerialItem mask) override;
+	void AddCircle(pSerialItem target, double radius, const Point &center)
+			override;
+	void AddContour(pSerialItem target, const Contour &contour) override;
+	// Writes PNG or PGM, or PBM at 1 bit per pixel, by file extension
+	void Save(std::ostream &stream, const std::string &extension) override;
+	int GetWidth() const;
+	int GetHeight() const;
+	// Tile edge in pixels, rendered on a pool of threads, 0 for all cores
+	void SetTiling(unsigned int tileSize, unsigned int threads = 0);
+	// Rows top down, GetWidth bytes each
+	std::vector<uint8_t> Render() const;
+	// Hands over each strip of rows top down, as soon as it is complete
+	void RenderStrips(
+			const std::function<void(const uint8_t *pixels, int rows)> &write) const;
+	// Rows held at once when rendering 1 bit strips
+	void SetStripHeight(unsigned int rows);
+	// As RenderStrips, with rows packed 8 pixels to a byte, high bit first
+	void RenderBitStrips(
+			const std::function<void(const uint8_t *bits, int rows)> &write) const;
+	// Rows of the image region, stride bytes apart
+	void Render(const PixelRect &region, uint8_t *pixels,
+			size_t stride) const;
+	typedef std::vector<const RasterItem*> Bin;
+	// The display list binned to strips of rows top down, each in paint order
+	std::vector<Bin> BinStrips(int stripRows) const;
+	// Sets the pixels of the bitmap's rectangle whose centres are dark, from
+	// the items binned to it
+	void Render(const Bin &items, Bitmap &bitmap) const;
+	// Rows rendered at once per target, bounding the coverage buffers
+	static constexpr int kBandRows = 64;
+	static constexpr unsigned int kDefaultTileSize = 1024;
+	static constexpr unsigned int kDefaultStripHeight = 256;
+
+private:
+	std::vector<Bin> binItems(int tileWidth, int tileHeight, int columns,
+			int rows) const;
+	void render(const Bin &items, const PixelRect &region, uint8_t *pixels,
+			size_t stride) const;
+	void composite(const RasterItem &item, const PixelRect &region,
+			uint8_t *pixels, size_t stride) const;
+	void paint(const RasterItem &item, Bitmap &strip) const;
+	void addRing(RasterItem &item, const std::vector<Point> &points) const;
+	Point toPixels(const Point &point) const;
+	std::vector<Point> toPixels(const std::vector<Point> &points) const;
+	Box m_viewBox;
+	double m_pixelSize;
+	int m_width;
+	int m_height;
+	unsigned int m_tileSize;
+	unsigned int m_threads;
+	unsigned int m_stripHeight;
+	Tessellator m_tessellator;
+	std::vector<std::shared_ptr<RasterItem>> m_items;
+};
+
+} /* namespace gerbex */
+
+#endif /* RASTERSERIALIZER_H_ */
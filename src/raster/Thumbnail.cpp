@@ -0,0 +1,119 @@
+/*
+ * Thumbnail.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BlockAperture.h"
+#include "Flash.h"
+#include "Thumbnail.h"
+#include "Instrument.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace gerbex {
+
+static double thumbnailPixel(const Box &viewBox, int size) {
+	if (size <= 0) {
+		throw std::invalid_argument("thumbnail size must be positive");
+	}
+	return std::max(viewBox.GetWidth(), viewBox.GetHeight()) / size;
+}
+
+static bool overlaps(const Box &a, const Box &b) {
+	return a.GetLeft() <= b.GetRight() && b.GetLeft() <= a.GetRight()
+			&& a.GetBottom() <= b.GetTop() && b.GetBottom() <= a.GetTop();
+}
+
+Thumbnail::Thumbnail(const Box &viewBox, int size) :
+		m_viewBox { viewBox }, m_pixelSize { thumbnailPixel(viewBox, size) }, m_raster {
+				viewBox, m_pixelSize }, m_fillTarget { }, m_fillPolarity {
+				Polarity::Dark } {
+	m_raster.SetTiling(RasterSerializer::kDefaultTileSize, 1);
+}
+
+void Thumbnail::Add(
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects) {
+	for (const std::shared_ptr<GraphicalObject> &object : objects) {
+		add(*object, Point());
+	}
+}
+
+void Thumbnail::Save(std::ostream &stream, const std::string &extension) {
+	m_raster.Save(stream, extension);
+}
+
+void Thumbnail::SaveFile(const std::string &path) {
+	m_raster.SaveFile(path);
+}
+
+int Thumbnail::GetWidth() const {
+	return m_raster.GetWidth();
+}
+
+int Thumbnail::GetHeight() const {
+	return m_raster.GetHeight();
+}
+
+std::vector<uint8_t> Thumbnail::Render() const {
+	return m_raster.Render();
+}
+
+void Thumbnail::add(const GraphicalObject &object, const Point &origin) {
+	Box box = object.GetBox().Translate(origin);
+	if (!overlaps(box, m_viewBox)) {
+		return;
+	}
+	double detail = kDetailPixels * m_pixelSize;
+	if (box.GetWidth() <= detail && box.GetHeight() <= detail) {
+		fillBox(box, object.GetPolarity());
+		return;
+	}
+	Instrument::Count("cast", "Thumbnail::add");
+	const Flash *flash = dynamic_cast<const Flash*>(&object);
+	if (flash) {
+		std::shared_ptr<BlockAperture> block = std::dynamic_pointer_cast<
+				BlockAperture>(flash->GetAperture());
+		if (block) {
+			for (const std::shared_ptr<GraphicalObject> &child : *block->GetObjectList()) {
+				add(*child, flash->GetOrigin() + origin);
+			}
+			return;
+		}
+	}
+	// Full geometry gets its own target, later fills must not join ones
+	// painted before it
+	m_fillTarget.reset();
+	object.Serialize(m_raster, origin);
+}
+
+void Thumbnail::fillBox(const Box &box, Polarity polarity) {
+	// Consecutive fills of one polarity unite, so they can share a target
+	if (!m_fillTarget || polarity != m_fillPolarity) {
+		m_fillTarget = m_raster.GetTarget(polarity);
+		m_fillPolarity = polarity;
+	}
+	double width = std::max(box.GetWidth(), m_pixelSize);
+	double height = std::max(box.GetHeight(), m_pixelSize);
+	double left = box.GetLeft() + 0.5 * (box.GetWidth() - width);
+	double bottom = box.GetBottom() + 0.5 * (box.GetHeight() - height);
+	m_raster.AddPolygon(m_fillTarget, { Point(left, bottom), Point(
+			left + width, bottom), Point(left + width, bottom + height), Point(
+			left, bottom + height) });
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,77 @@
+/*
+ * Thumbnail.h
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef THUMBNAIL_H_
+#define THUMBNAIL_H_
+
+#include "Box.h"
+#include "GraphicalObject.h"
+#include "Point.h"
+#include "RasterSerializer.h"
+#include "Serializer.h"
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gerbex {
+
+/*
+ * Small previews rendered straight from the processed objects. Objects
+ * outside the view box are skipped, and any no more than a few pixels
+ * across is filled as its box, grown to at least one pixel, without
+ * building its geometry. Block apertures are walked object by object so
+ * the same holds at every level, and macros only expand when large enough
+ * to show their shape.
+ *
+ * Rendering stays on the calling thread, as thumbnails are made many at
+ * once.
+ */
+class Thumbnail {
+public:
+	// Longest side in pixels, covering the view box
+	Thumbnail(const Box &viewBox, int size = kDefaultSize);
+	virtual ~Thumbnail() = default;
+	void Add(const std::vector<std::shared_ptr<GraphicalObject>> &objects);
+	// Writes PNG or PGM by file extension
+	void Save(std::ostream &stream, const std::string &extension);
+	void SaveFile(const std::string &path);
+	int GetWidth() const;
+	int GetHeight() const;
+	// Rows top down, GetWidth bytes each
+	std::vector<uint8_t> Render() const;
+	static constexpr int kDefaultSize = 256;
+	// Objects up to this many pixels across are filled as their box
+	static constexpr double kDetailPixels = 2.0;
+
+private:
+	void add(const GraphicalObject &object, const Point &origin);
+	void fillBox(const Box &box, Polarity polarity);
+	Box m_viewBox;
+	double m_pixelSize;
+	RasterSerializer m_raster;
+	pSerialItem m_fillTarget;
+	Polarity m_fillPolarity;
+};
+
+} /* namespace gerbex */
+
+#endif /* THUMBNAIL_H_ */
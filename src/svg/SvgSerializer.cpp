@@ -21,13 +21,23 @@
 #include "ArcSegment.h"
 #include "Contour.h"
 #include "SvgSerializer.h"
-#include <fstream>
+#include "Instrument.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <vector>
 
 namespace gerbex {
 
+// Chunks per worker thread, so that uneven chunks still balance out
+const size_t CHUNKS_PER_THREAD = 4;
+
+// Contours spanning fewer pixels than this are drawn as their bounding box
+const double TINY_CONTOUR_PIXELS = 4.0;
+
 // SVG Y-axis has 0 at the top, whereas Gerber has 0 at the bottom.
 // This class negates all Y-coords to compensate.
 // This is also results in the arc CW vs CCW being reversed.
@@ -38,15 +48,32 @@ namespace gerbex {
 //		top 	-> -1 * min y
 
 SvgSerializer::SvgSerializer(const Box &viewBox, double scaling) {
+	m_fgColor = "black";
+	m_scaling = scaling;
+	m_viewBox = scaleBox(viewBox);
+	m_pixelSize = 0.0;
+	m_nesting = 0;
+	initDocument();
+}
+
+SvgSerializer::SvgSerializer(const SvgSerializer &parent,
+		const std::string &idPrefix, unsigned int nesting) {
+	m_fgColor = parent.m_fgColor;
+	m_scaling = parent.m_scaling;
+	m_viewBox = parent.m_viewBox;
+	m_pixelSize = parent.m_pixelSize;
+	m_idPrefix = idPrefix;
+	m_nesting = nesting;
+	initDocument();
+}
+
+void SvgSerializer::initDocument() {
 	m_svg = m_doc.append_child("svg");
 	m_svg.append_attribute("xmlns") = "http://www.w3.org/2000/svg";
 	m_defs = m_svg.append_child("defs");
-	m_fgColor = "black";
 	m_maskCounter = 0;
 	m_lastGroup = pugi::xml_node();
 	m_lastMask = pugi::xml_node();
-	m_scaling = scaling;
-	m_viewBox = scaleBox(viewBox);
 	m_polarity = Polarity::Dark;
 }
 
@@ -65,9 +92,236 @@ void SvgSerializer::setViewBox(const FixedBox &box) {
 	m_svg.append_attribute("viewBox") = box_stream.str().c_str();
 }
 
-void SvgSerializer::SaveFile(const std::string &path) {
+void SvgSerializer::Save(std::ostream &stream, const std::string &extension) {
+	(void) extension;
 	setViewBox(m_viewBox);
-	m_doc.save_file(path.c_str());
+	if (!m_layers.empty()) {
+		saveLayers(stream);
+	} else if (!m_fragments.empty()) {
+		saveFragments(stream);
+	} else {
+		m_doc.save(stream);
+	}
+}
+
+void SvgSerializer::SerializeParallel(
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+		unsigned int threads) {
+	m_fragments = serializeChunks(objects, threads, "", 0);
+}
+
+void SvgSerializer::AddLayer(const std::string &name,
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+		const std::string &color, double opacity, unsigned int threads) {
+	std::string prefix = "l" + std::to_string(m_layers.size()) + "-";
+	m_layers.push_back( { name, color, opacity, serializeChunks(objects,
+			threads, prefix, 1) });
+}
+
+std::vector<SvgFragment> SvgSerializer::serializeChunks(
+		const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+		unsigned int threads, const std::string &idPrefix,
+		unsigned int nesting) const {
+	ThreadPool pool(threads);
+	size_t numChunks = std::min(objects.size(),
+			CHUNKS_PER_THREAD * pool.GetThreadCount());
+	std::vector<std::future<SvgFragment>> results;
+	for (size_t i = 0; i < numChunks; i++) {
+		size_t begin = i * objects.size() / numChunks;
+		size_t end = (i + 1) * objects.size() / numChunks;
+		std::string prefix = idPrefix + "c" + std::to_string(i) + "-";
+		results.push_back(
+				pool.Submit([this, &objects, begin, end, prefix, nesting]() {
+					SvgSerializer chunk(*this, prefix, nesting);
+					for (size_t j = begin; j < end; j++) {
+						objects[j]->Serialize(chunk, Point());
+					}
+					return chunk.GetFragment();
+				}));
+	}
+	std::vector<SvgFragment> fragments;
+	for (std::future<SvgFragment> &result : results) {
+		fragments.push_back(result.get());
+	}
+	return fragments;
+}
+
+SvgFragment SvgSerializer::GetFragment() const {
+	// Depths match the nodes' final position in the document:
+	// svg > g > object, and svg > defs > g > object, with dark runs nested
+	// in any groups above them
+	SvgFragment fragment;
+	for (const auto& [polarity, node] : m_runs) {
+		std::ostringstream markup;
+		unsigned int depth = polarity == Polarity::Dark ? 2 + m_nesting : 3;
+		for (pugi::xml_node child : node.children()) {
+			child.print(markup, "\t", pugi::format_default,
+					pugi::encoding_auto, depth);
+		}
+		fragment.runs.push_back( { polarity, markup.str() });
+	}
+	std::ostringstream masks;
+	for (pugi::xml_node mask : m_defs.child("macro-masks").children()) {
+		mask.print(masks, "\t", pugi::format_default, pugi::encoding_auto, 3);
+	}
+	fragment.masks = masks.str();
+	return fragment;
+}
+
+static std::string escapeAttribute(const std::string &value) {
+	std::string escaped;
+	for (char c : value) {
+		switch (c) {
+		case '&':
+			escaped += "&amp;";
+			break;
+		case '<':
+			escaped += "&lt;";
+			break;
+		case '"':
+			escaped += "&quot;";
+			break;
+		default:
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+static void writeGroup(std::ostream &stream, const std::string &indent,
+		const std::string &attributes, const std::string &markup) {
+	stream << indent << "<g" << attributes;
+	if (markup.empty()) {
+		stream << " />\n";
+	} else {
+		stream << ">\n" << markup << indent << "</g>\n";
+	}
+}
+
+SvgSerializer::StitchedRuns SvgSerializer::stitchRuns(
+		const std::vector<SvgFragment> &fragments) {
+	// Stitch together runs that continue across chunk boundaries
+	StitchedRuns stitched { { }, "", 0 };
+	for (const SvgFragment &fragment : fragments) {
+		stitched.masks += fragment.masks;
+		for (const SvgFragment::Run &run : fragment.runs) {
+			if (!stitched.runs.empty()
+					&& stitched.runs.back().polarity == run.polarity) {
+				stitched.runs.back().markup += run.markup;
+			} else {
+				stitched.runs.push_back(run);
+				stitched.numMasks += run.polarity == Polarity::Clear;
+			}
+		}
+	}
+	return stitched;
+}
+
+void SvgSerializer::saveFragments(std::ostream &stream) const {
+	StitchedRuns stitched = stitchRuns(m_fragments);
+	writeOpenTag(stream);
+	if (stitched.numMasks == 0 && stitched.masks.empty()) {
+		stream << "\t<defs />\n";
+	} else {
+		stream << "\t<defs>\n";
+		writeMasks(stream, stitched, "");
+		stream << "\t</defs>\n";
+	}
+	writeGroups(stream, stitched, m_fgColor, "", "\t");
+	stream << "</svg>\n";
+}
+
+void SvgSerializer::saveLayers(std::ostream &stream) const {
+	std::vector<StitchedRuns> layers;
+	bool anyMasks = false;
+	for (const SvgLayer &layer : m_layers) {
+		layers.push_back(stitchRuns(layer.fragments));
+		anyMasks |= layers.back().numMasks > 0 || !layers.back().masks.empty();
+	}
+
+	writeOpenTag(stream);
+	if (!anyMasks) {
+		stream << "\t<defs />\n";
+	} else {
+		stream << "\t<defs>\n";
+		for (size_t i = 0; i < layers.size(); i++) {
+			writeMasks(stream, layers[i], "l" + std::to_string(i) + "-");
+		}
+		stream << "\t</defs>\n";
+	}
+	for (size_t i = 0; i < layers.size(); i++) {
+		const SvgLayer &layer = m_layers[i];
+		std::ostringstream attributes;
+		attributes << " id=\"l" << i << "\" data-name=\""
+				<< escapeAttribute(layer.name) << "\" opacity=\""
+				<< layer.opacity << "\"";
+		std::ostringstream groups;
+		writeGroups(groups, layers[i], layer.color,
+				"l" + std::to_string(i) + "-", "\t\t");
+		writeGroup(stream, "\t", attributes.str(), groups.str());
+	}
+	stream << "</svg>\n";
+}
+
+void SvgSerializer::writeOpenTag(std::ostream &stream) const {
+	stream << "<?xml version=\"1.0\"?>\n<svg";
+	for (pugi::xml_attribute attr : m_svg.attributes()) {
+		stream << " " << attr.name() << "=\"" << escapeAttribute(attr.value())
+				<< "\"";
+	}
+	stream << ">\n";
+}
+
+void SvgSerializer::writeMasks(std::ostream &stream,
+		const StitchedRuns &stitched, const std::string &idPrefix) const {
+	// Each global mask hides its own clear run and all following ones
+	if (!stitched.masks.empty()) {
+		stream << "\t\t<macro-masks>\n" << stitched.masks
+				<< "\t\t</macro-masks>\n";
+	}
+	size_t maskIndex = 0;
+	for (const SvgFragment::Run &run : stitched.runs) {
+		if (run.polarity == Polarity::Dark) {
+			continue;
+		}
+		std::string id = idPrefix + "mask" + std::to_string(maskIndex);
+		pugi::xml_document doc;
+		pugi::xml_node mask = doc.append_child("mask");
+		mask.append_attribute("id") = id.c_str();
+		pugi::xml_node rect = mask.append_child("rect");
+		setBox(rect, m_viewBox);
+		rect.append_attribute("fill") = "white";
+		for (size_t i = maskIndex; i < stitched.numMasks; i++) {
+			std::string href = "#" + idPrefix + "mask" + std::to_string(i)
+					+ "-objects";
+			mask.append_child("use").append_attribute("href") = href.c_str();
+		}
+		mask.print(stream, "\t", pugi::format_default, pugi::encoding_auto, 2);
+		writeGroup(stream, "\t\t", " id=\"" + id + "-objects\"", run.markup);
+		maskIndex++;
+	}
+}
+
+void SvgSerializer::writeGroups(std::ostream &stream,
+		const StitchedRuns &stitched, const std::string &color,
+		const std::string &idPrefix, const std::string &indent) const {
+	// A group is masked by the clear run that immediately follows it
+	std::string escaped = escapeAttribute(color);
+	size_t maskIndex = 0;
+	const std::vector<SvgFragment::Run> &runs = stitched.runs;
+	for (size_t i = 0; i < runs.size(); i++) {
+		if (runs[i].polarity == Polarity::Clear) {
+			maskIndex++;
+			continue;
+		}
+		std::string attributes = " fill=\"" + escaped + "\" stroke=\""
+				+ escaped + "\" stroke-width=\"0\"";
+		if (i + 1 < runs.size()) {
+			attributes += " mask=\"url(#" + idPrefix + "mask"
+					+ std::to_string(maskIndex) + ")\"";
+		}
+		writeGroup(stream, indent, attributes, runs[i].markup);
+	}
 }
 
 std::string SvgSerializer::makePathArc(const ArcSegment &segment) {
@@ -93,6 +347,58 @@ std::string SvgSerializer::makePathLine(const Segment &segment) {
 	return d.str();
 }
 
+void SvgSerializer::SetPixelSize(double size) {
+	if (size < 0.0) {
+		throw std::invalid_argument("pixel size must be non-negative");
+	}
+	m_pixelSize = size;
+}
+
+bool SvgSerializer::isSubPixel(const Box &box) const {
+	return box.GetWidth() < m_pixelSize && box.GetHeight() < m_pixelSize;
+}
+
+bool SvgSerializer::isTiny(const Box &box) const {
+	double limit = TINY_CONTOUR_PIXELS * m_pixelSize;
+	return box.GetWidth() < limit && box.GetHeight() < limit;
+}
+
+bool SvgSerializer::isFlat(const ArcSegment &segment) const {
+	// Compare the sagitta, the arc's furthest distance from its chord
+	Point start = segment.GetStart() - segment.GetCenter();
+	Point end = segment.GetEnd() - segment.GetCenter();
+	double sweep = std::atan2(end.GetY(), end.GetX())
+			- std::atan2(start.GetY(), start.GetX());
+	if (segment.GetDirection() == ArcDirection::Clockwise) {
+		sweep = -sweep;
+	}
+	if (sweep <= 0.0) {
+		sweep += 2.0 * M_PI;
+	}
+	double sagitta = segment.GetRadius() * (1.0 - std::cos(sweep / 2.0));
+	return sagitta < 0.5 * m_pixelSize;
+}
+
+void SvgSerializer::addPixel(pugi::xml_node node, const Box &box) {
+	// Features sharing a pixel in the same parent only emit it once
+	double x = std::floor((box.GetLeft() + 0.5 * box.GetWidth()) / m_pixelSize);
+	double y = std::floor(
+			(box.GetBottom() + 0.5 * box.GetHeight()) / m_pixelSize);
+	auto key = std::make_tuple(
+			static_cast<const void*>(node.internal_object()),
+			static_cast<FixedPointType>(x), static_cast<FixedPointType>(y));
+	if (m_pixels.insert(key).second) {
+		addRect(node,
+				Box(m_pixelSize, m_pixelSize, x * m_pixelSize,
+						y * m_pixelSize));
+	}
+}
+
+void SvgSerializer::addRect(pugi::xml_node node, const Box &box) {
+	pugi::xml_node rect = node.append_child("rect");
+	setBox(rect, scaleBox(box));
+}
+
 void SvgSerializer::SetForeground(const std::string &color) {
 	m_fgColor = color;
 }
@@ -119,7 +425,7 @@ pugi::xml_node SvgSerializer::newGlobalGroup() {
 pugi::xml_node SvgSerializer::newMask(pugi::xml_node parent,
 		const FixedBox &box) {
 	pugi::xml_node mask = parent.append_child("mask");
-	std::string maskId = "mask" + std::to_string(m_maskCounter);
+	std::string maskId = m_idPrefix + "mask" + std::to_string(m_maskCounter);
 	m_maskCounter++;
 	mask.append_attribute("id") = maskId.c_str();
 	pugi::xml_node rect = mask.append_child("rect");
@@ -160,7 +466,9 @@ pugi::xml_node SvgSerializer::newGlobalMask(const FixedBox &box) {
 void SvgSerializer::AddArc(pSerialItem target, double width,
 		const ArcSegment &segment) {
 	pugi::xml_node node = SvgItem::GetNode(target);
-	if (segment.IsCircle()) {
+	if (isSubPixel(segment.GetBox().Pad(0.5 * width))) {
+		addPixel(node, segment.GetBox());
+	} else if (segment.IsCircle()) {
 		FixedPoint c = scalePoint(segment.GetCenter());
 		pugi::xml_node circle = node.append_child("circle");
 		circle.append_attribute("r") = scaleValue(segment.GetRadius());
@@ -172,7 +480,11 @@ void SvgSerializer::AddArc(pSerialItem target, double width,
 		FixedPoint s = scalePoint(segment.GetStart());
 		std::stringstream d;
 		d << "M " << s.GetX() << " " << s.GetY() << " ";
-		d << makePathArc(segment);
+		if (isFlat(segment)) {
+			d << makePathLine(segment);
+		} else {
+			d << makePathArc(segment);
+		}
 		pugi::xml_node path = node.append_child("path");
 		path.append_attribute("d") = d.str().c_str();
 		path.append_attribute("fill") = "none";
@@ -184,6 +496,11 @@ void SvgSerializer::AddArc(pSerialItem target, double width,
 void SvgSerializer::AddCircle(pSerialItem target, double radius,
 		const Point &center) {
 	pugi::xml_node node = SvgItem::GetNode(target);
+	Box box(2.0 * radius, center);
+	if (isSubPixel(box)) {
+		addPixel(node, box);
+		return;
+	}
 	pugi::xml_node circle = node.append_child("circle");
 	FixedPoint c = scalePoint(center);
 	circle.append_attribute("r") = scaleValue(radius);
@@ -197,21 +514,44 @@ void SvgSerializer::AddContour(pSerialItem target, const Contour &contour) {
 		const std::vector<std::shared_ptr<Segment>> segments =
 				contour.GetSegments();
 
+		if (m_pixelSize > 0.0) {
+			Box box = segments[0]->GetBox();
+			for (std::shared_ptr<Segment> segment : segments) {
+				box = box.Extend(segment->GetBox());
+			}
+			if (isSubPixel(box)) {
+				addPixel(node, box);
+				return;
+			} else if (isTiny(box)) {
+				addRect(node, box);
+				return;
+			}
+		}
+
 		FixedPoint s = scalePoint(segments[0]->GetStart());
 		std::stringstream d;
 		d << "M " << s.GetX() << " " << s.GetY() << " ";
+		Point last = segments[0]->GetStart();
 		for (std::shared_ptr<Segment> segment : segments) {
+			// Drop vertices within a pixel of the previous one
+			if (segment != segments.back()
+					&& segment->GetEnd().Distance(last) < m_pixelSize) {
+				continue;
+			}
+			Instrument::Count("cast", "SvgSerializer::AddContour");
 			std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<
 					ArcSegment>(segment);
-			if (arc) {
+			if (arc && !isFlat(*arc)) {
 				d << makePathArc(*arc);
 			} else {
 				d << makePathLine(*segment);
 			}
+			last = segment->GetEnd();
 		}
 		pugi::xml_node path = node.append_child("path");
 		path.append_attribute("d") = d.str().c_str();
 	} else {
+		Instrument::Count("cast", "SvgSerializer::AddContour");
 		const std::shared_ptr<ArcSegment> arc = std::dynamic_pointer_cast<
 				ArcSegment>(contour.GetSegments().back());
 		AddCircle(target, arc->GetRadius(), arc->GetCenter());
@@ -221,6 +561,10 @@ void SvgSerializer::AddContour(pSerialItem target, const Contour &contour) {
 void SvgSerializer::AddDraw(pSerialItem target, double width,
 		const Segment &segment) {
 	pugi::xml_node node = SvgItem::GetNode(target);
+	if (isSubPixel(segment.GetBox().Pad(0.5 * width))) {
+		addPixel(node, segment.GetBox());
+		return;
+	}
 	FixedPoint s = scalePoint(segment.GetStart());
 	FixedPoint e = scalePoint(segment.GetEnd());
 	pugi::xml_node line = node.append_child("line");
@@ -236,6 +580,16 @@ void SvgSerializer::AddDraw(pSerialItem target, double width,
 void SvgSerializer::AddPolygon(pSerialItem target,
 		const std::vector<Point> &points) {
 	pugi::xml_node node = SvgItem::GetNode(target);
+	if (m_pixelSize > 0.0) {
+		Box box(points);
+		if (isSubPixel(box)) {
+			addPixel(node, box);
+			return;
+		} else if (isTiny(box)) {
+			addRect(node, box);
+			return;
+		}
+	}
 	pugi::xml_node poly = node.append_child("polygon");
 	std::stringstream pts_stream;
 	for (const Point &point : points) {
@@ -276,12 +630,14 @@ pSerialItem SvgSerializer::GetTarget(Polarity polarity) {
 	if (polarity == Polarity::Dark) {
 		if (!m_lastGroup || m_polarity == Polarity::Clear) {
 			m_lastGroup = newGlobalGroup();
+			m_runs.push_back( { polarity, m_lastGroup });
 		}
 		target = m_lastGroup;
 	} else {
 		if (!m_lastMask || m_polarity == Polarity::Dark) {
 			m_lastMask = newGlobalMask(m_viewBox);
 			setMask(m_lastGroup, m_lastMask);
+			m_runs.push_back( { polarity, m_lastMask });
 		}
 		target = m_lastMask;
 	}
@@ -23,9 +23,14 @@
 
 #include "Box.h"
 #include "GraphicalObject.h"
+#include "Instrument.h"
 #include "Point.h"
 #include "Serializer.h"
+#include <memory>
+#include <ostream>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <pugixml.hpp>
 
@@ -44,6 +49,7 @@ public:
 		return m_node;
 	}
 	static pugi::xml_node GetNode(pSerialItem item) {
+		Instrument::Count("cast", "SvgItem::GetNode");
 		std::shared_ptr<SvgItem> svg = std::dynamic_pointer_cast<SvgItem>(item);
 		if (!svg) {
 			throw std::invalid_argument("Svg received non-Svg item");
@@ -55,6 +61,29 @@ private:
 	pugi::xml_node m_node;
 };
 
+/*
+ * Markup for a contiguous chunk of objects, as runs of equal polarity.
+ * Dark runs become global groups, clear runs become global mask objects.
+ */
+struct SvgFragment {
+	struct Run {
+		Polarity polarity;
+		std::string markup;
+	};
+	std::string masks;
+	std::vector<Run> runs;
+};
+
+/*
+ * Fragments of one layer in a stack, drawn in its own colour and opacity.
+ */
+struct SvgLayer {
+	std::string name;
+	std::string color;
+	double opacity;
+	std::vector<SvgFragment> fragments;
+};
+
 /*
  *
  */
@@ -63,7 +92,26 @@ public:
 	SvgSerializer(const Box &viewBox, double scaling = 1000.0);
 	virtual ~SvgSerializer() = default;
 	void SetViewPort(int width, int height);
-	void SaveFile(const std::string &path) override;
+	// Writes SVG whatever the extension
+	void Save(std::ostream &stream, const std::string &extension) override;
+	// Serializes chunks of objects into fragments on worker threads.
+	// The fragments replace the document content when saving.
+	void SerializeParallel(
+			const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+			unsigned int threads = 0);
+	SvgFragment GetFragment() const;
+	// Serializes the objects on worker threads as a layer over any added
+	// before, in its own group. Layers replace the document content when
+	// saving.
+	void AddLayer(const std::string &name,
+			const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+			const std::string &color, double opacity = 1.0,
+			unsigned int threads = 0);
+	// Level of detail for previews, as the size of one output pixel.
+	// Sub-pixel features are merged into pixels, arcs flatter than a pixel
+	// become chords and tiny contours become their bounding box.
+	// Zero, the default, keeps full detail.
+	void SetPixelSize(double size);
 	void SetForeground(const std::string &color);
 	void SetBackground(const std::string &color);
 	pSerialItem NewGroup(pSerialItem parent) override;
@@ -81,6 +129,29 @@ public:
 	pSerialItem GetTarget(Polarity polarity) override;
 
 private:
+	// Runs of consecutive fragments joined where their polarity continues
+	struct StitchedRuns {
+		std::vector<SvgFragment::Run> runs;
+		std::string masks;
+		size_t numMasks;
+	};
+	// Nesting is the depth of groups between the document and its runs
+	SvgSerializer(const SvgSerializer &parent, const std::string &idPrefix,
+			unsigned int nesting = 0);
+	void initDocument();
+	std::vector<SvgFragment> serializeChunks(
+			const std::vector<std::shared_ptr<GraphicalObject>> &objects,
+			unsigned int threads, const std::string &idPrefix,
+			unsigned int nesting) const;
+	static StitchedRuns stitchRuns(const std::vector<SvgFragment> &fragments);
+	void saveFragments(std::ostream &stream) const;
+	void saveLayers(std::ostream &stream) const;
+	void writeOpenTag(std::ostream &stream) const;
+	void writeMasks(std::ostream &stream, const StitchedRuns &stitched,
+			const std::string &idPrefix) const;
+	void writeGroups(std::ostream &stream, const StitchedRuns &stitched,
+			const std::string &color, const std::string &idPrefix,
+			const std::string &indent) const;
 	FixedPointType scaleValue(double value) const;
 	FixedPoint scalePoint(const Point &point) const;
 	FixedBox scaleBox(const Box &box) const;
@@ -92,6 +163,11 @@ private:
 	std::string makePathLine(const Segment &segment);
 	void setBox(pugi::xml_node node, const FixedBox &box) const;
 	void setMask(pugi::xml_node target, pugi::xml_node mask) const;
+	bool isSubPixel(const Box &box) const;
+	bool isTiny(const Box &box) const;
+	bool isFlat(const ArcSegment &segment) const;
+	void addPixel(pugi::xml_node node, const Box &box);
+	void addRect(pugi::xml_node node, const Box &box);
 	pugi::xml_document m_doc;
 	pugi::xml_node m_svg;
 	pugi::xml_node m_defs;
@@ -102,6 +178,13 @@ private:
 	pugi::xml_node m_lastGroup;
 	pugi::xml_node m_lastMask;
 	Polarity m_polarity;
+	std::string m_idPrefix;
+	std::vector<std::pair<Polarity, pugi::xml_node>> m_runs;
+	std::vector<SvgFragment> m_fragments;
+	std::vector<SvgLayer> m_layers;
+	unsigned int m_nesting;
+	double m_pixelSize;
+	std::set<std::tuple<const void*, FixedPointType, FixedPointType>> m_pixels;
 
 };
 
@@ -17,8 +17,14 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include "ArcSegment.h"
 #include "CgalSerializer.h"
+#include "Box.h"
 #include "Point.h"
+#include "Segment.h"
+#include <iterator>
+#include <stdexcept>
+#include <vector>
 #include "CppUTest/TestHarness.h"
 
 namespace gerbex {
@@ -29,12 +35,103 @@ TEST_GROUP(CgalSerializer) {
 	}
 };
 
+template<typename K>
+static void checkOverlap() {
+	CgalSerializer<K> serializer;
+	pSerialItem root = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(root, { Point(-10.0, -10.0), Point(10.0, -10.0),
+			Point(0.0, -5.0) });
+	serializer.AddCircle(root, 1.0, Point(0.0, -7.0));
+	serializer.AddCircle(root, 1.0, Point(20.0, 20.0));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 0.5, Point(20.0, 20.0));
+	typename CgalSerializer<K>::Polygon_set_2 result =
+			serializer.GetPolygonSet();
+	LONGS_EQUAL(2, result.number_of_polygons_with_holes());
+}
+
 TEST(CgalSerializer, MakeFile) {
-	CgalSerializer serializer;
+	CgalSerializer<Epec> serializer;
 	pSerialItem root = serializer.GetTarget(Polarity::Dark);
 	serializer.AddPolygon(root, { Point(-10.0, -10.0), Point(10.0, -10.0),
 			Point(0.0, -5.0) });
 }
 
+TEST(CgalSerializer, Epick) {
+	checkOverlap<Epick>();
+}
+
+TEST(CgalSerializer, Epec) {
+	checkOverlap<Epec>();
+}
+
+TEST(CgalSerializer, GridKernel) {
+	checkOverlap<GridKernel>();
+}
+
+TEST(CgalSerializer, MaskFilledAfterSet) {
+	CgalSerializer<Epec> serializer;
+	pSerialItem root = serializer.GetTarget(Polarity::Dark);
+	pSerialItem group = serializer.NewGroup(root);
+	pSerialItem mask = serializer.NewMask(Box(4.0, 4.0, -2.0, -2.0));
+	serializer.SetMask(group, mask);
+	serializer.AddCircle(group, 2.0, Point(0.0, 0.0));
+	serializer.AddCircle(mask, 1.0, Point(0.0, 0.0));
+	CgalSerializer<Epec>::Polygon_set_2 result = serializer.GetPolygonSet();
+	std::vector<CgalSerializer<Epec>::Polygon_with_holes_2> polygons;
+	result.polygons_with_holes(std::back_inserter(polygons));
+	LONGS_EQUAL(1, polygons.size());
+	LONGS_EQUAL(1, polygons.front().number_of_holes());
+}
+
+TEST(CgalSerializer, PolarityRuns) {
+	CgalSerializer<Epec> serializer;
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 1.0,
+			Point(0.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 1.0,
+			Point(5.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Clear), 2.0,
+			Point(0.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Clear), 2.0,
+			Point(5.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 0.5,
+			Point(0.0, 0.0));
+	LONGS_EQUAL(1, serializer.GetPolygonSet().number_of_polygons_with_holes());
+}
+TEST(CgalSerializer, ZeroTiles) {
+	CgalSerializer<Epec> serializer;
+	CHECK_THROWS(std::invalid_argument, serializer.SetTiling(0));
+}
+
+TEST(CgalSerializer, TiledMatchesUntiled) {
+	CgalSerializer<Epec> serializer;
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddArc(dark, 1.0,
+			ArcSegment(Point(10.0, 0.0), Point(10.0, 0.0), Point(-10.0, 0.0),
+					ArcDirection::CounterClockwise));
+	serializer.AddDraw(dark, 2.0, Segment(Point(-12.0, 0.0), Point(12.0, 0.0)));
+	serializer.AddCircle(dark, 3.0, Point(0.0, 0.0));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 1.0, Point(0.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 0.5,
+			Point(20.0, 20.0));
+
+	std::vector<CgalSerializer<Epec>::Polygon_with_holes_2> untiled;
+	serializer.GetPolygonSet().polygons_with_holes(
+			std::back_inserter(untiled));
+	serializer.SetTiling(4, 3);
+	std::vector<CgalSerializer<Epec>::Polygon_with_holes_2> tiled;
+	serializer.GetPolygonSet().polygons_with_holes(std::back_inserter(tiled));
+
+	LONGS_EQUAL(2, untiled.size());
+	LONGS_EQUAL(untiled.size(), tiled.size());
+	size_t untiledHoles = 0;
+	size_t tiledHoles = 0;
+	for (size_t i = 0; i < untiled.size(); i++) {
+		untiledHoles += untiled[i].number_of_holes();
+		tiledHoles += tiled[i].number_of_holes();
+	}
+	LONGS_EQUAL(untiledHoles, tiledHoles);
+}
 
 } /* namespace gerbex */
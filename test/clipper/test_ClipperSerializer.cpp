@@ -0,0 +1,105 @@
+/*
+ * test_ClipperSerializer.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ArcSegment.h"
+#include "ClipperSerializer.h"
+#include "Box.h"
+#include "Point.h"
+#include "Segment.h"
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(ClipperSerializer) {
+	ClipperSerializer serializer;
+};
+
+TEST(ClipperSerializer, InvalidScaling) {
+	CHECK_THROWS(std::invalid_argument, ClipperSerializer(0.0));
+}
+
+TEST(ClipperSerializer, Overlap) {
+	pSerialItem root = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(root, { Point(-10.0, -10.0), Point(10.0, -10.0),
+			Point(0.0, -5.0) });
+	serializer.AddCircle(root, 1.0, Point(0.0, -7.0));
+	serializer.AddCircle(root, 1.0, Point(20.0, 20.0));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 0.5, Point(20.0, 20.0));
+	std::vector<Outline> result = serializer.GetOutlines();
+	LONGS_EQUAL(2, result.size());
+	LONGS_EQUAL(1, result[0].holes.size() + result[1].holes.size());
+}
+
+TEST(ClipperSerializer, MaskFilledAfterSet) {
+	pSerialItem root = serializer.GetTarget(Polarity::Dark);
+	pSerialItem group = serializer.NewGroup(root);
+	pSerialItem mask = serializer.NewMask(Box(4.0, 4.0, -2.0, -2.0));
+	serializer.SetMask(group, mask);
+	serializer.AddCircle(group, 2.0, Point(0.0, 0.0));
+	serializer.AddCircle(mask, 1.0, Point(0.0, 0.0));
+	std::vector<Outline> result = serializer.GetOutlines();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(1, result.front().holes.size());
+}
+
+TEST(ClipperSerializer, PolarityRuns) {
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 1.0,
+			Point(0.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 1.0,
+			Point(5.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Clear), 2.0,
+			Point(0.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Clear), 2.0,
+			Point(5.0, 0.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 0.5,
+			Point(0.0, 0.0));
+	std::vector<Outline> result = serializer.GetOutlines();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(0, result.front().holes.size());
+}
+
+TEST(ClipperSerializer, Strokes) {
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddArc(dark, 1.0,
+			ArcSegment(Point(10.0, 0.0), Point(10.0, 0.0), Point(-10.0, 0.0),
+					ArcDirection::CounterClockwise));
+	serializer.AddDraw(dark, 2.0, Segment(Point(-12.0, 0.0), Point(12.0, 0.0)));
+	std::vector<Outline> result = serializer.GetOutlines();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(2, result.front().holes.size());
+}
+
+TEST(ClipperSerializer, SnapsToGrid) {
+	ClipperSerializer coarse(10.0);
+	coarse.AddPolygon(coarse.GetTarget(Polarity::Dark), { Point(0.04, 0.0),
+			Point(1.0, 0.0), Point(1.0, 1.02), Point(0.0, 1.0) });
+	std::vector<Outline> result = coarse.GetOutlines();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(4, result.front().boundary.size());
+	for (const Point &point : result.front().boundary) {
+		DOUBLES_EQUAL(std::round(point.GetX()), point.GetX(), 1e-12);
+		DOUBLES_EQUAL(std::round(point.GetY()), point.GetY(), 1e-12);
+	}
+}
+
+} /* namespace gerbex */
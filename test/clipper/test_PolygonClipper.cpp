@@ -0,0 +1,527 @@
+/*
+ * test_PolygonClipper.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PolygonClipper.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+static IntRing square(int64_t left, int64_t bottom, int64_t size) {
+	return { { left, bottom }, { left + size, bottom }, { left + size, bottom
+			+ size }, { left, bottom + size } };
+}
+
+static double ringArea(const IntRing &ring) {
+	double area = 0.0;
+	for (size_t i = 0; i < ring.size(); i++) {
+		const IntPoint &a = ring[i];
+		const IntPoint &b = ring[(i + 1) % ring.size()];
+		area += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+	}
+	return 0.5 * area;
+}
+
+static double totalArea(const std::vector<IntPolygon> &polygons) {
+	double area = 0.0;
+	for (const IntPolygon &polygon : polygons) {
+		area += ringArea(polygon.outer);
+		for (const IntRing &hole : polygon.holes) {
+			area += ringArea(hole);
+		}
+	}
+	return area;
+}
+
+// Input layers kept for the oracle, painted in order
+struct OracleLayer {
+	Polarity polarity;
+	std::vector<IntRing> polygons;
+	std::vector<IntRing> masks;
+};
+
+static int winding(const IntRing &ring, double x, double y) {
+	int count = 0;
+	for (size_t i = 0; i < ring.size(); i++) {
+		const IntPoint &a = ring[i];
+		const IntPoint &b = ring[(i + 1) % ring.size()];
+		double side = (b.x - a.x) * (y - a.y) - (x - a.x) * (b.y - a.y);
+		if (a.y <= y && b.y > y && side > 0.0) {
+			count++;
+		} else if (a.y > y && b.y <= y && side < 0.0) {
+			count--;
+		}
+	}
+	return count;
+}
+
+// The clipper turns rings to wind positively, and drops those of no area
+static int orientation(const IntRing &ring) {
+	double area = ringArea(ring);
+	return (area > 0.0) - (area < 0.0);
+}
+
+static bool oracleDark(const std::vector<OracleLayer> &layers, double x,
+		double y) {
+	for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+		int inside = 0;
+		int masked = 0;
+		for (const IntRing &ring : layer->polygons) {
+			inside += winding(ring, x, y) * orientation(ring);
+		}
+		for (const IntRing &ring : layer->masks) {
+			masked += winding(ring, x, y) * orientation(ring);
+		}
+		if (inside != 0 && masked == 0) {
+			return layer->polarity == Polarity::Dark;
+		}
+	}
+	return false;
+}
+
+static bool resultDark(const std::vector<IntPolygon> &polygons, double x,
+		double y) {
+	int count = 0;
+	for (const IntPolygon &polygon : polygons) {
+		count += winding(polygon.outer, x, y);
+		for (const IntRing &hole : polygon.holes) {
+			count += winding(hole, x, y);
+		}
+	}
+	return count != 0;
+}
+
+static double distance(const IntPoint &a, const IntPoint &b, double x,
+		double y) {
+	double dx = b.x - a.x;
+	double dy = b.y - a.y;
+	double t = ((x - a.x) * dx + (y - a.y) * dy) / (dx * dx + dy * dy);
+	t = std::clamp(t, 0.0, 1.0);
+	return std::hypot(a.x + t * dx - x, a.y + t * dy - y);
+}
+
+static bool nearEdge(const std::vector<OracleLayer> &layers, double x,
+		double y, double margin) {
+	for (const OracleLayer &layer : layers) {
+		for (const std::vector<IntRing> *rings : { &layer.polygons,
+				&layer.masks }) {
+			for (const IntRing &ring : *rings) {
+				for (size_t i = 0; i < ring.size(); i++) {
+					if (distance(ring[i], ring[(i + 1) % ring.size()], x, y)
+							< margin) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+static bool properlyCross(const IntPoint &a, const IntPoint &b,
+		const IntPoint &c, const IntPoint &d) {
+	auto side = [](const IntPoint &p, const IntPoint &q, const IntPoint &r) {
+		double value = static_cast<double>(q.x - p.x) * (r.y - p.y)
+				- static_cast<double>(q.y - p.y) * (r.x - p.x);
+		return (value > 0.0) - (value < 0.0);
+	};
+	return side(a, b, c) * side(a, b, d) < 0 && side(c, d, a) * side(c, d, b) < 0;
+}
+
+// Input vertices and the points where input edges cross
+static std::vector<std::pair<double, double>> inputVertices(
+		const std::vector<OracleLayer> &layers) {
+	std::vector<IntPoint> starts;
+	std::vector<IntPoint> ends;
+	for (const OracleLayer &layer : layers) {
+		for (const std::vector<IntRing> *rings : { &layer.polygons,
+				&layer.masks }) {
+			for (const IntRing &ring : *rings) {
+				for (size_t i = 0; i < ring.size(); i++) {
+					starts.push_back(ring[i]);
+					ends.push_back(ring[(i + 1) % ring.size()]);
+				}
+			}
+		}
+	}
+	std::vector<std::pair<double, double>> vertices;
+	for (size_t i = 0; i < starts.size(); i++) {
+		const IntPoint &a = starts[i];
+		const IntPoint &b = ends[i];
+		vertices.emplace_back(a.x, a.y);
+		for (size_t j = i + 1; j < starts.size(); j++) {
+			const IntPoint &c = starts[j];
+			const IntPoint &d = ends[j];
+			double denominator = static_cast<double>(b.x - a.x) * (d.y - c.y)
+					- static_cast<double>(b.y - a.y) * (d.x - c.x);
+			if (denominator == 0.0) {
+				continue;
+			}
+			double t = (static_cast<double>(c.x - a.x) * (d.y - c.y)
+					- static_cast<double>(c.y - a.y) * (d.x - c.x))
+					/ denominator;
+			double u = (static_cast<double>(c.x - a.x) * (b.y - a.y)
+					- static_cast<double>(c.y - a.y) * (b.x - a.x))
+					/ denominator;
+			if (t >= 0.0 && t <= 1.0 && u >= 0.0 && u <= 1.0) {
+				vertices.emplace_back(a.x + t * (b.x - a.x),
+						a.y + t * (b.y - a.y));
+			}
+		}
+	}
+	return vertices;
+}
+
+// Rings of nonzero area, oriented, no edge crossing another, vertices only
+// where the input has one rounded to the grid, and every sample clear of
+// the input edges coloured as the winding rule says
+static std::vector<IntPolygon> checkAgainstOracle(
+		const std::vector<OracleLayer> &layers, std::mt19937 &random,
+		int samples, int64_t size) {
+	PolygonClipper clipper;
+	for (const OracleLayer &layer : layers) {
+		size_t index = clipper.AddLayer(layer.polarity);
+		for (const IntRing &ring : layer.polygons) {
+			clipper.AddPolygon(index, ring);
+		}
+		for (const IntRing &ring : layer.masks) {
+			clipper.AddMask(index, ring);
+		}
+	}
+	std::vector<IntPolygon> result = clipper.Execute();
+
+	std::vector<IntPoint> starts;
+	std::vector<IntPoint> ends;
+	for (const IntPolygon &polygon : result) {
+		CHECK(ringArea(polygon.outer) > 0.0);
+		std::vector<const IntRing *> rings { &polygon.outer };
+		for (const IntRing &hole : polygon.holes) {
+			CHECK(ringArea(hole) < 0.0);
+			rings.push_back(&hole);
+		}
+		for (const IntRing *ring : rings) {
+			for (size_t i = 0; i < ring->size(); i++) {
+				starts.push_back((*ring)[i]);
+				ends.push_back((*ring)[(i + 1) % ring->size()]);
+			}
+		}
+	}
+	for (size_t i = 0; i < starts.size(); i++) {
+		for (size_t j = i + 1; j < starts.size(); j++) {
+			CHECK(!properlyCross(starts[i], ends[i], starts[j], ends[j]));
+		}
+	}
+	std::vector<std::pair<double, double>> vertices = inputVertices(layers);
+	for (const IntPoint &start : starts) {
+		CHECK(std::any_of(vertices.begin(), vertices.end(),
+				[&start](const std::pair<double, double> &vertex) {
+					return std::hypot(vertex.first - start.x,
+							vertex.second - start.y) < 0.71;
+				}));
+	}
+
+	std::uniform_real_distribution<double> coordinate(0.0, size);
+	int checked = 0;
+	int wrong = 0;
+	for (int i = 0; i < samples; i++) {
+		double x = coordinate(random);
+		double y = coordinate(random);
+		if (nearEdge(layers, x, y, 2.0)) {
+			continue;
+		}
+		checked++;
+		wrong += oracleDark(layers, x, y) != resultDark(result, x, y);
+	}
+	CHECK(checked > 0);
+	LONGS_EQUAL(0, wrong);
+	return result;
+}
+
+static IntRing randomRing(std::mt19937 &random, int vertices, int64_t size) {
+	std::uniform_int_distribution<int64_t> coordinate(0, size);
+	IntRing ring;
+	for (int i = 0; i < vertices; i++) {
+		ring.push_back( { coordinate(random), coordinate(random) });
+	}
+	return ring;
+}
+
+// Layers of random rings, most of them crossing themselves
+static void checkRandomLayers(int64_t size, int trials, unsigned seed) {
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<int> count(1, 4);
+	std::uniform_int_distribution<int> vertices(3, 8);
+	for (int trial = 0; trial < trials; trial++) {
+		std::vector<OracleLayer> layers;
+		int numLayers = count(random);
+		for (int i = 0; i < numLayers; i++) {
+			OracleLayer layer { i == 0 || random() % 3 != 0 ? Polarity::Dark :
+					Polarity::Clear, { }, { } };
+			int numPolygons = count(random);
+			for (int j = 0; j < numPolygons; j++) {
+				layer.polygons.push_back(
+						randomRing(random, vertices(random), size));
+			}
+			if (random() % 4 == 0) {
+				layer.masks.push_back(randomRing(random, vertices(random), size));
+			}
+			layers.push_back(layer);
+		}
+		checkAgainstOracle(layers, random, 300, size);
+	}
+}
+
+TEST_GROUP(PolygonClipper) {
+	PolygonClipper clipper;
+};
+
+TEST(PolygonClipper, Empty) {
+	LONGS_EQUAL(0, clipper.Execute().size());
+}
+
+TEST(PolygonClipper, UnknownLayer) {
+	CHECK_THROWS(std::invalid_argument,
+			clipper.AddPolygon(0, square(0, 0, 10)));
+}
+
+TEST(PolygonClipper, Single) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(4, result[0].outer.size());
+	LONGS_EQUAL(0, result[0].holes.size());
+	DOUBLES_EQUAL(100.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, ClockwiseInput) {
+	IntRing ring = square(0, 0, 10);
+	IntRing reversed(ring.rbegin(), ring.rend());
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), reversed);
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	DOUBLES_EQUAL(100.0, ringArea(result[0].outer), 1e-9);
+}
+
+TEST(PolygonClipper, UnionOverlapping) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, square(0, 0, 10));
+	clipper.AddPolygon(layer, square(5, 5, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(8, result[0].outer.size());
+	DOUBLES_EQUAL(175.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, UnionAcrossLayers) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10));
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(10, 0, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(4, result[0].outer.size());
+	DOUBLES_EQUAL(200.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, Disjoint) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, square(0, 0, 10));
+	clipper.AddPolygon(layer, square(20, 5, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(2, result.size());
+	DOUBLES_EQUAL(200.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, TouchingCorners) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, square(0, 0, 10));
+	clipper.AddPolygon(layer, square(10, 10, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(2, result.size());
+	LONGS_EQUAL(4, result[0].outer.size());
+	LONGS_EQUAL(4, result[1].outer.size());
+}
+
+TEST(PolygonClipper, ClearMakesHole) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10));
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Clear), square(3, 3, 4));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(1, result[0].holes.size());
+	CHECK(ringArea(result[0].outer) > 0.0);
+	CHECK(ringArea(result[0].holes[0]) < 0.0);
+	DOUBLES_EQUAL(84.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, ClearBeforeDarkHasNoEffect) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Clear), square(3, 3, 4));
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(0, result[0].holes.size());
+}
+
+TEST(PolygonClipper, IslandInHole) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 30));
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Clear), square(5, 5, 20));
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(10, 10, 10));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(2, result.size());
+	size_t holes = result[0].holes.size() + result[1].holes.size();
+	LONGS_EQUAL(1, holes);
+	const IntPolygon &frame = result[0].holes.empty() ? result[1] : result[0];
+	DOUBLES_EQUAL(900.0, ringArea(frame.outer), 1e-9);
+	DOUBLES_EQUAL(900.0 - 400.0 + 100.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, HoleInPolygon) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10),
+			{ square(2, 2, 2) });
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(1, result[0].holes.size());
+	DOUBLES_EQUAL(96.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, MaskOnlyCutsItsLayer) {
+	clipper.AddPolygon(clipper.AddLayer(Polarity::Dark), square(0, 0, 10));
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, square(20, 0, 10));
+	clipper.AddMask(layer, square(0, 0, 30));
+	clipper.AddMask(layer, square(22, 2, 2));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	DOUBLES_EQUAL(100.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, MaskMakesHole) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, square(0, 0, 10));
+	clipper.AddMask(layer, square(4, 4, 2));
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(1, result[0].holes.size());
+	DOUBLES_EQUAL(96.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, Crossing) {
+	// Crossings at non-integer coordinates are rounded to the grid
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, { { 0, 0 }, { 1000, 0 }, { 500, 777 } });
+	clipper.AddPolygon(layer, { { 0, 500 }, { 1000, 500 }, { 500, -333 } });
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(0, result[0].holes.size());
+	LONGS_EQUAL(12, result[0].outer.size());
+	// Vertices move by up to half a step, along a perimeter of about 4000
+	DOUBLES_EQUAL(538295.4, totalArea(result), 1000.0);
+}
+
+TEST(PolygonClipper, ManyOverlappingCircles) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	const int count = 24;
+	for (int i = 0; i < count; i++) {
+		IntRing ring;
+		for (int j = 0; j < 32; j++) {
+			double angle = 2.0 * M_PI * j / 32;
+			ring.push_back( { std::llround(i * 700 + 1000 * cos(angle)),
+					std::llround(1000 * sin(angle)) });
+		}
+		clipper.AddPolygon(layer, ring);
+	}
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(0, result[0].holes.size());
+	CHECK(ringArea(result[0].outer) > 0.0);
+	// Only the arcs on the outside remain, plus their crossings
+	CHECK(result[0].outer.size() <= count * 32);
+}
+
+TEST(PolygonClipper, SlantedEdgeStaysStraight) {
+	// Vertices of other rings split the slanted edge into many slabs
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, { { 0, 0 }, { 1000, 0 }, { 1000, 997 } });
+	for (int64_t y = 10; y < 1000; y += 10) {
+		clipper.AddPolygon(layer, square(2000, y, 3));
+	}
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(100, result.size());
+	size_t triangles = 0;
+	for (const IntPolygon &polygon : result) {
+		triangles += polygon.outer.size() == 3;
+	}
+	LONGS_EQUAL(1, triangles);
+}
+
+TEST(PolygonClipper, RingOfSquaresEnclosesHole) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	clipper.AddPolygon(layer, { { 0, 0 }, { 30, 0 }, { 30, 10 }, { 0, 10 } });
+	clipper.AddPolygon(layer, { { 0, 20 }, { 30, 20 }, { 30, 30 }, { 0, 30 } });
+	clipper.AddPolygon(layer, { { 0, 0 }, { 10, 0 }, { 10, 30 }, { 0, 30 } });
+	clipper.AddPolygon(layer, { { 20, 0 }, { 30, 0 }, { 30, 30 }, { 20, 30 } });
+	std::vector<IntPolygon> result = clipper.Execute();
+	LONGS_EQUAL(1, result.size());
+	LONGS_EQUAL(1, result[0].holes.size());
+	LONGS_EQUAL(4, result[0].holes[0].size());
+	DOUBLES_EQUAL(800.0, totalArea(result), 1e-9);
+}
+
+TEST(PolygonClipper, OutOfRange) {
+	size_t layer = clipper.AddLayer(Polarity::Dark);
+	int64_t far = PolygonClipper::kMaxCoordinate + 1;
+	CHECK_THROWS(std::invalid_argument,
+			clipper.AddPolygon(layer, { { 0, 0 }, { far, 0 }, { 0, 10 } }));
+}
+
+TEST(PolygonClipper, VertexInsideOtherTriangle) {
+	// 1413,354 lies inside the second triangle, so is not on the outline
+	std::vector<OracleLayer> layers { { Polarity::Dark, { { { 156, 1070 }, {
+			63, 342 }, { 1413, 354 } }, { { 1096, 621 }, { 1469, 249 }, { 1077,
+			1966 } } }, { } } };
+	std::mt19937 random(1);
+	for (const IntPolygon &polygon : checkAgainstOracle(layers, random, 4000,
+			2000)) {
+		for (const IntPoint &point : polygon.outer) {
+			CHECK(point != IntPoint( { 1413, 354 }));
+		}
+	}
+}
+
+TEST(PolygonClipper, SelfIntersectingHexagon) {
+	std::vector<OracleLayer> layers { { Polarity::Dark, { { { 697, 1871 }, {
+			1837, 1910 }, { 117, 858 }, { 242, 1009 }, { 408, 1975 }, { 1968,
+			806 } } }, { } } };
+	std::mt19937 random(2);
+	checkAgainstOracle(layers, random, 4000, 2000);
+}
+
+TEST(PolygonClipper, RandomAgainstWindingOracle) {
+	checkRandomLayers(2000, 60, 33);
+}
+
+TEST(PolygonClipper, CrowdedGridAgainstWindingOracle) {
+	// Vertices and crossings share grid cells, and edges run along each other
+	checkRandomLayers(40, 60, 34);
+}
+
+} /* namespace gerbex */
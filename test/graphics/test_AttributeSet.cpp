@@ -0,0 +1,88 @@
+/*
+ * test_AttributeSet.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AttributeSet.h"
+#include "Circle.h"
+#include "Flash.h"
+#include <memory>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(AttributeSet) {
+	std::shared_ptr<StringTable> strings;
+	std::shared_ptr<const AttributeSet> set;
+
+	void setup() {
+		strings = std::make_shared<StringTable>();
+		set = std::make_shared<AttributeSet>(strings,
+				std::vector<AttributeSet::Attribute> { { strings->Intern(".P"), {
+						strings->Intern("U1"), strings->Intern("3") } }, {
+						strings->Intern(".N"), { strings->Intern("GND") } }, {
+						strings->Intern(".C"), { } } });
+	}
+};
+
+TEST(AttributeSet, SortedByName) {
+	const std::vector<AttributeSet::Attribute> &attributes =
+			set->GetAttributes();
+	LONGS_EQUAL(3, set->GetSize());
+	STRCMP_EQUAL(".C", attributes[0].name->c_str());
+	STRCMP_EQUAL(".N", attributes[1].name->c_str());
+	STRCMP_EQUAL(".P", attributes[2].name->c_str());
+}
+
+TEST(AttributeSet, Find) {
+	const AttributeSet::Attribute *pin = set->Find(".P");
+	CHECK(pin != nullptr);
+	LONGS_EQUAL(2, pin->values.size());
+	STRCMP_EQUAL("3", pin->values[1]->c_str());
+	CHECK(set->Find(".AperFunction") == nullptr);
+}
+
+TEST(AttributeSet, GetValue) {
+	STRCMP_EQUAL("GND", set->GetValue(".N").c_str());
+	STRCMP_EQUAL("", set->GetValue(".C").c_str());
+	STRCMP_EQUAL("", set->GetValue("missing").c_str());
+}
+
+TEST(AttributeSet, KeepsStringsAlive) {
+	strings.reset();
+	STRCMP_EQUAL("U1", set->GetValue(".P").c_str());
+}
+
+TEST(AttributeSet, Empty) {
+	AttributeSet empty(strings, { });
+	CHECK(empty.IsEmpty());
+	CHECK(!set->IsEmpty());
+}
+
+TEST(AttributeSet, SharedByClones) {
+	std::shared_ptr<Circle> circle = std::make_shared<Circle>(0.5);
+	circle->SetAttributes(set);
+	Flash flash(Point(), circle);
+	flash.SetAttributes(set);
+	std::unique_ptr<GraphicalObject> clone = flash.Clone();
+	CHECK(set == clone->GetAttributes());
+	CHECK(set == circle->Clone()->GetAttributes());
+}
+
+} /* namespace gerbex */
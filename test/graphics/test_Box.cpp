@@ -52,6 +52,16 @@ TEST(Box, Extend_Disjoint) {
 	CHECK_EQUAL(expected, other.Extend(box));
 }
 
+TEST(Box, Overlaps) {
+	Box box(2.0, 2.0, -1.0, -1.0);
+
+	CHECK(box.Overlaps(Box(1.0, 1.0, 0.5, 0.5)));
+	CHECK(box.Overlaps(Box(4.0, 4.0, -2.0, -2.0)));
+	CHECK(box.Overlaps(Box(1.0, 1.0, 1.0, -0.5)));
+	CHECK_FALSE(box.Overlaps(Box(1.0, 1.0, 1.5, 0.0)));
+	CHECK_FALSE(box.Overlaps(Box(1.0, 1.0, 0.0, -2.5)));
+}
+
 TEST(Box, Pad) {
 	Box expected(4.0, 6.0, -2.0, -3.0);
 	Box box(2.0, 4.0, -1.0, -2.0);
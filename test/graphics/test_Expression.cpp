@@ -188,4 +188,11 @@ TEST(ExpressionTest, MinusVariable) {
 	DOUBLES_EQUAL(-1.25, result, DBL_TOL);
 }
 
+TEST(ExpressionTest, EvaluateAgain) {
+	Expression expr("($1+2)x$2");
+	DOUBLES_EQUAL(9.0, expr.Evaluate( { { 1, 1.0 }, { 2, 3.0 } }), DBL_TOL);
+	DOUBLES_EQUAL(-2.0, expr.Evaluate( { { 1, -4.0 }, { 2, 1.0 } }),
+			DBL_TOL);
+}
+
 } /* namespace gerbex */
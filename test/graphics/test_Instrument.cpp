@@ -0,0 +1,98 @@
+/*
+ * test_Instrument.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Circle.h"
+#include "Instrument.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(Instrument) {
+	void setup() override {
+		Instrument::Reset();
+	}
+
+	void teardown() override {
+		Instrument::Reset();
+	}
+
+	uint64_t GetCount(const std::string &name) {
+		std::map<std::string, uint64_t> counts = Instrument::GetCounts();
+		auto count = counts.find(name);
+		return count == counts.end() ? 0 : count->second;
+	}
+};
+
+TEST(Instrument, Count) {
+	Instrument::Count("clone", "Test");
+	Instrument::Count("clone", "Test");
+	LONGS_EQUAL(Instrument::kEnabled ? 2 : 0, GetCount("clone Test"));
+}
+
+TEST(Instrument, CountsClones) {
+	Circle circle(1.0, 0.0);
+	circle.Clone();
+	LONGS_EQUAL(Instrument::kEnabled ? 1 : 0, GetCount("clone Circle"));
+}
+
+TEST(Instrument, Reset) {
+	Instrument::Count("regex", "Test");
+	Instrument::AddAllocation(16);
+	Instrument::Reset();
+	CHECK(Instrument::GetCounts().empty());
+}
+
+TEST(Instrument, AddAllocation) {
+	Instrument::Scope scope(Instrument::Subsystem::Save);
+	Instrument::AddAllocation(100);
+	Instrument::AddAllocation(28);
+	std::string subsystem = Instrument::GetSubsystemName(
+			Instrument::GetSubsystem());
+	CHECK(GetCount("allocations " + subsystem) >= 2);
+	CHECK(GetCount("allocated bytes " + subsystem) >= 128);
+}
+
+TEST(Instrument, ScopeRestores) {
+	Instrument::Subsystem before = Instrument::GetSubsystem();
+	{
+		Instrument::Scope scope(Instrument::Subsystem::Lex);
+		if (Instrument::kEnabled) {
+			CHECK(Instrument::Subsystem::Lex == Instrument::GetSubsystem());
+		}
+		scope.Set(Instrument::Subsystem::Commands);
+		if (Instrument::kEnabled) {
+			CHECK(Instrument::Subsystem::Commands
+					== Instrument::GetSubsystem());
+		}
+	}
+	CHECK(before == Instrument::GetSubsystem());
+}
+
+TEST(Instrument, SubsystemNames) {
+	STRCMP_EQUAL("other",
+			Instrument::GetSubsystemName(Instrument::Subsystem::Other));
+	STRCMP_EQUAL("serialize",
+			Instrument::GetSubsystemName(Instrument::Subsystem::Serialize));
+}
+
+} /* namespace gerbex */
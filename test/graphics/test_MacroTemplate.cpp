@@ -68,6 +68,24 @@ TEST(MacroTemplateTest, BadCode) {
 	CHECK_THROWS(std::invalid_argument, make_macro( { "25,1,1.5,-3,+2" }, { }));
 }
 
+TEST(MacroTemplateTest, CallAgain) {
+	MacroTemplate macroTemplate( { "1,1,$1,0,0" });
+	std::shared_ptr<Macro> small = std::dynamic_pointer_cast<Macro>(
+			std::shared_ptr<Aperture>(macroTemplate.Call( { 0.5 })));
+	std::shared_ptr<Macro> large = std::dynamic_pointer_cast<Macro>(
+			std::shared_ptr<Aperture>(macroTemplate.Call( { 2.0 })));
+	DOUBLES_EQUAL(0.5, GetPrimitive<MacroCircle>(small, 0)->GetDiameter(),
+			DBL_TOL);
+	DOUBLES_EQUAL(2.0, GetPrimitive<MacroCircle>(large, 0)->GetDiameter(),
+			DBL_TOL);
+}
+
+TEST(MacroTemplateTest, BadCodeThrowsOnEveryCall) {
+	MacroTemplate macroTemplate( { "25,1,1.5,-3,+2" });
+	CHECK_THROWS(std::invalid_argument, macroTemplate.Call( { }));
+	CHECK_THROWS(std::invalid_argument, macroTemplate.Call( { }));
+}
+
 TEST(MacroTemplateTest, Comment) {
 	std::shared_ptr<Macro> macro = make_macro( {
 			"0 Rectangle with rounded corners, with rotation" }, { });
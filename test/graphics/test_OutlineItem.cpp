@@ -0,0 +1,68 @@
+/*
+ * test_OutlineItem.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Outline.h"
+#include "OutlineItem.h"
+#include "Serializer.h"
+#include <memory>
+#include <stdexcept>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+class ForeignItem: public SerialItem {
+};
+
+TEST_GROUP(OutlineItem) {
+};
+
+TEST(OutlineItem, GetReturnsSameItem) {
+	auto item = std::make_shared<OutlineItem>(Polarity::Dark);
+	pSerialItem base = item;
+	POINTERS_EQUAL(item.get(), OutlineItem::Get(base).get());
+}
+
+TEST(OutlineItem, GetRejectsForeignItem) {
+	pSerialItem foreign = std::make_shared<ForeignItem>();
+	CHECK_THROWS(std::invalid_argument, OutlineItem::Get(foreign));
+	CHECK_THROWS(std::invalid_argument, OutlineItem::Get(nullptr));
+}
+
+TEST(OutlineItem, BuffersOutlines) {
+	OutlineItem item(Polarity::Clear);
+	Outline outline( { Point(0.0, 0.0), Point(1.0, 0.0), Point(0.0, 1.0) });
+	item.Add(outline);
+	item.Add(outline);
+	CHECK(item.GetPolarity() == Polarity::Clear);
+	LONGS_EQUAL(2, item.GetOutlines().size());
+	LONGS_EQUAL(3, item.GetOutlines()[1].boundary.size());
+}
+
+TEST(OutlineItem, MaskIsShared) {
+	OutlineItem item(Polarity::Dark);
+	CHECK(item.GetMask() == nullptr);
+	auto mask = std::make_shared<OutlineItem>(Polarity::Clear);
+	item.SetMask(mask);
+	// Filling the mask later is seen through the item
+	mask->Add(Outline( { Point(0.0, 0.0), Point(1.0, 1.0) }));
+	POINTERS_EQUAL(mask.get(), item.GetMask().get());
+	LONGS_EQUAL(1, item.GetMask()->GetOutlines().size());
+}
+
+} /* namespace gerbex */
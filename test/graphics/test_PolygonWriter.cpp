@@ -0,0 +1,111 @@
+/*
+ * test_PolygonWriter.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "PolygonWriter.h"
+#include <sstream>
+#include <stdexcept>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(PolygonWriter) {
+	std::ostringstream stream;
+	Outline square { { Point(0.0, 0.0), Point(2.0, 0.0), Point(2.0, 2.0),
+			Point(0.0, 2.0) } };
+	Outline triangle { { Point(5.0, 0.0), Point(6.0, 0.0), Point(5.5,
+			1.0) } };
+
+	void setup() {
+		square.holes.push_back( { Point(0.5, 0.5), Point(0.5, 1.5), Point(1.5,
+				1.5) });
+	}
+
+	void write(PolygonFormat format) {
+		PolygonWriter writer(stream, format);
+		writer.Begin(3, 10);
+		writer.Write(square);
+		writer.Write(triangle);
+		writer.End();
+	}
+};
+
+TEST(PolygonWriter, FormatFromPath) {
+	CHECK(PolygonFormat::Vtu == PolygonWriter::FormatFromPath("out.vtu"));
+	CHECK(PolygonFormat::Wkt == PolygonWriter::FormatFromPath("dir/out.WKT"));
+	CHECK(PolygonFormat::GeoJson
+			== PolygonWriter::FormatFromPath("out.geojson"));
+	CHECK(PolygonFormat::GeoJson == PolygonWriter::FormatFromPath("out.json"));
+	CHECK_THROWS(std::invalid_argument,
+			PolygonWriter::FormatFromPath("out.svg"));
+}
+
+TEST(PolygonWriter, FormatFromExtension) {
+	CHECK(PolygonFormat::Wkt == PolygonWriter::FormatFromExtension(".wkt"));
+	CHECK(PolygonFormat::GeoJson
+			== PolygonWriter::FormatFromExtension(".JSON"));
+	CHECK_THROWS(std::invalid_argument,
+			PolygonWriter::FormatFromExtension(""));
+}
+
+TEST(PolygonWriter, Wkt) {
+	write(PolygonFormat::Wkt);
+	STRCMP_EQUAL("MULTIPOLYGON (("
+			"(0.000000 0.000000, 2.000000 0.000000, 2.000000 2.000000, "
+			"0.000000 2.000000, 0.000000 0.000000), "
+			"(0.500000 0.500000, 0.500000 1.500000, 1.500000 1.500000, "
+			"0.500000 0.500000)), "
+			"((5.000000 0.000000, 6.000000 0.000000, 5.500000 1.000000, "
+			"5.000000 0.000000)))\n", stream.str().c_str());
+}
+
+TEST(PolygonWriter, Wkt_Empty) {
+	PolygonWriter writer(stream, PolygonFormat::Wkt);
+	writer.Begin(0, 0);
+	writer.End();
+	STRCMP_EQUAL("MULTIPOLYGON EMPTY\n", stream.str().c_str());
+}
+
+TEST(PolygonWriter, GeoJson) {
+	write(PolygonFormat::GeoJson);
+	STRCMP_EQUAL("{\"type\": \"MultiPolygon\", \"coordinates\": [["
+			"[[0.000000, 0.000000], [2.000000, 0.000000], [2.000000, 2.000000], "
+			"[0.000000, 2.000000], [0.000000, 0.000000]], "
+			"[[0.500000, 0.500000], [0.500000, 1.500000], [1.500000, 1.500000], "
+			"[0.500000, 0.500000]]], "
+			"[[[5.000000, 0.000000], [6.000000, 0.000000], [5.500000, 1.000000], "
+			"[5.000000, 0.000000]]]]}\n", stream.str().c_str());
+}
+
+TEST(PolygonWriter, Vtu) {
+	write(PolygonFormat::Vtu);
+	std::string vtu = stream.str();
+	CHECK(vtu.find("<Piece NumberOfPoints=\"10\" NumberOfCells=\"3\">")
+			!= std::string::npos);
+	CHECK(vtu.find("Name=\"connectivity\" format=\"ascii\">\n"
+			"0 1 2 3\n4 5 6\n7 8 9\n") != std::string::npos);
+	CHECK(vtu.find("Name=\"offsets\" format=\"ascii\">\n4\n7\n10\n")
+			!= std::string::npos);
+	CHECK(vtu.find("Name=\"polygon\" format=\"ascii\">\n0\n0\n1\n")
+			!= std::string::npos);
+	CHECK(vtu.find("Name=\"hole\" format=\"ascii\">\n0\n1\n0\n")
+			!= std::string::npos);
+	CHECK(vtu.find("</VTKFile>") != std::string::npos);
+}
+
+} /* namespace gerbex */
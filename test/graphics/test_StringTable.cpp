@@ -0,0 +1,54 @@
+/*
+ * test_StringTable.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StringTable.h"
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(StringTable) {
+	StringTable table;
+};
+
+TEST(StringTable, SameTextSameAddress) {
+	const std::string *first = table.Intern(".N");
+	const std::string *second = table.Intern(std::string(".") + "N");
+	CHECK(first == second);
+	STRCMP_EQUAL(".N", first->c_str());
+	LONGS_EQUAL(1, table.GetSize());
+}
+
+TEST(StringTable, DifferentText) {
+	CHECK(table.Intern(".N") != table.Intern(".P"));
+	LONGS_EQUAL(2, table.GetSize());
+}
+
+TEST(StringTable, StableAsItGrows) {
+	const std::string *first = table.Intern("Net0");
+	for (int i = 1; i < 1000; i++) {
+		table.Intern("Net" + std::to_string(i));
+	}
+	CHECK(first == table.Intern("Net0"));
+	STRCMP_EQUAL("Net0", first->c_str());
+	LONGS_EQUAL(1000, table.GetSize());
+}
+
+} /* namespace gerbex */
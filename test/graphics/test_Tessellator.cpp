@@ -0,0 +1,226 @@
+/*
+ * test_Tessellator.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "ArcSegment.h"
+#include "Contour.h"
+#include "Segment.h"
+#include "Tessellator.h"
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include "CppUTest/TestHarness.h"
+#include "GraphicsTestHelpers.h"
+
+namespace gerbex {
+
+TEST_GROUP(Tessellator) {
+	Tessellator tessellator { 0.01 };
+};
+
+TEST(Tessellator, InvalidTolerance) {
+	CHECK_THROWS(std::invalid_argument, tessellator.SetTolerance(0.0));
+	CHECK_THROWS(std::invalid_argument, Tessellator(-1.0));
+}
+
+TEST(Tessellator, ScalesWithRadius) {
+	int small = tessellator.GetSegmentCount(1.0, 2.0 * M_PI);
+	int large = tessellator.GetSegmentCount(100.0, 2.0 * M_PI);
+	CHECK(large > small);
+	CHECK(small >= Tessellator::kMinCircleSegments);
+}
+
+TEST(Tessellator, MinimumForTinyRadius) {
+	LONGS_EQUAL(Tessellator::kMinCircleSegments,
+			tessellator.GetSegmentCount(0.001, 2.0 * M_PI));
+	LONGS_EQUAL(1, tessellator.GetSegmentCount(0.001, 0.1));
+}
+
+TEST(Tessellator, ChordErrorWithinTolerance) {
+	double radius = 25.0;
+	int segments = tessellator.GetSegmentCount(radius, 2.0 * M_PI);
+	double error = radius * (1.0 - cos(M_PI / segments));
+	CHECK(error <= tessellator.GetTolerance());
+	// One fewer segment would exceed it
+	error = radius * (1.0 - cos(M_PI / (segments - 1)));
+	CHECK(error > tessellator.GetTolerance());
+}
+
+TEST(Tessellator, MakeArc) {
+	std::vector<Point> points = tessellator.MakeArc(Point(1.0, 1.0), 2.0, 0.0,
+			M_PI_2);
+	CHECK(points.size() >= 3);
+	CHECK_EQUAL(Point(3.0, 1.0), points.front());
+	CHECK_EQUAL(Point(1.0, 3.0), points.back());
+	for (const Point &point : points) {
+		DOUBLES_EQUAL(2.0, point.Distance(Point(1.0, 1.0)), 1e-9);
+	}
+}
+
+TEST(Tessellator, MakeArc_Clockwise) {
+	std::vector<Point> points = tessellator.MakeArc(Point(), 1.0, M_PI_2, 0.0);
+	CHECK_EQUAL(Point(0.0, 1.0), points.front());
+	CHECK_EQUAL(Point(1.0, 0.0), points.back());
+}
+
+TEST(Tessellator, MakeCircle) {
+	std::vector<Point> points = tessellator.MakeCircle(Point(), 5.0);
+	LONGS_EQUAL(tessellator.GetSegmentCount(5.0, 2.0 * M_PI), points.size());
+	CHECK_EQUAL(Point(5.0, 0.0), points.front());
+	CHECK(points.back() != points.front());
+}
+
+TEST(Tessellator, MakeDraw) {
+	Outline outline = tessellator.MakeDraw(
+			Segment(Point(0.0, 0.0), Point(10.0, 0.0)), 2.0);
+	LONGS_EQUAL(0, outline.holes.size());
+	DOUBLES_EQUAL(-1.0, outline.box.GetLeft(), 1e-9);
+	DOUBLES_EQUAL(11.0, outline.box.GetRight(), 1e-9);
+	DOUBLES_EQUAL(-1.0, outline.box.GetBottom(), 1e-9);
+	DOUBLES_EQUAL(1.0, outline.box.GetTop(), 1e-9);
+}
+
+TEST(Tessellator, MakeArcDraw_Circle) {
+	Outline outline = tessellator.MakeArcDraw(
+			ArcSegment(Point(5.0, 0.0), Point(5.0, 0.0), Point(-5.0, 0.0),
+					ArcDirection::CounterClockwise), 1.0);
+	LONGS_EQUAL(1, outline.holes.size());
+	DOUBLES_EQUAL(5.5, outline.boundary.front().Distance(Point()), 1e-9);
+	DOUBLES_EQUAL(4.5, outline.holes.front().front().Distance(Point()), 1e-9);
+}
+
+TEST(Tessellator, MakeArcDraw_Quarter) {
+	Outline outline = tessellator.MakeArcDraw(
+			ArcSegment(Point(5.0, 0.0), Point(0.0, 5.0), Point(-5.0, 0.0),
+					ArcDirection::CounterClockwise), 1.0);
+	LONGS_EQUAL(0, outline.holes.size());
+	for (const Point &point : outline.boundary) {
+		CHECK(point.Distance(Point()) <= 5.5 + 1e-9);
+	}
+	DOUBLES_EQUAL(5.5, outline.box.GetRight(), 1e-9);
+	DOUBLES_EQUAL(5.5, outline.box.GetTop(), 1e-9);
+}
+
+TEST(Tessellator, MakeContour) {
+	Contour contour;
+	contour.AddSegment(
+			std::make_shared<Segment>(Point(0.0, 0.0), Point(4.0, 0.0)));
+	contour.AddSegment(
+			std::make_shared<ArcSegment>(Point(4.0, 0.0), Point(4.0, 4.0),
+					Point(0.0, 2.0), ArcDirection::CounterClockwise));
+	contour.AddSegment(
+			std::make_shared<Segment>(Point(4.0, 4.0), Point(0.0, 0.0)));
+	std::vector<Point> points = tessellator.MakeContour(contour);
+	CHECK(points.size() > 4);
+	CHECK_EQUAL(Point(0.0, 0.0), points.front());
+	CHECK_EQUAL(Point(4.0, 0.0), points[1]);
+	CHECK_EQUAL(Point(4.0, 4.0), points.back());
+	for (size_t i = 1; i + 1 < points.size(); i++) {
+		DOUBLES_EQUAL(2.0, points[i].Distance(Point(4.0, 2.0)), 1e-9);
+	}
+}
+
+TEST(Tessellator, CachedCircleIsTranslated) {
+	std::vector<Point> first = tessellator.MakeCircle(Point(), 2.0);
+	std::vector<Point> second = tessellator.MakeCircle(Point(10.0, -5.0), 2.0);
+	LONGS_EQUAL(1, tessellator.GetCachedShapes());
+	LONGS_EQUAL(first.size(), second.size());
+	for (size_t i = 0; i < first.size(); i++) {
+		CHECK_EQUAL(first[i] + Point(10.0, -5.0), second[i]);
+	}
+}
+
+TEST(Tessellator, CachedDrawIsTranslated) {
+	Segment segment(Point(1.0, 1.0), Point(4.0, 5.0));
+	Outline uncached = Tessellator(0.01).MakeDraw(segment, 0.5);
+	tessellator.MakeDraw(Segment(Point(), Point(3.0, 4.0)), 0.5);
+	Outline cached = tessellator.MakeDraw(segment, 0.5);
+	LONGS_EQUAL(1, tessellator.GetCachedShapes());
+	LONGS_EQUAL(uncached.boundary.size(), cached.boundary.size());
+	for (size_t i = 0; i < cached.boundary.size(); i++) {
+		DOUBLES_EQUAL(uncached.boundary[i].GetX(), cached.boundary[i].GetX(),
+				1e-12);
+		DOUBLES_EQUAL(uncached.boundary[i].GetY(), cached.boundary[i].GetY(),
+				1e-12);
+	}
+}
+
+TEST(Tessellator, CachedArcDrawIsTranslated) {
+	ArcSegment arc(Point(6.0, 1.0), Point(1.0, 6.0), Point(-5.0, 0.0),
+			ArcDirection::CounterClockwise);
+	Outline first = tessellator.MakeArcDraw(arc, 1.0);
+	ArcSegment moved(Point(5.0, -1.0), Point(0.0, 4.0), Point(-5.0, 0.0),
+			ArcDirection::CounterClockwise);
+	Outline second = tessellator.MakeArcDraw(moved, 1.0);
+	LONGS_EQUAL(first.boundary.size(), second.boundary.size());
+	DOUBLES_EQUAL(first.box.GetLeft() - 1.0, second.box.GetLeft(), 1e-12);
+	DOUBLES_EQUAL(first.box.GetBottom() - 2.0, second.box.GetBottom(), 1e-12);
+	// Reversed arcs are a different shape
+	tessellator.MakeArcDraw(
+			ArcSegment(Point(6.0, 1.0), Point(1.0, 6.0), Point(-5.0, 0.0),
+					ArcDirection::Clockwise), 1.0);
+	LONGS_EQUAL(2, tessellator.GetCachedShapes());
+}
+
+TEST(Tessellator, ToleranceClearsCache) {
+	size_t coarse = tessellator.MakeCircle(Point(), 10.0).size();
+	tessellator.SetTolerance(0.0001);
+	LONGS_EQUAL(0, tessellator.GetCachedShapes());
+	CHECK(tessellator.MakeCircle(Point(), 10.0).size() > coarse);
+}
+
+TEST(Tessellator, CacheIsBounded) {
+	for (size_t i = 0; i < Tessellator::kMaxCachedShapes + 10; i++) {
+		tessellator.MakeCircle(Point(), 1.0 + i * 0.001);
+	}
+	LONGS_EQUAL(Tessellator::kMaxCachedShapes, tessellator.GetCachedShapes());
+	std::vector<Point> points = tessellator.MakeCircle(Point(1.0, 0.0), 100.0);
+	DOUBLES_EQUAL(101.0, points.front().GetX(), 1e-9);
+}
+
+TEST(Tessellator, InvalidShapeCacheTolerance) {
+	CHECK_THROWS(std::invalid_argument, ShapeCache(0.0));
+}
+
+TEST(Tessellator, SharedShapeCache) {
+	std::shared_ptr<ShapeCache> shapes = std::make_shared<ShapeCache>(0.01);
+	tessellator.SetShapeCache(shapes);
+	std::vector<Point> first = tessellator.MakeCircle(Point(), 2.0);
+	tessellator.MakeDraw(Segment(Point(), Point(3.0, 4.0)), 0.5);
+	LONGS_EQUAL(2, shapes->GetSize());
+
+	Tessellator other(0.01);
+	other.SetShapeCache(shapes);
+	std::vector<Point> second = other.MakeCircle(Point(1.0, 1.0), 2.0);
+	LONGS_EQUAL(1, other.GetCachedShapes());
+	LONGS_EQUAL(2, shapes->GetSize());
+	LONGS_EQUAL(first.size(), second.size());
+	for (size_t i = 0; i < first.size(); i++) {
+		CHECK_EQUAL(first[i] + Point(1.0, 1.0), second[i]);
+	}
+}
+
+TEST(Tessellator, SharedShapeCacheNeedsSameTolerance) {
+	std::shared_ptr<ShapeCache> shapes = std::make_shared<ShapeCache>(0.001);
+	tessellator.SetShapeCache(shapes);
+	tessellator.MakeCircle(Point(), 2.0);
+	LONGS_EQUAL(0, shapes->GetSize());
+	CHECK_FALSE(shapes->Find( { ShapeCache::Shape::Circle, { 2.0 } }));
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,75 @@
+/*
+ * test_ThreadPool.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(ThreadPool) {
+};
+
+TEST(ThreadPool, DefaultThreadCount) {
+	ThreadPool pool;
+	CHECK(pool.GetThreadCount() >= 1);
+	LONGS_EQUAL(ThreadPool::DefaultThreadCount(), pool.GetThreadCount());
+}
+
+TEST(ThreadPool, ThreadCount) {
+	ThreadPool pool(3);
+	LONGS_EQUAL(3, pool.GetThreadCount());
+}
+
+TEST(ThreadPool, ReturnsResults) {
+	ThreadPool pool(2);
+	std::vector<std::future<int>> results;
+	for (int i = 0; i < 100; i++) {
+		results.push_back(pool.Submit([i]() {
+			return i * i;
+		}));
+	}
+	for (int i = 0; i < 100; i++) {
+		LONGS_EQUAL(i * i, results[i].get());
+	}
+}
+
+TEST(ThreadPool, DrainsOnDestruction) {
+	std::atomic<int> count { 0 };
+	{
+		ThreadPool pool(2);
+		for (int i = 0; i < 50; i++) {
+			pool.Submit([&count]() {
+				count++;
+			});
+		}
+	}
+	LONGS_EQUAL(50, count.load());
+}
+
+TEST(ThreadPool, PropagatesException) {
+	ThreadPool pool(1);
+	std::future<void> result = pool.Submit([]() {
+		throw std::runtime_error("task failed");
+	});
+	CHECK_THROWS(std::runtime_error, result.get());
+}
+
+} /* namespace gerbex */
@@ -112,4 +112,8 @@ GraphicsState& MockCommandsProcessor::GetGraphicsState() {
 	return *(GraphicsState*) mock().actualCall("GetGraphicsState").returnPointerValue();
 }
 
+AttributeDictionary& MockCommandsProcessor::GetAttributeDictionary() {
+	return *(AttributeDictionary*) mock().actualCall("GetAttributeDictionary").returnPointerValue();
+}
+
 } /* namespace gerbex */
@@ -50,6 +50,7 @@ public:
 	void PlotDraw(const Point &coord) override;
 	void ApertureDefine(int ident, std::shared_ptr<Aperture> aperture) override;
 	GraphicsState& GetGraphicsState() override;
+	AttributeDictionary& GetAttributeDictionary() override;
 
 };
 
@@ -0,0 +1,120 @@
+/*
+ * test_AttributeDictionary.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AttributeDictionary.h"
+#include <memory>
+#include <stdexcept>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(AttributeDictionary) {
+	AttributeDictionary dictionary;
+};
+
+TEST(AttributeDictionary, EmptyIsNull) {
+	CHECK(dictionary.GetSet(AttributeTarget::File) == nullptr);
+	CHECK(dictionary.GetSet(AttributeTarget::Aperture) == nullptr);
+	CHECK(dictionary.GetSet(AttributeTarget::Object) == nullptr);
+}
+
+TEST(AttributeDictionary, Set) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	std::shared_ptr<const AttributeSet> set = dictionary.GetSet(
+			AttributeTarget::Object);
+	STRCMP_EQUAL("GND", set->GetValue(".N").c_str());
+	CHECK(dictionary.GetSet(AttributeTarget::Aperture) == nullptr);
+}
+
+TEST(AttributeDictionary, Replaces) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Set(AttributeTarget::Object, ".N", { "VCC" });
+	std::shared_ptr<const AttributeSet> set = dictionary.GetSet(
+			AttributeTarget::Object);
+	LONGS_EQUAL(1, set->GetSize());
+	STRCMP_EQUAL("VCC", set->GetValue(".N").c_str());
+}
+
+TEST(AttributeDictionary, UnchangedSetIsShared) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	std::shared_ptr<const AttributeSet> first = dictionary.GetSet(
+			AttributeTarget::Object);
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	CHECK(first == dictionary.GetSet(AttributeTarget::Object));
+}
+
+TEST(AttributeDictionary, RepeatedSetIsShared) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Set(AttributeTarget::Object, ".C", { "R1" });
+	std::shared_ptr<const AttributeSet> first = dictionary.GetSet(
+			AttributeTarget::Object);
+	dictionary.Set(AttributeTarget::Object, ".N", { "VCC" });
+	dictionary.GetSet(AttributeTarget::Object);
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	CHECK(first == dictionary.GetSet(AttributeTarget::Object));
+	LONGS_EQUAL(2, dictionary.GetSetCount());
+}
+
+TEST(AttributeDictionary, OrderDoesNotMatter) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Set(AttributeTarget::Object, ".C", { "R1" });
+	std::shared_ptr<const AttributeSet> first = dictionary.GetSet(
+			AttributeTarget::Object);
+	dictionary.Delete("");
+	dictionary.Set(AttributeTarget::Object, ".C", { "R1" });
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	CHECK(first == dictionary.GetSet(AttributeTarget::Object));
+}
+
+TEST(AttributeDictionary, ValuesAreInterned) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Set(AttributeTarget::Aperture, ".AperFunction", { "GND" });
+	CHECK(dictionary.GetSet(AttributeTarget::Object)->Find(".N")->values[0]
+			== dictionary.GetSet(AttributeTarget::Aperture)->Find(
+					".AperFunction")->values[0]);
+	LONGS_EQUAL(3, dictionary.GetStrings()->GetSize());
+}
+
+TEST(AttributeDictionary, DeleteNamed) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Set(AttributeTarget::Object, ".C", { "R1" });
+	dictionary.Delete(".N");
+	std::shared_ptr<const AttributeSet> set = dictionary.GetSet(
+			AttributeTarget::Object);
+	LONGS_EQUAL(1, set->GetSize());
+	CHECK(set->Find(".N") == nullptr);
+}
+
+TEST(AttributeDictionary, DeleteAllKeepsFile) {
+	dictionary.Set(AttributeTarget::File, ".Part", { "Single" });
+	dictionary.Set(AttributeTarget::Aperture, ".AperFunction", { "ViaPad" });
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND" });
+	dictionary.Delete("");
+	CHECK(dictionary.GetSet(AttributeTarget::Aperture) == nullptr);
+	CHECK(dictionary.GetSet(AttributeTarget::Object) == nullptr);
+	CHECK(dictionary.GetSet(AttributeTarget::File) != nullptr);
+}
+
+TEST(AttributeDictionary, NeedsName) {
+	CHECK_THROWS(std::invalid_argument,
+			dictionary.Set(AttributeTarget::Object, "", { "GND" }));
+}
+
+} /* namespace gerbex */
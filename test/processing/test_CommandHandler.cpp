@@ -243,3 +243,62 @@ TEST(CommandHandlerTest, StepAndRepeat_close) {
 	CommandHandler::StepAndRepeat(processor, words);
 }
 
+
+TEST(CommandHandlerTest, Attribute_File) {
+	AttributeDictionary dictionary;
+	mock().expectOneCall("GetAttributeDictionary").andReturnValue(&dictionary);
+	Fields words = { "TF.FileFunction,Plated,1,8,PTH" };
+	CommandHandler::Attribute(processor, words);
+	std::shared_ptr<const AttributeSet> set = dictionary.GetSet(
+			AttributeTarget::File);
+	const AttributeSet::Attribute *attribute = set->Find(".FileFunction");
+	CHECK(attribute != nullptr);
+	LONGS_EQUAL(4, attribute->values.size());
+	STRCMP_EQUAL("PTH", attribute->values.back()->c_str());
+}
+
+TEST(CommandHandlerTest, Attribute_ObjectWithoutValue) {
+	AttributeDictionary dictionary;
+	mock().expectOneCall("GetAttributeDictionary").andReturnValue(&dictionary);
+	Fields words = { "TO.N" };
+	CommandHandler::Attribute(processor, words);
+	std::shared_ptr<const AttributeSet> set = dictionary.GetSet(
+			AttributeTarget::Object);
+	CHECK(set->Find(".N") != nullptr);
+	CHECK(set->Find(".N")->values.empty());
+}
+
+TEST(CommandHandlerTest, Attribute_Delete) {
+	AttributeDictionary dictionary;
+	dictionary.Set(AttributeTarget::Aperture, ".AperFunction", { "SMDPad",
+			"CuDef" });
+	mock().expectOneCall("GetAttributeDictionary").andReturnValue(&dictionary);
+	Fields words = { "TD.AperFunction" };
+	CommandHandler::Attribute(processor, words);
+	CHECK(dictionary.GetSet(AttributeTarget::Aperture) == nullptr);
+}
+
+TEST(CommandHandlerTest, Attribute_DeleteTakesNoValues) {
+	AttributeDictionary dictionary;
+	dictionary.Set(AttributeTarget::Object, ".N", { "Net1" });
+	mock().expectOneCall("GetAttributeDictionary").andReturnValue(&dictionary);
+	processor.GetDiagnostics().SetStream(nullptr);
+	Fields words = { "TD.N,Net1" };
+	CommandHandler::Attribute(processor, words);
+	LONGS_EQUAL(1, processor.GetDiagnostics().GetCount(Severity::Warning));
+	CHECK(dictionary.GetSet(AttributeTarget::Object) != nullptr);
+}
+
+TEST(CommandHandlerTest, Attribute_NeedsName) {
+	processor.GetDiagnostics().SetStream(nullptr);
+	Fields words = { "TO,Net1" };
+	CommandHandler::Attribute(processor, words);
+	LONGS_EQUAL(1, processor.GetDiagnostics().GetCount(Severity::Warning));
+}
+
+TEST(CommandHandlerTest, RegionStatement_InvalidIsReported) {
+	processor.GetDiagnostics().SetStream(nullptr);
+	Fields words = { "G38" };
+	CommandHandler::RegionStatement(processor, words);
+	LONGS_EQUAL(1, processor.GetDiagnostics().GetCount(Severity::Warning));
+}
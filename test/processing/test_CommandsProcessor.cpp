@@ -87,6 +87,7 @@ TEST(CommandsProcessor_Init, ApertureDefine) {
 
 	POINTERS_EQUAL(aperture.get(),
 			processor.GetGraphicsState().GetCurrentAperture().get());
+	LONGS_EQUAL(1, processor.GetApertureCount());
 }
 
 TEST(CommandsProcessor_Init, ApertureDefine_BadNumber) {
@@ -775,3 +776,58 @@ TEST(CommandsProcessor_StepAndRepeat, ClearsCurrentPoint) {
 TEST(CommandsProcessor_StepAndRepeat, ExpandsObjects) {
 	LONGS_EQUAL(nx * ny, processor.GetObjects().size());
 }
+
+TEST(CommandsProcessor_StepAndRepeat, CountsClones) {
+	// The flash clones its aperture, then each copy clones the flash
+	LONGS_EQUAL(1 + nx * ny, processor.GetCloneCount());
+}
+
+/***
+ * Tests of attributes given to apertures and objects.
+ */
+
+TEST_GROUP(CommandsProcessor_Attributes) {
+	CommandsProcessor processor;
+
+	void setup() {
+		mock().ignoreOtherCalls();
+		processor.GetAttributeDictionary().Set(AttributeTarget::Aperture,
+				".AperFunction", { "ViaPad" });
+		MakeAndSetAperture<MockAperture>(processor, 10);
+		processor.GetAttributeDictionary().Set(AttributeTarget::Object, ".N",
+				{ "GND" });
+	}
+};
+
+TEST(CommandsProcessor_Attributes, Aperture) {
+	STRCMP_EQUAL("ViaPad",
+			processor.GetAperture(10)->GetAttributes()->GetValue(".AperFunction").c_str());
+}
+
+TEST(CommandsProcessor_Attributes, ObjectsShareSet) {
+	processor.Flash(Point(0.0, 0.0));
+	processor.GetGraphicsState().SetPlotState(PlotState::Linear);
+	processor.PlotDraw(Point(1.0, 0.0));
+	processor.StartRegion();
+	processor.Move(Point(0.0, 0.0));
+	processor.PlotDraw(Point(1.0, 1.0));
+	processor.EndRegion();
+
+	const std::vector<std::shared_ptr<GraphicalObject>> &objects =
+			processor.GetObjects();
+	LONGS_EQUAL(3, objects.size());
+	STRCMP_EQUAL("GND", objects[0]->GetAttributes()->GetValue(".N").c_str());
+	CHECK(objects[0]->GetAttributes() == objects[1]->GetAttributes());
+	CHECK(objects[0]->GetAttributes() == objects[2]->GetAttributes());
+}
+
+TEST(CommandsProcessor_Attributes, DeletedForLaterObjects) {
+	processor.Flash(Point(0.0, 0.0));
+	processor.GetAttributeDictionary().Delete(".N");
+	processor.Flash(Point(1.0, 0.0));
+
+	const std::vector<std::shared_ptr<GraphicalObject>> &objects =
+			processor.GetObjects();
+	CHECK(objects[0]->GetAttributes() != nullptr);
+	CHECK(objects[1]->GetAttributes() == nullptr);
+}
@@ -0,0 +1,99 @@
+/*
+ * test_Diagnostics.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DataTypeParser.h"
+#include "Diagnostics.h"
+#include <sstream>
+#include <string>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(Diagnostics) {
+	std::ostringstream out;
+	Diagnostics diagnostics;
+
+	void setup() {
+		diagnostics.SetStream(&out);
+	}
+};
+
+TEST(Diagnostics, ReportKeepsContext) {
+	diagnostics.SetCommand(12, "AD", "ADD10X");
+	diagnostics.Report(Severity::Warning, "invalid aperture define");
+	LONGS_EQUAL(1, diagnostics.GetCount(Severity::Warning));
+	LONGS_EQUAL(0, diagnostics.GetCount(Severity::Error));
+	const Diagnostic &diagnostic = diagnostics.GetDiagnostics().front();
+	CHECK(Severity::Warning == diagnostic.severity);
+	LONGS_EQUAL(12, diagnostic.line);
+	STRCMP_EQUAL("AD", diagnostic.code.c_str());
+	STRCMP_EQUAL("invalid aperture define", diagnostic.message.c_str());
+}
+
+TEST(Diagnostics, BufferedUntilFlush) {
+	diagnostics.SetCommand(3, "XY", "XY");
+	diagnostics.Report(Severity::Error, "unsupported command XY");
+	STRCMP_EQUAL("", out.str().c_str());
+	diagnostics.Flush();
+	STRCMP_EQUAL("ERROR line 3: unsupported command XY: XY\n",
+			out.str().c_str());
+}
+
+TEST(Diagnostics, CommandWordCopied) {
+	Fields words = { "AMBOX", "1,1,2*" };
+	diagnostics.SetCommand(7, "AM", words.front());
+	words.pop_front();
+	diagnostics.Report(Severity::Warning, "invalid aperture macro");
+	diagnostics.Flush();
+	STRCMP_EQUAL("WARNING line 7: invalid aperture macro: AMBOX\n",
+			out.str().c_str());
+}
+
+TEST(Diagnostics, RateLimited) {
+	diagnostics.SetLimit(2);
+	for (int i = 0; i < 5; i++) {
+		diagnostics.Report(Severity::Warning, "repeated");
+	}
+	diagnostics.Report(Severity::Warning, "other");
+	LONGS_EQUAL(6, diagnostics.GetCount(Severity::Warning));
+	LONGS_EQUAL(3, diagnostics.GetSuppressed());
+	diagnostics.WriteSummary();
+	STRCMP_EQUAL(
+			"WARNING repeated\nWARNING repeated\nWARNING other\n"
+					"WARNING repeated (3 more)\n6 warnings, 0 errors\n",
+			out.str().c_str());
+}
+
+TEST(Diagnostics, NoSummaryWhenClean) {
+	diagnostics.WriteSummary();
+	STRCMP_EQUAL("", out.str().c_str());
+}
+
+TEST(Diagnostics, KeepsBoundedRecord) {
+	diagnostics.SetStream(nullptr);
+	for (size_t i = 0; i < Diagnostics::kMaxKept + 5; i++) {
+		diagnostics.Report(Severity::Warning, "many");
+	}
+	LONGS_EQUAL(Diagnostics::kMaxKept, diagnostics.GetDiagnostics().size());
+	LONGS_EQUAL(Diagnostics::kMaxKept + 5,
+			diagnostics.GetCount(Severity::Warning));
+}
+
+} /* namespace gerbex */
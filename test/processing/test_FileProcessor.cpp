@@ -30,6 +30,7 @@
 #include "MacroTemplate.h"
 #include "MacroThermal.h"
 #include <fstream>
+#include <map>
 #include <sstream>
 #include "CppUTest/TestHarness.h"
 #include "../graphics/GraphicsTestHelpers.h"
@@ -116,6 +117,164 @@ TEST(GerberTwoSquareBoxes, EndOfFile) {
 	CHECK(CommandState::EndOfFile == processor->GetCommandState());
 }
 
+TEST_GROUP(GerberStats) {
+	Stats stats;
+	FileProcessor fileProcessor;
+	CommandsProcessor *processor;
+	GraphicsState *graphicsState;
+
+	void setup() {
+		fileProcessor.SetStats(&stats);
+		loadfile(
+				"../Gerber_File_Format_Examples 20210409/2-13-1_Two_square_boxes.gbr",
+				fileProcessor, &processor, &graphicsState);
+	}
+};
+
+TEST(GerberStats, CommandCounts) {
+	const std::map<std::string, Stats::Command> &commands = stats.GetCommands();
+	LONGS_EQUAL(8, commands.at("D01").count);
+	LONGS_EQUAL(2, commands.at("D02").count);
+	LONGS_EQUAL(1, commands.at("AD").count);
+	LONGS_EQUAL(1, commands.at("TF").count);
+	LONGS_EQUAL(0, stats.GetCount("warnings"));
+}
+
+TEST(GerberStats, Counters) {
+	LONGS_EQUAL(1, stats.GetCount("apertures"));
+	LONGS_EQUAL(8, stats.GetCount("clones"));
+	LONGS_EQUAL(8, stats.GetCount("objects Draw"));
+}
+
+TEST(GerberStats, Phases) {
+	CHECK(stats.GetMilliseconds("lex") > 0.0);
+	CHECK(stats.GetMilliseconds("dispatch") > 0.0);
+}
+
+TEST(GerberBasics, ReportsWithoutStopping) {
+	std::ostringstream out;
+	std::string gerber = "%FSLAX26Y26*%\n%MOMM*%\n%ADD10C,0.1*%\nD10*\n";
+	for (int i = 0; i < 30; i++) {
+		gerber += "%IPPOS*%\nX" + std::to_string(i) + "000000Y0D03*\n";
+	}
+	gerber += "M02*\n";
+	std::istringstream stream(gerber);
+	FileProcessor fileProcessor;
+	Diagnostics &diagnostics = fileProcessor.GetProcessor().GetDiagnostics();
+	diagnostics.SetStream(&out);
+	fileProcessor.Process(stream);
+
+	LONGS_EQUAL(30, fileProcessor.GetProcessor().GetObjects().size());
+	LONGS_EQUAL(30, diagnostics.GetCount(Severity::Warning));
+	LONGS_EQUAL(30 - Diagnostics::kDefaultLimit, diagnostics.GetSuppressed());
+	STRCMP_EQUAL("IP", diagnostics.GetDiagnostics().front().code.c_str());
+	LONGS_EQUAL(5, diagnostics.GetDiagnostics().front().line);
+	CHECK(out.str().find("WARNING unsupported command IP (20 more)")
+			!= std::string::npos);
+	CHECK(out.str().find("30 warnings, 0 errors") != std::string::npos);
+}
+
+/**
+ * Attributes
+ */
+
+TEST_GROUP(GerberDrillAttributes) {
+	FileProcessor fileProcessor;
+	CommandsProcessor *processor;
+	GraphicsState *graphicsState;
+
+	void setup() {
+		loadfile(
+				"../Gerber_File_Format_Examples 20210409/6-1-6-2_A_drill_file.gbr",
+				fileProcessor, &processor, &graphicsState);
+	}
+};
+
+TEST(GerberDrillAttributes, FileAttributes) {
+	std::shared_ptr<const AttributeSet> file =
+			processor->GetAttributeDictionary().GetSet(AttributeTarget::File);
+	LONGS_EQUAL(2, file->GetSize());
+	STRCMP_EQUAL("Plated", file->GetValue(".FileFunction").c_str());
+	STRCMP_EQUAL("Single", file->GetValue(".Part").c_str());
+}
+
+TEST(GerberDrillAttributes, ApertureAttributes) {
+	std::shared_ptr<const AttributeSet> d10 =
+			processor->GetAperture(10)->GetAttributes();
+	std::shared_ptr<const AttributeSet> d11 =
+			processor->GetAperture(11)->GetAttributes();
+	STRCMP_EQUAL("ComponentDrill", d10->GetValue(".AperFunction").c_str());
+	STRCMP_EQUAL("0.002", d10->GetValue(".DrillTolerance").c_str());
+	LONGS_EQUAL(2, d11->Find(".AperFunction")->values.size());
+	STRCMP_EQUAL("0.002", d11->GetValue(".DrillTolerance").c_str());
+}
+
+TEST(GerberDrillAttributes, KeptUntilDeleted) {
+	CHECK(processor->GetAperture(12)->GetAttributes()
+			== processor->GetAperture(13)->GetAttributes());
+	CHECK(processor->GetAttributeDictionary().GetSet(
+			AttributeTarget::Aperture) == nullptr);
+}
+
+TEST(GerberDrillAttributes, FlashesShareApertureSet) {
+	const std::vector<std::shared_ptr<GraphicalObject>> &objects =
+			processor->GetObjects();
+	std::shared_ptr<Flash> first = GetGraphicalObject<Flash>(objects, 0);
+	std::shared_ptr<Flash> second = GetGraphicalObject<Flash>(objects, 1);
+	CHECK(first->GetAperture()->GetAttributes() != nullptr);
+	CHECK(first->GetAperture()->GetAttributes()
+			== second->GetAperture()->GetAttributes());
+	CHECK(first->GetAttributes() == nullptr);
+}
+
+TEST_GROUP(GerberNetIndex) {
+	FileProcessor fileProcessor;
+
+	void setup() {
+		std::istringstream gerber = std::istringstream(
+				"%FSLAX26Y26*%\n%MOMM*%\n%ADD10C,0.1*%\nD10*\n"
+						"%TO.N,GND*%\n%TO.C,R1*%\nX0Y0D03*\nX1000000Y0D03*\n"
+						"%TO.C,R2*%\nX2000000Y0D03*\n"
+						"%TO.N,VCC*%\nX3000000Y0D03*\n"
+						"%TD*%\nX4000000Y0D03*\n"
+						"%TO.N,GND*%\n%SRX2Y1I5.0J0*%\nX5000000Y0D03*\n%SR*%\n"
+						"M02*\n");
+		fileProcessor.Process(gerber);
+	}
+};
+
+TEST(GerberNetIndex, Nets) {
+	std::shared_ptr<const NetIndex> index =
+			fileProcessor.GetProcessor().GetNetIndex();
+	const std::vector<ObjectRange> &gnd = index->GetNet("GND");
+	LONGS_EQUAL(2, gnd.size());
+	LONGS_EQUAL(0, gnd[0].begin);
+	LONGS_EQUAL(3, gnd[0].end);
+	LONGS_EQUAL(5, gnd[1].begin);
+	LONGS_EQUAL(7, gnd[1].end);
+	LONGS_EQUAL(1, index->GetNet("VCC").size());
+}
+
+TEST(GerberNetIndex, Components) {
+	std::shared_ptr<const NetIndex> index =
+			fileProcessor.GetProcessor().GetNetIndex();
+	LONGS_EQUAL(2, index->GetComponent("R1")[0].end);
+	LONGS_EQUAL(2, index->GetComponent("R2")[0].begin);
+	LONGS_EQUAL(4, index->GetComponent("R2")[0].end);
+}
+
+TEST(GerberNetIndex, SelectsNet) {
+	const std::vector<std::shared_ptr<GraphicalObject>> &objects =
+			fileProcessor.GetProcessor().GetObjects();
+	std::vector<std::shared_ptr<GraphicalObject>> gnd = NetIndex::Select(
+			objects,
+			fileProcessor.GetProcessor().GetNetIndex()->GetNet("GND"));
+	LONGS_EQUAL(5, gnd.size());
+	for (std::shared_ptr<GraphicalObject> obj : gnd) {
+		STRCMP_EQUAL("GND", obj->GetAttributes()->GetValue(".N").c_str());
+	}
+}
+
 /**
  * Polarities and Apertures
  */
@@ -0,0 +1,72 @@
+/*
+ * test_MacroCache.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MacroCache.h"
+#include <future>
+#include <memory>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(MacroCache) {
+	MacroCache cache;
+	Fields circle = { "1,1,$1,0,0" };
+};
+
+TEST(MacroCache, SameBodySharesTemplate) {
+	std::shared_ptr<MacroTemplate> first = cache.Get(circle);
+	std::shared_ptr<MacroTemplate> second = cache.Get(Fields(circle));
+	CHECK(first == second);
+	CHECK(circle == first->GetBody());
+	LONGS_EQUAL(1, cache.GetSize());
+}
+
+TEST(MacroCache, DifferentBodies) {
+	std::shared_ptr<MacroTemplate> first = cache.Get(circle);
+	std::shared_ptr<MacroTemplate> second = cache.Get( { "1,1,$1,1,0" });
+	CHECK(first != second);
+	LONGS_EQUAL(2, cache.GetSize());
+}
+
+TEST(MacroCache, IsBounded) {
+	for (size_t i = 0; i < MacroCache::kMaxTemplates + 10; i++) {
+		cache.Get( { "1,1," + std::to_string(i) + ",0,0" });
+	}
+	LONGS_EQUAL(MacroCache::kMaxTemplates, cache.GetSize());
+	std::shared_ptr<MacroTemplate> extra = cache.Get( { "1,1,-1,0,0" });
+	CHECK(extra != nullptr);
+	LONGS_EQUAL(MacroCache::kMaxTemplates, cache.GetSize());
+}
+
+TEST(MacroCache, ConcurrentGet) {
+	std::vector<std::future<std::shared_ptr<MacroTemplate>>> results;
+	for (int i = 0; i < 8; i++) {
+		results.push_back(std::async(std::launch::async, [this]() {
+			return cache.Get(circle);
+		}));
+	}
+	for (std::future<std::shared_ptr<MacroTemplate>> &result : results) {
+		CHECK(result.get() != nullptr);
+	}
+	LONGS_EQUAL(1, cache.GetSize());
+}
+
+} /* namespace gerbex */
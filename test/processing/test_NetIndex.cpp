@@ -0,0 +1,145 @@
+/*
+ * test_NetIndex.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AttributeDictionary.h"
+#include "Circle.h"
+#include "Flash.h"
+#include "NetIndex.h"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(NetIndex) {
+	AttributeDictionary dictionary;
+	NetIndex index;
+
+	std::shared_ptr<const AttributeSet> object(const std::string &net,
+			const std::string &refdes = "") {
+		dictionary.Delete("");
+		dictionary.Set(AttributeTarget::Object, ".N", { net });
+		if (!refdes.empty()) {
+			dictionary.Set(AttributeTarget::Object, ".C", { refdes });
+		}
+		return dictionary.GetSet(AttributeTarget::Object);
+	}
+};
+
+TEST(NetIndex, Empty) {
+	LONGS_EQUAL(0, index.GetNet("GND").size());
+	LONGS_EQUAL(0, index.GetNets().size());
+}
+
+TEST(NetIndex, SharedSetMakesOneRange) {
+	std::shared_ptr<const AttributeSet> gnd = object("GND");
+	for (size_t i = 0; i < 5; i++) {
+		index.Add(i, gnd);
+	}
+	const std::vector<ObjectRange> &ranges = index.GetNet("GND");
+	LONGS_EQUAL(1, ranges.size());
+	LONGS_EQUAL(0, ranges[0].begin);
+	LONGS_EQUAL(5, ranges[0].end);
+}
+
+TEST(NetIndex, RangesInOrder) {
+	std::shared_ptr<const AttributeSet> gnd = object("GND");
+	std::shared_ptr<const AttributeSet> vcc = object("VCC");
+	index.Add(0, gnd);
+	index.Add(1, gnd);
+	index.Add(2, vcc);
+	index.Add(3, nullptr);
+	index.Add(4, gnd);
+	const std::vector<ObjectRange> &ranges = index.GetNet("GND");
+	LONGS_EQUAL(2, ranges.size());
+	LONGS_EQUAL(2, ranges[0].end);
+	LONGS_EQUAL(4, ranges[1].begin);
+	LONGS_EQUAL(5, ranges[1].end);
+	LONGS_EQUAL(1, index.GetNet("VCC").size());
+}
+
+TEST(NetIndex, GapSplitsRange) {
+	std::shared_ptr<const AttributeSet> gnd = object("GND");
+	index.Add(0, gnd);
+	index.Add(2, gnd);
+	LONGS_EQUAL(2, index.GetNet("GND").size());
+}
+
+TEST(NetIndex, SameNetAcrossSets) {
+	index.Add(0, object("GND", "R1"));
+	index.Add(1, object("GND", "R2"));
+	LONGS_EQUAL(1, index.GetNet("GND").size());
+	LONGS_EQUAL(2, index.GetNet("GND")[0].end);
+	LONGS_EQUAL(1, index.GetComponent("R1").size());
+	LONGS_EQUAL(1, index.GetComponent("R2")[0].begin);
+}
+
+TEST(NetIndex, SeveralNets) {
+	dictionary.Set(AttributeTarget::Object, ".N", { "GND", "AGND", "GND" });
+	index.Add(0, dictionary.GetSet(AttributeTarget::Object));
+	LONGS_EQUAL(1, index.GetNet("GND").size());
+	LONGS_EQUAL(1, index.GetNet("AGND").size());
+}
+
+TEST(NetIndex, EmptyNameIsNoNet) {
+	index.Add(0, object(""));
+	LONGS_EQUAL(0, index.GetNets().size());
+}
+
+TEST(NetIndex, Names) {
+	index.Add(0, object("VCC", "U1"));
+	index.Add(1, object("GND", "U1"));
+	std::vector<std::string> nets = index.GetNets();
+	LONGS_EQUAL(2, nets.size());
+	STRCMP_EQUAL("GND", nets[0].c_str());
+	STRCMP_EQUAL("VCC", nets[1].c_str());
+	LONGS_EQUAL(1, index.GetComponents().size());
+}
+
+TEST(NetIndex, Intersect) {
+	std::vector<ObjectRange> result = NetIndex::Intersect( { { 0, 4 }, { 6,
+			10 } }, { { 2, 7 }, { 9, 12 } });
+	LONGS_EQUAL(3, result.size());
+	LONGS_EQUAL(2, result[0].begin);
+	LONGS_EQUAL(4, result[0].end);
+	LONGS_EQUAL(6, result[1].begin);
+	LONGS_EQUAL(7, result[1].end);
+	LONGS_EQUAL(9, result[2].begin);
+	LONGS_EQUAL(10, result[2].end);
+}
+
+TEST(NetIndex, Select) {
+	std::vector<std::shared_ptr<GraphicalObject>> objects;
+	for (int i = 0; i < 6; i++) {
+		objects.push_back(
+				std::make_shared<Flash>(Point(i, 0.0),
+						std::make_shared<Circle>(0.1)));
+	}
+	std::vector<std::shared_ptr<GraphicalObject>> selected = NetIndex::Select(
+			objects, { { 1, 3 }, { 5, 6 } });
+	LONGS_EQUAL(3, selected.size());
+	CHECK(objects[1] == selected[0]);
+	CHECK(objects[2] == selected[1]);
+	CHECK(objects[5] == selected[2]);
+	CHECK_THROWS(std::invalid_argument, NetIndex::Select(objects, { { 5, 7 } }));
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,129 @@
+/*
+ * test_Stats.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Circle.h"
+#include "Draw.h"
+#include "Flash.h"
+#include "Region.h"
+#include "Stats.h"
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(Stats) {
+	Stats stats;
+	// An hour ago, so every phase timed from it is well over zero
+	Stats::Clock::time_point past = Stats::Clock::now()
+			- std::chrono::hours(1);
+};
+
+TEST(Stats, AddTimeAccumulates) {
+	stats.AddTime("lex", past);
+	double first = stats.GetMilliseconds("lex");
+	CHECK(first >= 3600e3);
+	stats.AddTime("lex", past);
+	CHECK(stats.GetMilliseconds("lex") >= 2 * first);
+	DOUBLES_EQUAL(0.0, stats.GetMilliseconds("save"), 0.0);
+}
+
+TEST(Stats, AddTimeReturnsNow) {
+	Stats::Clock::time_point before = Stats::Clock::now();
+	Stats::Clock::time_point mark = stats.AddTime("lex", past);
+	CHECK(mark >= before);
+	CHECK(mark <= Stats::Clock::now());
+}
+
+TEST(Stats, AddCommand) {
+	stats.AddCommand("D01", past);
+	stats.AddCommand("D01", Stats::Clock::now());
+	stats.AddCommand("AD", Stats::Clock::now());
+	LONGS_EQUAL(2, stats.GetCommands().size());
+	LONGS_EQUAL(2, stats.GetCommands().at("D01").count);
+	CHECK(stats.GetCommands().at("D01").milliseconds >= 3600e3);
+	LONGS_EQUAL(1, stats.GetCommands().at("AD").count);
+}
+
+TEST(Stats, Count) {
+	LONGS_EQUAL(0, stats.GetCount("clones"));
+	stats.Count("clones");
+	stats.Count("clones", 5);
+	LONGS_EQUAL(6, stats.GetCount("clones"));
+}
+
+TEST(Stats, CountObjects) {
+	std::shared_ptr<Circle> circle = std::make_shared<Circle>(1.0);
+	std::vector<std::shared_ptr<GraphicalObject>> objects = {
+			std::make_shared<Flash>(Point(), circle),
+			std::make_shared<Flash>(Point(1.0, 0.0), circle),
+			std::make_shared<Draw>(Segment(Point(), Point(1.0, 1.0)),
+					circle),
+			std::make_shared<Region>() };
+	stats.CountObjects(objects);
+	LONGS_EQUAL(2, stats.GetCount("objects Flash"));
+	LONGS_EQUAL(1, stats.GetCount("objects Draw"));
+	LONGS_EQUAL(1, stats.GetCount("objects Region"));
+	LONGS_EQUAL(0, stats.GetCount("objects Arc"));
+}
+
+TEST(Stats, WriteTable) {
+	stats.AddTime("lex", Stats::Clock::now());
+	stats.AddTime("box", Stats::Clock::now());
+	stats.AddCommand("D03", past);
+	stats.Count("apertures", 12);
+	std::ostringstream table;
+	stats.WriteTable(table);
+	std::string text = table.str();
+	CHECK(text.find("lex") < text.find("box"));
+	CHECK(text.find("D03") != std::string::npos);
+	CHECK(text.find("apertures") != std::string::npos);
+	CHECK(text.find("peak RSS bytes") != std::string::npos);
+}
+
+TEST(Stats, WriteJson) {
+	stats.AddTime("save", past);
+	stats.AddCommand("D01", Stats::Clock::now());
+	stats.Count("objects Draw", 3);
+	std::ostringstream json;
+	stats.WriteJson(json);
+	std::string text = json.str();
+	CHECK(text.find("\"phases\": {\n    \"save\": 36") != std::string::npos);
+	CHECK(text.find("\"D01\": { \"count\": 1, \"ms\": ") != std::string::npos);
+	CHECK(text.find("\"objects Draw\": 3\n") != std::string::npos);
+	CHECK(text.find("\"peakResidentBytes\": ") != std::string::npos);
+}
+
+TEST(Stats, WriteJsonEmpty) {
+	std::ostringstream json;
+	stats.WriteJson(json);
+	CHECK(json.str().find("\"phases\": {\n  },") != std::string::npos);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(Stats, PeakResidentBytes) {
+	CHECK(Stats::PeakResidentBytes() > 0);
+}
+#endif
+
+} /* namespace gerbex */
@@ -0,0 +1,234 @@
+/*
+ * test_Bitmap.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Bitmap.h"
+#include "Point.h"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+static int count(const Bitmap &bitmap) {
+	const PixelRect &rect = bitmap.GetRect();
+	int total = 0;
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		for (int x = rect.left; x < rect.left + rect.width; x++) {
+			total += bitmap.Get(x, y);
+		}
+	}
+	return total;
+}
+
+TEST_GROUP(Bitmap) {
+	Bitmap bitmap { { -10, -2, 150, 20 } };
+};
+
+TEST(Bitmap, InvalidSize) {
+	CHECK_THROWS(std::invalid_argument, Bitmap( { 0, 0, 1, -1 }));
+}
+
+TEST(Bitmap, FillSpanAcrossWords) {
+	bitmap.FillSpan(3, -5, 130);
+	LONGS_EQUAL(135, count(bitmap));
+	CHECK_FALSE(bitmap.Get(-6, 3));
+	CHECK(bitmap.Get(-5, 3));
+	CHECK(bitmap.Get(63, 3));
+	CHECK(bitmap.Get(64, 3));
+	CHECK(bitmap.Get(129, 3));
+	CHECK_FALSE(bitmap.Get(130, 3));
+}
+
+TEST(Bitmap, FillSpanWithinWord) {
+	bitmap.FillSpan(0, 3, 7);
+	LONGS_EQUAL(4, count(bitmap));
+	CHECK(bitmap.Get(3, 0));
+	CHECK_FALSE(bitmap.Get(7, 0));
+}
+
+TEST(Bitmap, FillSpanClipped) {
+	bitmap.FillSpan(0, -100, 500);
+	bitmap.FillSpan(50, 0, 10);
+	LONGS_EQUAL(150, count(bitmap));
+}
+
+TEST(Bitmap, Ring) {
+	bitmap.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	LONGS_EQUAL(16, count(bitmap));
+	CHECK(bitmap.Get(1, 1));
+	CHECK(bitmap.Get(4, 4));
+	CHECK_FALSE(bitmap.Get(5, 4));
+}
+
+TEST(Bitmap, RingByPixelCentre) {
+	// Edges at 1.6 and 4.4 take pixels 2 and 3 on each axis
+	bitmap.AddRing( { Point(1.6, 1.6), Point(1.6, 4.4), Point(4.4, 4.4),
+			Point(4.4, 1.6) });
+	LONGS_EQUAL(4, count(bitmap));
+	CHECK(bitmap.Get(2, 2));
+	CHECK(bitmap.Get(3, 3));
+}
+
+TEST(Bitmap, RingsUnite) {
+	bitmap.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	bitmap.AddRing( { Point(3.0, 3.0), Point(3.0, 7.0), Point(7.0, 7.0),
+			Point(7.0, 3.0) });
+	LONGS_EQUAL(28, count(bitmap));
+}
+
+TEST(Bitmap, SelfOverlapNonzero) {
+	// Two laps of one square stay filled, winding two
+	bitmap.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0), Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	LONGS_EQUAL(16, count(bitmap));
+}
+
+TEST(Bitmap, Disc) {
+	bitmap.AddDisc(Point(50.0, 8.0), 6.0);
+	DOUBLES_EQUAL(M_PI * 36.0, count(bitmap), 6.0);
+	CHECK(bitmap.Get(50, 8));
+	CHECK_FALSE(bitmap.Get(57, 8));
+}
+
+TEST(Bitmap, Stroke) {
+	bitmap.AddStroke(Point(2.0, 8.0), Point(12.0, 8.0), 4.0);
+	DOUBLES_EQUAL(40.0 + M_PI * 4.0, count(bitmap), 3.0);
+	CHECK(bitmap.Get(0, 7));
+	CHECK_FALSE(bitmap.Get(0, 5));
+	CHECK_FALSE(bitmap.Get(7, 10));
+}
+
+TEST(Bitmap, DiagonalStroke) {
+	bitmap.AddStroke(Point(2.0, 2.0), Point(14.0, 14.0), 2.0);
+	double length = 12.0 * std::sqrt(2.0);
+	DOUBLES_EQUAL(2.0 * length + M_PI, count(bitmap), 4.0);
+	CHECK(bitmap.Get(8, 8));
+	CHECK_FALSE(bitmap.Get(12, 4));
+}
+
+TEST(Bitmap, ArcStroke) {
+	// Upper half of a ring, y down so the sweep runs through -pi / 2
+	bitmap.AddArcStroke(Point(8.0, 8.0), 6.0, 0.0, -M_PI, 2.0);
+	DOUBLES_EQUAL(M_PI * 6.0 * 2.0 + M_PI, count(bitmap), 4.0);
+	CHECK(bitmap.Get(7, 2));
+	CHECK_FALSE(bitmap.Get(7, 13));
+	CHECK_FALSE(bitmap.Get(8, 8));
+}
+
+TEST(Bitmap, FullArcStroke) {
+	bitmap.AddArcStroke(Point(8.0, 8.0), 6.0, 1.0, 2.0 * M_PI, 2.0);
+	DOUBLES_EQUAL(M_PI * 12.0 * 2.0, count(bitmap), 4.0);
+	CHECK(bitmap.Get(7, 13));
+	CHECK(bitmap.Get(2, 7));
+}
+
+TEST(Bitmap, PaintDarkAndClear) {
+	Bitmap shape( { 0, 0, 100, 4 });
+	shape.FillSpan(1, 10, 90);
+	Bitmap mask( { 0, 0, 100, 4 });
+	mask.FillSpan(1, 40, 50);
+	bitmap.Paint(shape, &mask, true);
+	LONGS_EQUAL(70, count(bitmap));
+	CHECK_FALSE(bitmap.Get(45, 1));
+
+	Bitmap clear( { 0, 0, 100, 4 });
+	clear.FillSpan(1, 0, 20);
+	bitmap.Paint(clear, nullptr, false);
+	LONGS_EQUAL(60, count(bitmap));
+	CHECK_FALSE(bitmap.Get(15, 1));
+	CHECK(bitmap.Get(20, 1));
+}
+
+TEST(Bitmap, PaintMaskMustMatch) {
+	Bitmap shape( { 0, 0, 10, 4 });
+	Bitmap mask( { 0, 0, 10, 3 });
+	CHECK_THROWS(std::invalid_argument, bitmap.Paint(shape, &mask, true));
+}
+
+TEST(Bitmap, PackRow) {
+	Bitmap row( { 0, 0, 12, 1 });
+	row.FillSpan(0, 1, 3);
+	row.FillSpan(0, 8, 12);
+	uint8_t bytes[2];
+	row.PackRow(0, bytes);
+	LONGS_EQUAL(0x60, bytes[0]);
+	LONGS_EQUAL(0xf0, bytes[1]);
+}
+
+TEST(Bitmap, PackRowUnaligned) {
+	Bitmap row( { 3, 0, 12, 1 });
+	row.FillSpan(0, 4, 6);
+	row.FillSpan(0, 11, 15);
+	uint8_t bytes[2];
+	row.PackRow(0, bytes);
+	LONGS_EQUAL(0x60, bytes[0]);
+	LONGS_EQUAL(0xf0, bytes[1]);
+}
+
+TEST(Bitmap, Xor) {
+	Bitmap other( { -10, -2, 150, 20 });
+	bitmap.FillSpan(0, 0, 100);
+	other.FillSpan(0, 50, 120);
+	other.FillSpan(5, -10, 0);
+	bitmap.Xor(other);
+	LONGS_EQUAL(80, bitmap.Count());
+	CHECK(bitmap.Get(49, 0));
+	CHECK_FALSE(bitmap.Get(50, 0));
+	CHECK(bitmap.Get(100, 0));
+	CHECK(bitmap.Get(-10, 5));
+}
+
+TEST(Bitmap, XorDifferentRect) {
+	Bitmap other( { -10, -2, 150, 21 });
+	CHECK_THROWS(std::invalid_argument, bitmap.Xor(other));
+}
+
+TEST(Bitmap, Count) {
+	LONGS_EQUAL(0, bitmap.Count());
+	bitmap.FillSpan(1, -10, 140);
+	bitmap.FillSpan(2, 3, 5);
+	LONGS_EQUAL(152, bitmap.Count());
+}
+
+TEST(Bitmap, FindSpan) {
+	bitmap.FillSpan(0, 5, 8);
+	bitmap.FillSpan(0, 70, 130);
+	int left = 0;
+	int right = 0;
+	CHECK(bitmap.FindSpan(0, -10, 140, left, right));
+	LONGS_EQUAL(5, left);
+	LONGS_EQUAL(130, right);
+	CHECK(bitmap.FindSpan(0, 6, 100, left, right));
+	LONGS_EQUAL(6, left);
+	LONGS_EQUAL(100, right);
+	CHECK(bitmap.FindSpan(0, 64, 128, left, right));
+	LONGS_EQUAL(70, left);
+	LONGS_EQUAL(128, right);
+	CHECK_FALSE(bitmap.FindSpan(0, 8, 70, left, right));
+	CHECK_FALSE(bitmap.FindSpan(1, -10, 140, left, right));
+	CHECK_FALSE(bitmap.FindSpan(30, -10, 140, left, right));
+}
+
+} /* namespace gerbex */
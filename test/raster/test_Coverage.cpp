@@ -0,0 +1,168 @@
+/*
+ * test_Coverage.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Coverage.h"
+#include "Point.h"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+static double sum(const Coverage &coverage) {
+	const PixelRect &rect = coverage.GetRect();
+	double total = 0.0;
+	for (int y = rect.top; y < rect.top + rect.height; y++) {
+		for (int x = rect.left; x < rect.left + rect.width; x++) {
+			total += coverage.Get(x, y);
+		}
+	}
+	return total;
+}
+
+TEST_GROUP(Coverage) {
+	Coverage coverage { { -2, -2, 20, 20 } };
+};
+
+TEST(Coverage, InvalidSize) {
+	CHECK_THROWS(std::invalid_argument, Coverage( { 0, 0, -1, 1 }));
+}
+
+TEST(Coverage, AlignedSquare) {
+	coverage.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(1, 1), 1e-6);
+	DOUBLES_EQUAL(1.0, coverage.Get(4, 4), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(0, 1), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(5, 4), 1e-6);
+	DOUBLES_EQUAL(16.0, sum(coverage), 1e-4);
+}
+
+TEST(Coverage, PartialPixels) {
+	coverage.AddRing( { Point(1.5, 1.25), Point(3.5, 1.25), Point(3.5, 3.0),
+			Point(1.5, 3.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(0.375, coverage.Get(1, 1), 1e-6);
+	DOUBLES_EQUAL(0.75, coverage.Get(2, 1), 1e-6);
+	DOUBLES_EQUAL(0.5, coverage.Get(1, 2), 1e-6);
+	DOUBLES_EQUAL(1.0, coverage.Get(2, 2), 1e-6);
+	DOUBLES_EQUAL(3.5, sum(coverage), 1e-4);
+}
+
+TEST(Coverage, DiagonalEdge) {
+	coverage.AddRing( { Point(0.0, 0.0), Point(4.0, 0.0), Point(0.0, 4.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(0.5, coverage.Get(3, 0), 1e-6);
+	DOUBLES_EQUAL(1.0, coverage.Get(2, 0), 1e-6);
+	DOUBLES_EQUAL(8.0, sum(coverage), 1e-4);
+}
+
+TEST(Coverage, EitherOrientation) {
+	coverage.AddRing( { Point(1.0, 1.0), Point(1.0, 5.0), Point(5.0, 5.0),
+			Point(5.0, 1.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(16.0, sum(coverage), 1e-4);
+}
+
+TEST(Coverage, OverlapUnited) {
+	coverage.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	coverage.AddRing( { Point(3.0, 3.0), Point(7.0, 3.0), Point(7.0, 7.0),
+			Point(3.0, 7.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(3, 3), 1e-6);
+	DOUBLES_EQUAL(28.0, sum(coverage), 1e-4);
+}
+
+TEST(Coverage, ClippedToRect) {
+	// Covers everything, the left and top sides well outside
+	coverage.AddRing( { Point(-50.0, -40.0), Point(30.0, -40.0), Point(40.0,
+			30.0), Point(-50.0, 30.0) });
+	coverage.Resolve();
+	DOUBLES_EQUAL(400.0, sum(coverage), 1e-3);
+	DOUBLES_EQUAL(1.0, coverage.Get(-2, -2), 1e-6);
+	DOUBLES_EQUAL(1.0, coverage.Get(17, 17), 1e-6);
+}
+
+TEST(Coverage, ClippedSlantedSide) {
+	// Slanted side crosses the left of the rect, area right of it is exact
+	Coverage narrow( { 2, 0, 2, 4 });
+	narrow.AddRing( { Point(0.0, 0.0), Point(10.0, 0.0), Point(10.0, 4.0),
+			Point(4.0, 4.0) });
+	narrow.Resolve();
+	// Side runs x = y, so the rect [2, 4) x [0, 4) keeps 8 less 2
+	DOUBLES_EQUAL(6.0, sum(narrow), 1e-4);
+}
+
+TEST(Coverage, Disc) {
+	coverage.AddDisc(Point(8.0, 8.0), 5.0);
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(8, 8), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(14, 8), 1e-6);
+	DOUBLES_EQUAL(M_PI * 25.0, sum(coverage), 0.5);
+}
+
+TEST(Coverage, TinyDisc) {
+	coverage.AddDisc(Point(4.5, 4.5), 0.1);
+	coverage.Resolve();
+	CHECK(coverage.Get(4, 4) < 0.1);
+	CHECK(coverage.Get(4, 4) > 0.0);
+}
+
+TEST(Coverage, Stroke) {
+	coverage.AddStroke(Point(2.0, 8.0), Point(12.0, 8.0), 4.0);
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(7, 7), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(7, 10), 1e-6);
+	// Round caps
+	DOUBLES_EQUAL(1.0, coverage.Get(1, 7), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(0, 5), 1e-6);
+	DOUBLES_EQUAL(40.0 + M_PI * 4.0, sum(coverage), 0.5);
+}
+
+TEST(Coverage, ArcStroke) {
+	// Upper half of a ring, y down so the sweep runs through -pi / 2
+	coverage.AddArcStroke(Point(8.0, 8.0), 6.0, 0.0, -M_PI, 2.0);
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(7, 2), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(7, 13), 1e-6);
+	DOUBLES_EQUAL(0.0, coverage.Get(8, 8), 1e-6);
+	DOUBLES_EQUAL(M_PI * 6.0 * 2.0 + M_PI, sum(coverage), 0.5);
+}
+
+TEST(Coverage, FullArcStroke) {
+	coverage.AddArcStroke(Point(8.0, 8.0), 6.0, 1.0, 2.0 * M_PI, 2.0);
+	coverage.Resolve();
+	DOUBLES_EQUAL(1.0, coverage.Get(7, 13), 1e-6);
+	DOUBLES_EQUAL(1.0, coverage.Get(2, 7), 1e-6);
+	DOUBLES_EQUAL(M_PI * 12.0 * 2.0, sum(coverage), 0.5);
+}
+
+TEST(Coverage, StrokeOverRing) {
+	coverage.AddRing( { Point(1.0, 1.0), Point(5.0, 1.0), Point(5.0, 5.0),
+			Point(1.0, 5.0) });
+	coverage.AddStroke(Point(2.0, 3.0), Point(4.0, 3.0), 2.0);
+	coverage.Resolve();
+	DOUBLES_EQUAL(16.0, sum(coverage), 1e-4);
+}
+
+} /* namespace gerbex */
@@ -0,0 +1,150 @@
+/*
+ * test_ImageWriter.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ImageWriter.h"
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+static std::vector<uint8_t> bytes(const std::string &text) {
+	return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+TEST_GROUP(ImageWriter) {
+	std::ostringstream stream;
+};
+
+TEST(ImageWriter, FormatFromPath) {
+	CHECK(ImageFormat::Png == ImageWriter::FormatFromPath("out/a.PNG"));
+	CHECK(ImageFormat::Pgm == ImageWriter::FormatFromPath("a.pgm"));
+	CHECK(ImageFormat::Pbm == ImageWriter::FormatFromPath("a.pbm"));
+	CHECK_THROWS(std::invalid_argument, ImageWriter::FormatFromPath("a.jpg"));
+}
+
+TEST(ImageWriter, FormatFromExtension) {
+	CHECK(ImageFormat::Png == ImageWriter::FormatFromExtension(".Png"));
+	CHECK(ImageFormat::Pbm == ImageWriter::FormatFromExtension(".pbm"));
+	CHECK_THROWS(std::invalid_argument, ImageWriter::FormatFromExtension("png"));
+}
+
+TEST(ImageWriter, Checksums) {
+	std::vector<uint8_t> iend = bytes("IEND");
+	UNSIGNED_LONGS_EQUAL(0xae426082u,
+			ImageWriter::Crc32(iend.data(), iend.size()));
+	std::vector<uint8_t> wiki = bytes("Wikipedia");
+	UNSIGNED_LONGS_EQUAL(0x11e60398u,
+			ImageWriter::Adler32(wiki.data(), wiki.size()));
+}
+
+TEST(ImageWriter, Pgm) {
+	ImageWriter writer(stream, ImageFormat::Pgm);
+	uint8_t pixels[] = { 0, 1, 2, 3, 4, 5 };
+	writer.Begin(3, 2);
+	writer.WriteRows(pixels, 1);
+	writer.WriteRows(pixels + 3, 1);
+	writer.End();
+	std::string expected("P5\n3 2\n255\n\x00\x01\x02\x03\x04\x05", 17);
+	LONGS_EQUAL(expected.size(), stream.str().size());
+	MEMCMP_EQUAL(expected.data(), stream.str().data(), expected.size());
+}
+
+TEST(ImageWriter, Pbm) {
+	ImageWriter writer(stream, ImageFormat::Pbm);
+	uint8_t bits[] = { 0xa5, 0x80, 0x0f, 0x00 };
+	writer.Begin(9, 2);
+	writer.WritePackedRows(bits, 2);
+	writer.End();
+	std::string expected("P4\n9 2\n\xa5\x80\x0f\x00", 11);
+	LONGS_EQUAL(expected.size(), stream.str().size());
+	MEMCMP_EQUAL(expected.data(), stream.str().data(), expected.size());
+}
+
+TEST(ImageWriter, PbmFromPixels) {
+	ImageWriter writer(stream, ImageFormat::Pbm);
+	uint8_t pixels[] = { 255, 0, 128, 127, 0, 0, 0, 0, 200 };
+	writer.Begin(9, 1);
+	writer.WriteRows(pixels, 1);
+	writer.End();
+	std::string expected("P4\n9 1\n\xa0\x80", 9);
+	LONGS_EQUAL(expected.size(), stream.str().size());
+	MEMCMP_EQUAL(expected.data(), stream.str().data(), expected.size());
+}
+
+TEST(ImageWriter, PackedRowsOnlyForPbm) {
+	ImageWriter writer(stream, ImageFormat::Pgm);
+	uint8_t bits[1] = { };
+	writer.Begin(8, 1);
+	CHECK_THROWS(std::logic_error, writer.WritePackedRows(bits, 1));
+}
+
+TEST(ImageWriter, Png) {
+	ImageWriter writer(stream, ImageFormat::Png);
+	uint8_t pixel = 0xff;
+	writer.Begin(1, 1);
+	writer.WriteRows(&pixel, 1);
+	writer.End();
+	std::string png = stream.str();
+	std::string expected(
+			"\x89PNG\r\n\x1a\n"
+			"\0\0\0\x0dIHDR\0\0\0\x01\0\0\0\x01\x08\0\0\0\0\x3a\x7e\x9b\x55"
+			"\0\0\0\x0dIDAT\x78\x01\x01\x02\0\xfd\xff\0\xff\x01\x01\x01\0"
+			"\x60\x87\x12\xb5"
+			"\0\0\0\0IEND\xae\x42\x60\x82", 8 + 25 + 25 + 12);
+	LONGS_EQUAL(expected.size(), png.size());
+	MEMCMP_EQUAL(expected.data(), png.data(), expected.size());
+}
+
+TEST(ImageWriter, PngSplitsBlocks) {
+	// Rows of 40000 bytes fill more than one stored block
+	ImageWriter writer(stream, ImageFormat::Png);
+	std::vector<uint8_t> pixels(40000 * 3, 7);
+	writer.Begin(40000, 3);
+	writer.WriteRows(pixels.data(), 3);
+	writer.End();
+	// Signature, header, one full block and one partial, trailer
+	size_t raw = 3 * 40001;
+	size_t expected = 8 + 25 + 2 * 12 + 2 + 2 * 5 + raw + 4 + 12;
+	LONGS_EQUAL(expected, stream.str().size());
+}
+
+TEST(ImageWriter, TooManyRows) {
+	ImageWriter writer(stream, ImageFormat::Pgm);
+	uint8_t pixels[4] = { };
+	writer.Begin(2, 1);
+	CHECK_THROWS(std::invalid_argument, writer.WriteRows(pixels, 2));
+}
+
+TEST(ImageWriter, MissingRows) {
+	ImageWriter writer(stream, ImageFormat::Png);
+	writer.Begin(2, 2);
+	CHECK_THROWS(std::logic_error, writer.End());
+}
+
+TEST(ImageWriter, EmptyImage) {
+	ImageWriter writer(stream, ImageFormat::Png);
+	CHECK_THROWS(std::invalid_argument, writer.Begin(0, 2));
+}
+
+} /* namespace gerbex */
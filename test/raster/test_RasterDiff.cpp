@@ -0,0 +1,136 @@
+/*
+ * test_RasterDiff.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Box.h"
+#include "Point.h"
+#include "RasterDiff.h"
+#include "RasterSerializer.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(RasterDiff) {
+	// 400 x 600 pixels in three strips, layer point (0, 300) is the top left
+	RasterSerializer before { Box(200.0, 300.0, 0.0, 0.0), 0.5 };
+	RasterSerializer after { Box(200.0, 300.0, 0.0, 0.0), 0.5 };
+
+	// Square in pixel coordinates, left and top inclusive
+	void square(RasterSerializer &serializer, int left, int top, int size) {
+		double x = left * 0.5;
+		double y = 300.0 - top * 0.5;
+		double side = size * 0.5;
+		serializer.AddPolygon(serializer.GetTarget(Polarity::Dark), { Point(x,
+				y), Point(x, y - side), Point(x + side, y - side), Point(
+				x + side, y) });
+	}
+
+	void checkRect(const PixelRect &expected, const PixelRect &actual) {
+		LONGS_EQUAL(expected.left, actual.left);
+		LONGS_EQUAL(expected.top, actual.top);
+		LONGS_EQUAL(expected.width, actual.width);
+		LONGS_EQUAL(expected.height, actual.height);
+	}
+};
+
+TEST(RasterDiff, DifferentSizes) {
+	RasterSerializer other { Box(200.0, 300.0, 0.0, 0.0), 1.0 };
+	CHECK_THROWS(std::invalid_argument, RasterDiff(before, other));
+}
+
+TEST(RasterDiff, Identical) {
+	square(before, 20, 20, 20);
+	square(after, 20, 20, 20);
+	RasterDiff diff(before, after);
+	diff.Compare();
+	LONGS_EQUAL(0, diff.GetChangedPixels());
+	LONGS_EQUAL(0, diff.GetRegions().size());
+}
+
+TEST(RasterDiff, Added) {
+	square(before, 20, 20, 20);
+	square(after, 20, 20, 20);
+	square(after, 100, 70, 30);
+	RasterDiff diff(before, after);
+	diff.Compare();
+	LONGS_EQUAL(900, diff.GetChangedPixels());
+	LONGS_EQUAL(1, diff.GetRegions().size());
+	checkRect( { 100, 70, 30, 30 }, diff.GetRegions()[0]);
+}
+
+TEST(RasterDiff, Moved) {
+	square(before, 20, 20, 20);
+	square(after, 30, 20, 20);
+	RasterDiff diff(before, after);
+	diff.Compare();
+	LONGS_EQUAL(400, diff.GetChangedPixels());
+	LONGS_EQUAL(1, diff.GetRegions().size());
+	checkRect( { 20, 20, 30, 20 }, diff.GetRegions()[0]);
+}
+
+TEST(RasterDiff, SeparateRegions) {
+	square(after, 10, 10, 5);
+	square(after, 300, 500, 5);
+	RasterDiff diff(before, after);
+	diff.Compare();
+	LONGS_EQUAL(50, diff.GetChangedPixels());
+	LONGS_EQUAL(2, diff.GetRegions().size());
+	checkRect( { 10, 10, 5, 5 }, diff.GetRegions()[0]);
+	checkRect( { 300, 500, 5, 5 }, diff.GetRegions()[1]);
+}
+
+TEST(RasterDiff, NearbyChangesJoin) {
+	// In diagonally touching cells
+	square(after, 60, 60, 2);
+	square(after, 66, 66, 2);
+	RasterDiff diff(before, after);
+	diff.Compare();
+	LONGS_EQUAL(1, diff.GetRegions().size());
+	checkRect( { 60, 60, 8, 8 }, diff.GetRegions()[0]);
+}
+
+TEST(RasterDiff, RegionAcrossStrips) {
+	square(after, 200, 250, 20);
+	RasterDiff diff(before, after, 2);
+	diff.Compare();
+	LONGS_EQUAL(400, diff.GetChangedPixels());
+	LONGS_EQUAL(1, diff.GetRegions().size());
+	checkRect( { 200, 250, 20, 20 }, diff.GetRegions()[0]);
+}
+
+TEST(RasterDiff, Highlight) {
+	square(before, 0, 0, 20);
+	square(after, 10, 0, 20);
+	RasterDiff diff(before, after);
+	std::vector<uint8_t> image;
+	diff.Compare([&image](const uint8_t *pixels, int rows) {
+		image.insert(image.end(), pixels, pixels + 400 * rows);
+	});
+	LONGS_EQUAL(400 * 600, image.size());
+	LONGS_EQUAL(RasterDiff::kRemoved, image[5]);
+	LONGS_EQUAL(RasterDiff::kUnchanged, image[15]);
+	LONGS_EQUAL(RasterDiff::kAdded, image[25]);
+	LONGS_EQUAL(0, image[35]);
+	LONGS_EQUAL(0, image[400 * 25 + 5]);
+}
+
+} /* namespace gerbex */
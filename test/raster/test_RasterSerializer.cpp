@@ -0,0 +1,341 @@
+/*
+ * test_RasterSerializer.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ArcSegment.h"
+#include "Box.h"
+#include "Contour.h"
+#include "Point.h"
+#include "RasterSerializer.h"
+#include "Segment.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(RasterSerializer) {
+	// 40 x 20 pixels, layer point (-10, 5) is the top left corner
+	RasterSerializer serializer { Box(20.0, 10.0, -10.0, -5.0), 0.5 };
+
+	int pixel(const std::vector<uint8_t> &image, int x, int y) {
+		return image[y * serializer.GetWidth() + x];
+	}
+
+	double total(const std::vector<uint8_t> &image) {
+		return std::accumulate(image.begin(), image.end(), 0.0) / 255.0;
+	}
+};
+
+TEST(RasterSerializer, InvalidPixelSize) {
+	CHECK_THROWS(std::invalid_argument,
+			RasterSerializer(Box(1.0, 1.0, 0.0, 0.0), 0.0));
+}
+
+TEST(RasterSerializer, Size) {
+	LONGS_EQUAL(40, serializer.GetWidth());
+	LONGS_EQUAL(20, serializer.GetHeight());
+}
+
+TEST(RasterSerializer, Empty) {
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(800, image.size());
+	DOUBLES_EQUAL(0.0, total(image), 1e-9);
+}
+
+TEST(RasterSerializer, PolygonTopLeft) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(target, { Point(-10.0, 5.0), Point(-10.0, 0.0),
+			Point(-5.0, 0.0), Point(-5.0, 5.0) });
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 0, 0));
+	LONGS_EQUAL(255, pixel(image, 9, 9));
+	LONGS_EQUAL(0, pixel(image, 10, 9));
+	LONGS_EQUAL(0, pixel(image, 9, 10));
+	DOUBLES_EQUAL(100.0, total(image), 1e-9);
+}
+
+TEST(RasterSerializer, InvalidPolygon) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	CHECK_THROWS(std::invalid_argument,
+			serializer.AddPolygon(target, { Point(), Point(1.0, 1.0) }));
+}
+
+TEST(RasterSerializer, PolygonsOfOneTargetUnite) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(target, { Point(-5.0, -2.0), Point(0.0, -2.0),
+			Point(0.0, 2.0), Point(-5.0, 2.0) });
+	serializer.AddPolygon(target, { Point(-2.0, -2.0), Point(-2.0, 2.0),
+			Point(3.0, 2.0), Point(3.0, -2.0) });
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 16, 10));
+	DOUBLES_EQUAL(128.0, total(image), 1e-6);
+}
+
+TEST(RasterSerializer, Circle) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(target, 3.0, Point(0.0, 0.0));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 20, 10));
+	LONGS_EQUAL(0, pixel(image, 20, 17));
+	DOUBLES_EQUAL(M_PI * 36.0, total(image), 1.0);
+}
+
+TEST(RasterSerializer, AntiAliasedEdge) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(target, { Point(-10.0, 5.0), Point(-10.0, 0.0),
+			Point(-7.25, 0.0), Point(-7.25, 5.0) });
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 4, 0));
+	LONGS_EQUAL(128, pixel(image, 5, 0));
+	LONGS_EQUAL(0, pixel(image, 6, 0));
+}
+
+TEST(RasterSerializer, ClearOverDark) {
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(dark, 4.0, Point(0.0, 0.0));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 2.0, Point(0.0, 0.0));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(0, pixel(image, 20, 10));
+	LONGS_EQUAL(255, pixel(image, 20, 4));
+	DOUBLES_EQUAL(M_PI * (64.0 - 16.0), total(image), 1.0);
+}
+
+TEST(RasterSerializer, DarkOverClear) {
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 2.0, Point(0.0, 0.0));
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(dark, 1.0, Point(0.0, 0.0));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 20, 10));
+	DOUBLES_EQUAL(M_PI * 4.0, total(image), 0.5);
+}
+
+TEST(RasterSerializer, MaskFilledAfterSet) {
+	pSerialItem root = serializer.GetTarget(Polarity::Dark);
+	pSerialItem group = serializer.NewGroup(root);
+	pSerialItem mask = serializer.NewMask(Box(4.0, 4.0, -2.0, -2.0));
+	serializer.SetMask(group, mask);
+	serializer.AddCircle(group, 2.0, Point(0.0, 0.0));
+	serializer.AddCircle(mask, 1.0, Point(0.0, 0.0));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(0, pixel(image, 20, 10));
+	LONGS_EQUAL(255, pixel(image, 20, 7));
+	DOUBLES_EQUAL(M_PI * (16.0 - 4.0), total(image), 0.5);
+}
+
+TEST(RasterSerializer, Draw) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddDraw(target, 2.0, Segment(Point(-5.0, 0.0), Point(5.0, 0.0)));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 20, 10));
+	LONGS_EQUAL(255, pixel(image, 9, 10));
+	LONGS_EQUAL(0, pixel(image, 20, 13));
+	DOUBLES_EQUAL(80.0 + M_PI * 4.0, total(image), 0.5);
+}
+
+TEST(RasterSerializer, ArcKeepsDirection) {
+	// Counter-clockwise quarter through the upper right
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddArc(target, 2.0,
+			ArcSegment(Point(4.0, 0.0), Point(0.0, 4.0), Point(-4.0, 0.0),
+					ArcDirection::CounterClockwise));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(255, pixel(image, 25, 4));
+	LONGS_EQUAL(0, pixel(image, 25, 15));
+	LONGS_EQUAL(0, pixel(image, 14, 4));
+	DOUBLES_EQUAL(2.0 * M_PI * 2.0 * 4.0 + M_PI * 4.0, total(image), 1.0);
+}
+
+TEST(RasterSerializer, ClockwiseArc) {
+	// Clockwise from the same start sweeps the other three quarters
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddArc(target, 2.0,
+			ArcSegment(Point(4.0, 0.0), Point(0.0, 4.0), Point(-4.0, 0.0),
+					ArcDirection::Clockwise));
+	std::vector<uint8_t> image = serializer.Render();
+	LONGS_EQUAL(0, pixel(image, 25, 4));
+	LONGS_EQUAL(255, pixel(image, 25, 15));
+	LONGS_EQUAL(255, pixel(image, 14, 4));
+}
+
+TEST(RasterSerializer, Contour) {
+	Contour contour;
+	contour.AddSegment(
+			std::make_shared<Segment>(Point(0.0, 0.0), Point(4.0, 0.0)));
+	contour.AddSegment(
+			std::make_shared<ArcSegment>(Point(4.0, 0.0), Point(4.0, 4.0),
+					Point(0.0, 2.0), ArcDirection::CounterClockwise));
+	contour.AddSegment(
+			std::make_shared<Segment>(Point(4.0, 4.0), Point(0.0, 0.0)));
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddContour(target, contour);
+	std::vector<uint8_t> image = serializer.Render();
+	// Triangle plus a half disc, less what the chords cut off
+	DOUBLES_EQUAL((8.0 + M_PI * 2.0) * 4.0, total(image), 1.0);
+}
+
+TEST(RasterSerializer, RenderRegion) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(target, 3.0, Point(1.0, -1.0));
+	serializer.AddDraw(target, 0.7, Segment(Point(-8.0, 4.0), Point(6.0, -3.0)));
+	std::vector<uint8_t> image = serializer.Render();
+	const int stride = 9;
+	std::vector<uint8_t> region(stride * 7);
+	serializer.Render( { 17, 8, 9, 7 }, region.data(), stride);
+	for (int y = 0; y < 7; y++) {
+		for (int x = 0; x < 9; x++) {
+			LONGS_EQUAL(pixel(image, 17 + x, 8 + y), region[y * stride + x]);
+		}
+	}
+}
+
+TEST(RasterSerializer, TallTargetSpansBands) {
+	RasterSerializer tall(Box(1.0, 10.0, 0.0, 0.0), 0.01);
+	pSerialItem target = tall.GetTarget(Polarity::Dark);
+	tall.AddPolygon(target, { Point(0.0, 0.0), Point(1.0, 0.0), Point(1.0,
+			10.0), Point(0.0, 10.0) });
+	std::vector<uint8_t> image = tall.Render();
+	CHECK(tall.GetHeight() > 2 * RasterSerializer::kBandRows);
+	for (uint8_t value : image) {
+		LONGS_EQUAL(255, value);
+	}
+}
+
+TEST(RasterSerializer, InvalidTiling) {
+	CHECK_THROWS(std::invalid_argument, serializer.SetTiling(0, 1));
+}
+
+TEST(RasterSerializer, StripsOfOneTileRow) {
+	pSerialItem target = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(target, 3.0, Point(0.0, 0.0));
+	serializer.SetTiling(8, 2);
+	std::vector<int> strips;
+	serializer.RenderStrips([&strips](const uint8_t*, int rows) {
+		strips.push_back(rows);
+	});
+	CHECK(std::vector<int>( { 8, 8, 4 }) == strips);
+}
+
+TEST(RasterSerializer, TiledMatchesWhole) {
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddPolygon(dark, { Point(-9.3, -4.1), Point(8.7, -3.3), Point(
+			-1.1, 4.6) });
+	serializer.AddDraw(dark, 0.7, Segment(Point(-8.0, 4.0), Point(6.0, -3.0)));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddCircle(clear, 2.3, Point(1.2, -0.4));
+	pSerialItem group = serializer.NewGroup(serializer.GetTarget(
+			Polarity::Dark));
+	pSerialItem mask = serializer.NewMask(Box(4.0, 4.0, 3.0, -2.0));
+	serializer.SetMask(group, mask);
+	serializer.AddArc(group, 0.9,
+			ArcSegment(Point(7.0, 0.0), Point(3.0, 0.0), Point(-2.0, 0.0),
+					ArcDirection::CounterClockwise));
+	serializer.AddCircle(mask, 0.8, Point(5.0, 2.0));
+
+	std::vector<uint8_t> whole(serializer.GetWidth() * serializer.GetHeight());
+	serializer.Render( { 0, 0, serializer.GetWidth(), serializer.GetHeight() },
+			whole.data(), serializer.GetWidth());
+	serializer.SetTiling(7, 3);
+	std::vector<uint8_t> tiled = serializer.Render();
+	LONGS_EQUAL(whole.size(), tiled.size());
+	for (size_t i = 0; i < whole.size(); i++) {
+		CHECK(std::abs(whole[i] - tiled[i]) <= 1);
+	}
+	CHECK(total(tiled) > 50.0);
+}
+
+TEST(RasterSerializer, InvalidStripHeight) {
+	CHECK_THROWS(std::invalid_argument, serializer.SetStripHeight(0));
+}
+
+TEST(RasterSerializer, BitStripsMatchCoverage) {
+	pSerialItem dark = serializer.GetTarget(Polarity::Dark);
+	serializer.AddCircle(dark, 4.0, Point(0.0, 0.0));
+	serializer.AddDraw(dark, 1.0, Segment(Point(-9.0, 4.0), Point(9.0, 4.0)));
+	pSerialItem clear = serializer.GetTarget(Polarity::Clear);
+	serializer.AddPolygon(clear, { Point(-1.0, -1.0), Point(1.0, -1.0), Point(
+			1.0, 1.0), Point(-1.0, 1.0) });
+	serializer.SetStripHeight(6);
+	serializer.SetTiling(16, 2);
+
+	std::vector<uint8_t> image = serializer.Render();
+	std::vector<uint8_t> bits;
+	std::vector<int> strips;
+	serializer.RenderBitStrips(
+			[&bits, &strips](const uint8_t *packed, int rows) {
+				bits.insert(bits.end(), packed, packed + 5 * rows);
+				strips.push_back(rows);
+			});
+	CHECK(std::vector<int>( { 6, 6, 6, 2 }) == strips);
+	int differ = 0;
+	for (int y = 0; y < serializer.GetHeight(); y++) {
+		for (int x = 0; x < serializer.GetWidth(); x++) {
+			bool set = bits[y * 5 + x / 8] & (0x80 >> (x % 8));
+			int value = pixel(image, x, y);
+			if (value != 0 && value != 255) {
+				continue;	// Edge pixels may round either way
+			}
+			differ += set != (value == 255);
+		}
+	}
+	LONGS_EQUAL(0, differ);
+	// The cleared centre, within the circle
+	CHECK((bits[10 * 5 + 2] & 0x08) == 0);
+	CHECK((bits[10 * 5 + 2] & 0x80) != 0);
+}
+
+TEST(RasterSerializer, BinStripsKeepTouchingTargets) {
+	// Rows 1 to 3, and 17 to 19
+	serializer.AddPolygon(serializer.GetTarget(Polarity::Dark), { Point(-1.0,
+			3.5), Point(1.0, 3.5), Point(1.0, 4.5), Point(-1.0, 4.5) });
+	serializer.AddPolygon(serializer.GetTarget(Polarity::Clear), {
+			Point(-1.0, -4.5), Point(1.0, -4.5), Point(1.0, -3.5), Point(-1.0,
+					-3.5) });
+	std::vector<RasterSerializer::Bin> bins = serializer.BinStrips(6);
+	LONGS_EQUAL(4, bins.size());
+	LONGS_EQUAL(1, bins[0].size());
+	LONGS_EQUAL(0, bins[1].size());
+	LONGS_EQUAL(1, bins[3].size());
+	CHECK(bins[0].front() != bins[3].front());
+	CHECK_THROWS(std::invalid_argument, serializer.BinStrips(0));
+}
+
+TEST(RasterSerializer, SaveToStream) {
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 3.0,
+			Point(0.0, 0.0));
+	std::ostringstream stream;
+	serializer.Save(stream, ".pgm");
+	std::string header = "P5\n40 20\n255\n";
+	std::string pgm = stream.str();
+	LONGS_EQUAL(header.size() + 40 * 20, pgm.size());
+	STRCMP_EQUAL(header.c_str(), pgm.substr(0, header.size()).c_str());
+	std::vector<uint8_t> image = serializer.Render();
+	MEMCMP_EQUAL(image.data(), pgm.data() + header.size(), image.size());
+	CHECK_THROWS(std::invalid_argument, serializer.Save(stream, ".svg"));
+}
+
+} /* namespace gerbex */
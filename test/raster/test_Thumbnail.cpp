@@ -0,0 +1,117 @@
+/*
+ * test_Thumbnail.cpp
+ *
+ *  Created on: Oct. 18, 2026
+ *	Copyright (C) 2026 BetaPollux
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BlockAperture.h"
+#include "Box.h"
+#include "Circle.h"
+#include "Flash.h"
+#include "Point.h"
+#include "Rectangle.h"
+#include "Thumbnail.h"
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "CppUTest/TestHarness.h"
+
+namespace gerbex {
+
+TEST_GROUP(Thumbnail) {
+	// One unit per pixel, layer point (0, 128) is the top left corner
+	Thumbnail thumbnail { Box(256.0, 128.0, 0.0, 0.0) };
+
+	std::shared_ptr<Flash> flash(double x, double y,
+			std::shared_ptr<Aperture> aperture, Polarity polarity =
+					Polarity::Dark) {
+		std::shared_ptr<Flash> object = std::make_shared<Flash>(Point(x, y),
+				aperture);
+		object->SetPolarity(polarity);
+		return object;
+	}
+
+	int pixel(const std::vector<uint8_t> &image, int x, int y) {
+		return image[y * thumbnail.GetWidth() + x];
+	}
+
+	double total(const std::vector<uint8_t> &image) {
+		return std::accumulate(image.begin(), image.end(), 0.0) / 255.0;
+	}
+};
+
+TEST(Thumbnail, InvalidSize) {
+	CHECK_THROWS(std::invalid_argument, Thumbnail(Box(1.0, 1.0, 0.0, 0.0), 0));
+}
+
+TEST(Thumbnail, Size) {
+	LONGS_EQUAL(256, thumbnail.GetWidth());
+	LONGS_EQUAL(128, thumbnail.GetHeight());
+	Thumbnail tall(Box(10.0, 40.0, 0.0, 0.0), 100);
+	LONGS_EQUAL(25, tall.GetWidth());
+	LONGS_EQUAL(100, tall.GetHeight());
+}
+
+TEST(Thumbnail, TinyFlashFillsOnePixel) {
+	thumbnail.Add( { flash(10.5, 100.5, std::make_shared<Circle>(0.1)) });
+	std::vector<uint8_t> image = thumbnail.Render();
+	LONGS_EQUAL(255, pixel(image, 10, 27));
+	DOUBLES_EQUAL(1.0, total(image), 1e-9);
+}
+
+TEST(Thumbnail, SmallFlashFillsBox) {
+	thumbnail.Add( { flash(20.0, 100.0, std::make_shared<Circle>(2.0)) });
+	std::vector<uint8_t> image = thumbnail.Render();
+	DOUBLES_EQUAL(4.0, total(image), 1e-9);
+}
+
+TEST(Thumbnail, LargeFlashKeepsShape) {
+	thumbnail.Add( { flash(50.0, 50.0, std::make_shared<Circle>(20.0)) });
+	std::vector<uint8_t> image = thumbnail.Render();
+	DOUBLES_EQUAL(M_PI * 100.0, total(image), 0.5);
+}
+
+TEST(Thumbnail, OutsideViewSkipped) {
+	thumbnail.Add( { flash(-100.0, -100.0, std::make_shared<Circle>(20.0)) });
+	DOUBLES_EQUAL(0.0, total(thumbnail.Render()), 1e-9);
+}
+
+TEST(Thumbnail, BlockWalked) {
+	std::shared_ptr<BlockAperture> block = std::make_shared<BlockAperture>();
+	block->AddObject(flash(-10.0, 0.0, std::make_shared<Circle>(20.0)));
+	block->AddObject(flash(10.5, 0.5, std::make_shared<Circle>(0.1)));
+	thumbnail.Add( { flash(100.0, 60.0, block) });
+	std::vector<uint8_t> image = thumbnail.Render();
+	LONGS_EQUAL(255, pixel(image, 90, 68));
+	LONGS_EQUAL(255, pixel(image, 110, 67));
+	DOUBLES_EQUAL(M_PI * 100.0 + 1.0, total(image), 0.5);
+}
+
+TEST(Thumbnail, FillsKeepPaintOrder) {
+	thumbnail.Add( { flash(10.5, 100.5, std::make_shared<Circle>(0.1)), flash(
+			20.0, 100.0, std::make_shared<Rectangle>(30.0, 10.0),
+			Polarity::Clear), flash(20.5, 100.5,
+			std::make_shared<Circle>(0.1)) });
+	std::vector<uint8_t> image = thumbnail.Render();
+	LONGS_EQUAL(0, pixel(image, 10, 27));
+	LONGS_EQUAL(255, pixel(image, 20, 27));
+	DOUBLES_EQUAL(1.0, total(image), 1e-9);
+}
+
+} /* namespace gerbex */
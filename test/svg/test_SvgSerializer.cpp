@@ -18,11 +18,78 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "ArcSegment.h"
+#include "Circle.h"
+#include "Contour.h"
+#include "Draw.h"
+#include "Flash.h"
 #include "SvgSerializer.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include "CppUTest/TestHarness.h"
 
 namespace gerbex {
 
+static std::vector<std::shared_ptr<GraphicalObject>> makeObjects(
+		Polarity first) {
+	std::vector<std::shared_ptr<GraphicalObject>> objects;
+	for (int i = 0; i < 50; i++) {
+		std::shared_ptr<GraphicalObject> obj;
+		if (i % 3 == 0) {
+			obj = std::make_shared<Draw>(
+					Segment(Point(i, 0.0), Point(i, 10.0)),
+					std::make_shared<Circle>(0.2));
+		} else {
+			obj = std::make_shared<Flash>(Point(i, 5.0),
+					std::make_shared<Circle>(0.5 + 0.1 * (i % 4)));
+		}
+		obj->SetPolarity(first);
+		if ((i / 7) % 2 == 1) {
+			obj->TogglePolarity();
+		}
+		objects.push_back(obj);
+	}
+	return objects;
+}
+
+static std::string readFile(const std::string &path) {
+	std::ifstream file(path);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return contents.str();
+}
+
+static void checkParallelMatchesSerial(Polarity first) {
+	std::vector<std::shared_ptr<GraphicalObject>> objects = makeObjects(first);
+	Box box(60.0, 20.0, -5.0, -5.0);
+
+	SvgSerializer serial(box);
+	serial.SetForeground("red");
+	for (std::shared_ptr<GraphicalObject> obj : objects) {
+		obj->Serialize(serial, Point());
+	}
+	serial.SaveFile("serial.svg");
+
+	SvgSerializer parallel(box);
+	parallel.SetForeground("red");
+	parallel.SerializeParallel(objects, 3);
+	parallel.SaveFile("parallel.svg");
+
+	STRCMP_EQUAL(readFile("serial.svg").c_str(),
+			readFile("parallel.svg").c_str());
+}
+
+static size_t countTags(const std::string &markup, const std::string &tag) {
+	size_t count = 0;
+	for (size_t pos = markup.find("<" + tag); pos != std::string::npos;
+			pos = markup.find("<" + tag, pos + 1)) {
+		count++;
+	}
+	return count;
+}
+
 TEST_GROUP(SvgSerializerTest) {
 };
 
@@ -46,6 +113,23 @@ TEST(SvgSerializerTest, MakeFile) {
 	serializer.SaveFile("output.svg");
 }
 
+TEST(SvgSerializerTest, SaveMatchesSaveFile) {
+	SvgSerializer serializer(Box(20.0, 20.0, -10.0, -10.0));
+	serializer.AddCircle(serializer.GetTarget(Polarity::Dark), 5.0,
+			Point(0.0, 0.0));
+	serializer.SaveFile("saved.svg");
+	std::ostringstream stream;
+	serializer.Save(stream, ".svg");
+	STRCMP_EQUAL(readFile("saved.svg").c_str(), stream.str().c_str());
+
+	SvgSerializer parallel(Box(60.0, 20.0, -5.0, -5.0));
+	parallel.SerializeParallel(makeObjects(Polarity::Dark), 2);
+	parallel.SaveFile("saved.svg");
+	std::ostringstream fragments;
+	parallel.Save(fragments, ".svg");
+	STRCMP_EQUAL(readFile("saved.svg").c_str(), fragments.str().c_str());
+}
+
 TEST(SvgSerializerTest, Donut) {
 	Box area(1000.0, 1000.0, 0.0, 0.0);
 	Point center(500, 500);
@@ -60,4 +144,143 @@ TEST(SvgSerializerTest, Donut) {
 	serializer.SaveFile("donut.svg");
 }
 
+TEST(SvgSerializerTest, ParallelMatchesSerial) {
+	checkParallelMatchesSerial(Polarity::Dark);
+}
+
+TEST(SvgSerializerTest, ParallelMatchesSerial_ClearFirst) {
+	checkParallelMatchesSerial(Polarity::Clear);
+}
+
+TEST(SvgSerializerTest, ParallelFragmentRuns) {
+	std::vector<std::shared_ptr<GraphicalObject>> objects = makeObjects(
+			Polarity::Dark);
+	SvgSerializer serializer(Box(60.0, 20.0, -5.0, -5.0));
+	for (std::shared_ptr<GraphicalObject> obj : objects) {
+		obj->Serialize(serializer, Point());
+	}
+	SvgFragment fragment = serializer.GetFragment();
+	LONGS_EQUAL(8, fragment.runs.size());
+	CHECK(Polarity::Dark == fragment.runs.front().polarity);
+	CHECK(Polarity::Clear == fragment.runs.back().polarity);
+	CHECK(fragment.masks.empty());
+}
+
+TEST(SvgSerializerTest, Layers) {
+	Box box(60.0, 20.0, -5.0, -5.0);
+	SvgSerializer serializer(box);
+	serializer.AddLayer("top", makeObjects(Polarity::Dark), "red", 1.0, 2);
+	serializer.AddLayer("mask & paste", makeObjects(Polarity::Clear),
+			"green", 0.5, 3);
+	serializer.SaveFile("layers.svg");
+	std::string svg = readFile("layers.svg");
+	CHECK(svg.find("<g id=\"l0\" data-name=\"top\" opacity=\"1\">")
+			!= std::string::npos);
+	CHECK(svg.find("<g id=\"l1\" data-name=\"mask &amp; paste\" "
+			"opacity=\"0.5\">") != std::string::npos);
+	CHECK(svg.find("id=\"l0-mask0\"") != std::string::npos);
+	CHECK(svg.find("id=\"l1-mask0\"") != std::string::npos);
+	CHECK(svg.find("id=\"mask0\"") == std::string::npos);
+	CHECK(svg.find("fill=\"green\"") > svg.find("fill=\"red\""));
+	LONGS_EQUAL(countTags(svg, "mask "), 8);
+}
+
+TEST(SvgSerializerTest, LayerMatchesParallel) {
+	// A single opaque layer holds the same runs as the plain document
+	Box box(60.0, 20.0, -5.0, -5.0);
+	SvgSerializer layered(box);
+	layered.AddLayer("only", makeObjects(Polarity::Dark), "red", 1.0, 3);
+	layered.SaveFile("layer.svg");
+	SvgSerializer parallel(box);
+	parallel.SetForeground("red");
+	parallel.SerializeParallel(makeObjects(Polarity::Dark), 3);
+	parallel.SaveFile("parallel.svg");
+	std::string layer = readFile("layer.svg");
+	std::string plain = readFile("parallel.svg");
+	LONGS_EQUAL(countTags(plain, "circle"), countTags(layer, "circle"));
+	LONGS_EQUAL(countTags(plain, "line"), countTags(layer, "line"));
+	LONGS_EQUAL(countTags(plain, "mask "), countTags(layer, "mask "));
+}
+
+TEST_GROUP(SvgSerializerLodTest) {
+	SvgSerializer *serializer;
+	pSerialItem target;
+
+	void setup() {
+		serializer = new SvgSerializer(Box(100.0, 100.0, 0.0, 0.0));
+		serializer->SetPixelSize(1.0);
+		target = serializer->GetTarget(Polarity::Dark);
+	}
+
+	void teardown() {
+		delete serializer;
+	}
+
+	std::string markup() {
+		return serializer->GetFragment().runs.front().markup;
+	}
+};
+
+TEST(SvgSerializerLodTest, NegativePixelSize) {
+	CHECK_THROWS(std::invalid_argument, serializer->SetPixelSize(-1.0));
+}
+
+TEST(SvgSerializerLodTest, LargeCircleKept) {
+	serializer->AddCircle(target, 2.0, Point(10.0, 10.0));
+	LONGS_EQUAL(1, countTags(markup(), "circle"));
+}
+
+TEST(SvgSerializerLodTest, SubPixelFeaturesMerged) {
+	serializer->AddCircle(target, 0.1, Point(10.2, 10.2));
+	serializer->AddCircle(target, 0.1, Point(10.7, 10.4));
+	serializer->AddDraw(target, 0.1,
+			Segment(Point(10.3, 10.3), Point(10.6, 10.6)));
+	serializer->AddCircle(target, 0.1, Point(20.5, 10.5));
+	std::string svg = markup();
+	LONGS_EQUAL(0, countTags(svg, "circle"));
+	LONGS_EQUAL(0, countTags(svg, "line"));
+	LONGS_EQUAL(2, countTags(svg, "rect"));
+	CHECK(svg.find("x=\"10000\" y=\"-11000\" width=\"1000\" height=\"1000\"")
+			!= std::string::npos);
+}
+
+TEST(SvgSerializerLodTest, TinyPolygonBecomesBox) {
+	serializer->AddPolygon(target, { Point(0.0, 0.0), Point(2.0, 0.0), Point(
+			1.0, 3.0) });
+	std::string svg = markup();
+	LONGS_EQUAL(0, countTags(svg, "polygon"));
+	CHECK(svg.find("x=\"0\" y=\"-3000\" width=\"2000\" height=\"3000\"")
+			!= std::string::npos);
+}
+
+TEST(SvgSerializerLodTest, FlatArcBecomesChord) {
+	// 10 degrees of a radius 5 arc bulges ~0.02 from its chord
+	Point start(15.0, 10.0);
+	Point end(10.0 + 5.0 * std::cos(M_PI / 18),
+			10.0 + 5.0 * std::sin(M_PI / 18));
+	serializer->AddArc(target, 0.5,
+			ArcSegment(start, end, Point(-5.0, 0.0),
+					ArcDirection::CounterClockwise));
+	std::string svg = markup();
+	CHECK(svg.find(" L ") != std::string::npos);
+	CHECK(svg.find(" A ") == std::string::npos);
+}
+
+TEST(SvgSerializerLodTest, ContourDecimated) {
+	Contour contour;
+	Point points[] = { Point(0.0, 0.0), Point(10.0, 0.0), Point(10.1, 0.1),
+			Point(10.0, 10.0), Point(0.0, 10.0), Point(0.0, 0.0) };
+	for (int i = 0; i < 5; i++) {
+		contour.AddSegment(std::make_shared<Segment>(points[i], points[i + 1]));
+	}
+	serializer->AddContour(target, contour);
+	std::string svg = markup();
+	size_t lines = 0;
+	for (size_t pos = svg.find(" L "); pos != std::string::npos;
+			pos = svg.find(" L ", pos + 1)) {
+		lines++;
+	}
+	LONGS_EQUAL(4, lines);
+}
+
 } /* namespace gerbex */